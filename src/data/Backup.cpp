@@ -0,0 +1,269 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "Database.h"
+
+#include "SQLiteException.h"
+
+using namespace System::IO;
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// BACKUP_PAGES_PER_STEP
+//
+// Default number of pages copied by each step of a backup operation
+#define BACKUP_PAGES_PER_STEP 256
+
+//---------------------------------------------------------------------------
+// BACKUP_PAUSE_MS
+//
+// Default pause between the steps of a backup operation, in milliseconds
+#define BACKUP_PAUSE_MS 10
+
+//---------------------------------------------------------------------------
+// BACKUP_BUSY_PAUSE_MS
+//
+// Minimum pause before retrying a step that failed with SQLITE_BUSY or
+// SQLITE_LOCKED, in milliseconds
+#define BACKUP_BUSY_PAUSE_MS 5
+
+//---------------------------------------------------------------------------
+// Class BackupTask (local)
+//
+// Binds the arguments of an asynchronous backup operation
+//---------------------------------------------------------------------------
+
+ref class BackupTask
+{
+public:
+
+	// Instance Constructor
+	//
+	BackupTask(Database^ database, String^ path, int pagesperstep, int pausems, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation) :
+		m_database(database), m_path(path), m_pagesperstep(pagesperstep), m_pausems(pausems), m_progress(progress), m_cancellation(cancellation) {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Invoke
+	//
+	// Invokes the backup operation
+	void Invoke(void) { m_database->Backup(m_path, m_pagesperstep, m_pausems, m_progress, m_cancellation); }
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^							m_database;			// Database instance
+	String^								m_path;				// Backup file path
+	int									m_pagesperstep;		// Pages copied per step
+	int									m_pausems;			// Pause between steps
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+};
+
+//---------------------------------------------------------------------------
+// Database::Backup
+//
+// Copies the live database into a backup file
+//
+// Arguments:
+//
+//	path			- Path to the backup database file
+
+void Database::Backup(String^ path)
+{
+	Backup(path, BACKUP_PAGES_PER_STEP, BACKUP_PAUSE_MS, nullptr, CancellationToken::None);
+}
+
+//---------------------------------------------------------------------------
+// Database::Backup
+//
+// Copies the live database into a backup file
+//
+// Arguments:
+//
+//	path			- Path to the backup database file
+//	pagesperstep	- Number of pages to copy with each step
+//	pausems			- Pause between each step, in milliseconds
+
+void Database::Backup(String^ path, int pagesperstep, int pausems)
+{
+	Backup(path, pagesperstep, pausems, nullptr, CancellationToken::None);
+}
+
+//---------------------------------------------------------------------------
+// Database::Backup (internal)
+//
+// Copies the live database into a backup file
+//
+// Arguments:
+//
+//	path			- Path to the backup database file
+//	pagesperstep	- Number of pages to copy with each step
+//	pausems			- Pause between each step, in milliseconds
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+void Database::Backup(String^ path, int pagesperstep, int pausems, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	sqlite3* destination = nullptr;			// Destination instance handle
+
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(pagesperstep <= 0) throw gcnew ArgumentOutOfRangeException("pagesperstep");
+	if(pausems < 0) throw gcnew ArgumentOutOfRangeException("pausems");
+
+	cancellation.ThrowIfCancellationRequested();
+
+	// A backup file that did not exist beforehand is removed if the backup fails; an existing
+	// file is left intact, the backup does not commit to it until the final step
+	path = Path::GetFullPath(path);
+	bool created = !File::Exists(path);
+
+	// Attempt to open or create the backup database at the specified path
+	// (sqlite3_open16() implies SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE)
+	pin_ptr<wchar_t const> pinpath = PtrToStringChars(path);
+	int result = sqlite3_open16(pinpath, &destination);
+	if(result != SQLITE_OK) {
+
+		if(destination != nullptr) sqlite3_close(destination);
+		throw gcnew SQLiteException(result);
+	}
+
+	// Create the safe handle wrapper around the destination sqlite3*
+	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(destination));
+	CLRASSERT(destination == nullptr);
+
+	try {
+
+		SQLiteSafeHandle::Reference target(handle);
+		SQLiteSafeHandle::Reference instance(m_handle);
+
+		// The writer connection is the backup source; changes made through it are applied to the
+		// backup as they happen, whereas any other change to the source restarts the backup.
+		// SQLite doesn't serialize the connection (SQLITE_THREADSAFE=2), every call that touches
+		// the source has to be made under the writer lock
+		sqlite3_backup* backup = nullptr;
+		{
+			msclr::lock lock(m_writelock);
+			backup = sqlite3_backup_init(target, "main", instance, "main");
+		}
+
+		if(backup == nullptr) throw gcnew SQLiteException(sqlite3_extended_errcode(target), sqlite3_errmsg(target));
+
+		try {
+
+			do {
+
+				cancellation.ThrowIfCancellationRequested();
+
+				int pagecount = 0;				// Total number of pages in the source
+				int remaining = 0;				// Number of pages remaining to be copied
+
+				// The writer connection is only held for the duration of each step; the pooled
+				// readers only see a read transaction on the source and are never blocked
+				{
+					msclr::lock lock(m_writelock);
+					result = sqlite3_backup_step(backup, pagesperstep);
+					pagecount = sqlite3_backup_pagecount(backup);
+					remaining = sqlite3_backup_remaining(backup);
+				}
+
+				// A busy or locked database is retried after the pause, any other error is fatal. The
+				// error may have come from either connection, report it from the result code alone
+				bool busy = ((result & 0xFF) == SQLITE_BUSY) || ((result & 0xFF) == SQLITE_LOCKED);
+				if((result != SQLITE_OK) && (result != SQLITE_DONE) && !busy) throw gcnew SQLiteException(result);
+
+				if(CLRISNOTNULL(progress)) {
+
+					int percentage = (pagecount > 0) ? static_cast<int>((static_cast<int64_t>(pagecount - remaining) * 100) / pagecount) : 0;
+					progress->Report(gcnew DatabaseProgress(percentage, nullptr));
+				}
+
+				// Throttle the backup to leave the writer connection and disk bandwidth available; a busy
+				// or locked step always backs off so that it cannot spin when pausems is zero
+				int pause = (busy) ? Math::Max(pausems, BACKUP_BUSY_PAUSE_MS) : pausems;
+				if((result != SQLITE_DONE) && (pause > 0)) cancellation.WaitHandle->WaitOne(pause);
+
+			} while(result != SQLITE_DONE);
+		}
+
+		// sqlite3_backup_finish() repeats the error from a failed step, which has already been thrown
+		catch(Exception^) { msclr::lock lock(m_writelock); sqlite3_backup_finish(backup); throw; }
+
+		// Release the backup object; this also reports a failure to commit the backup
+		{
+			msclr::lock lock(m_writelock);
+			result = sqlite3_backup_finish(backup);
+		}
+
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	}
+
+	catch(Exception^) {
+
+		delete handle;								// Close the backup database
+		if(created) File::Delete(path);				// Delete the incomplete backup file
+		throw;
+	}
+
+	delete handle;
+}
+
+//---------------------------------------------------------------------------
+// Database::BackupAsync
+//
+// Asynchronously copies the live database into a backup file
+//
+// Arguments:
+//
+//	path			- Path to the backup database file
+//	pagesperstep	- Number of pages to copy with each step
+//	pausems			- Pause between each step, in milliseconds
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Task^ Database::BackupAsync(String^ path, int pagesperstep, int pausems, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(pagesperstep <= 0) throw gcnew ArgumentOutOfRangeException("pagesperstep");
+	if(pausems < 0) throw gcnew ArgumentOutOfRangeException("pausems");
+
+	return Task::Run(gcnew Action(gcnew BackupTask(this, path, pagesperstep, pausems, progress, cancellation), &BackupTask::Invoke), cancellation);
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,184 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "Card.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Card Constructor (internal)
+//
+// Arguments:
+//
+//	cardid		- Card identifier
+//	type		- Card type
+//	color		- Card color
+//	rarity		- Card rarity
+
+Card::Card(String^ cardid, CardType type, CardColor color, CardRarity rarity) : m_cardid(cardid), m_type(type), m_color(color), 
+	m_rarity(rarity), m_details(gcnew List<CardDetail^>()), m_faqs(gcnew List<CardFaq^>()), m_images(gcnew List<CardImage^>())
+{
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+}
+
+//---------------------------------------------------------------------------
+// Card::Add (internal)
+//
+// Adds a detail to the card
+//
+// Arguments:
+//
+//	detail		- CardDetail instance
+
+void Card::Add(CardDetail^ detail)
+{
+	if(CLRISNULL(detail)) throw gcnew ArgumentNullException("detail");
+	m_details->Add(detail);
+}
+
+//---------------------------------------------------------------------------
+// Card::Add (internal)
+//
+// Adds a question to the card
+//
+// Arguments:
+//
+//	faq			- CardFaq instance
+
+void Card::Add(CardFaq^ faq)
+{
+	if(CLRISNULL(faq)) throw gcnew ArgumentNullException("faq");
+	m_faqs->Add(faq);
+}
+
+//---------------------------------------------------------------------------
+// Card::Add (internal)
+//
+// Adds an image to the card
+//
+// Arguments:
+//
+//	image		- CardImage instance
+
+void Card::Add(CardImage^ image)
+{
+	if(CLRISNULL(image)) throw gcnew ArgumentNullException("image");
+	m_images->Add(image);
+}
+
+//---------------------------------------------------------------------------
+// Card::CardId::get
+//
+// Gets the identifier of the card
+
+String^ Card::CardId::get(void)
+{
+	return m_cardid;
+}
+
+//---------------------------------------------------------------------------
+// Card::Color::get
+//
+// Gets the color of the card
+
+CardColor Card::Color::get(void)
+{
+	return m_color;
+}
+
+//---------------------------------------------------------------------------
+// Card::Details::get
+//
+// Gets the text of the card, for each side and language
+
+IReadOnlyList<CardDetail^>^ Card::Details::get(void)
+{
+	return m_details->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+// Card::Faqs::get
+//
+// Gets the frequently asked questions about the card
+
+IReadOnlyList<CardFaq^>^ Card::Faqs::get(void)
+{
+	return m_faqs->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+// Card::FindFaq (internal)
+//
+// Locates a question by identifier and language
+//
+// Arguments:
+//
+//	faqid		- Question identifier
+//	language	- Question language
+
+CardFaq^ Card::FindFaq(String^ faqid, CardLanguage language)
+{
+	// Cards only have a handful of questions, a linear search is sufficient
+	for each(CardFaq^ faq in m_faqs)
+		if((faq->Language == language) && String::Equals(faq->FaqId, faqid)) return faq;
+
+	return nullptr;
+}
+
+//---------------------------------------------------------------------------
+// Card::Images::get
+//
+// Gets the images of the card, for each side and language
+
+IReadOnlyList<CardImage^>^ Card::Images::get(void)
+{
+	return m_images->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+// Card::Rarity::get
+//
+// Gets the rarity of the card
+
+CardRarity Card::Rarity::get(void)
+{
+	return m_rarity;
+}
+
+//---------------------------------------------------------------------------
+// Card::Type::get
+//
+// Gets the type of the card
+
+CardType Card::Type::get(void)
+{
+	return m_type;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
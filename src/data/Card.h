@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARD_H_
+#define __CARD_H_
+#pragma once
+
+#include "CardColor.h"
+#include "CardDetail.h"
+#include "CardFaq.h"
+#include "CardImage.h"
+#include "CardLanguage.h"
+#include "CardRarity.h"
+#include "CardType.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class Card
+//
+// Describes a Card along with its text, questions and images
+//---------------------------------------------------------------------------
+
+public ref class Card sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CardId
+	//
+	// Gets the identifier of the card
+	property String^ CardId
+	{
+		String^ get(void);
+	}
+
+	// Color
+	//
+	// Gets the color of the card
+	property CardColor Color
+	{
+		CardColor get(void);
+	}
+
+	// Details
+	//
+	// Gets the text of the card, for each side and language
+	property IReadOnlyList<CardDetail^>^ Details
+	{
+		IReadOnlyList<CardDetail^>^ get(void);
+	}
+
+	// Faqs
+	//
+	// Gets the frequently asked questions about the card
+	property IReadOnlyList<CardFaq^>^ Faqs
+	{
+		IReadOnlyList<CardFaq^>^ get(void);
+	}
+
+	// Images
+	//
+	// Gets the images of the card, for each side and language
+	property IReadOnlyList<CardImage^>^ Images
+	{
+		IReadOnlyList<CardImage^>^ get(void);
+	}
+
+	// Rarity
+	//
+	// Gets the rarity of the card
+	property CardRarity Rarity
+	{
+		CardRarity get(void);
+	}
+
+	// Type
+	//
+	// Gets the type of the card
+	property CardType Type
+	{
+		CardType get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	Card(String^ cardid, CardType type, CardColor color, CardRarity rarity);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Add
+	//
+	// Adds a detail, question or image to the card
+	void Add(CardDetail^ detail);
+	void Add(CardFaq^ faq);
+	void Add(CardImage^ image);
+
+	// FindFaq
+	//
+	// Locates a question by identifier and language
+	CardFaq^ FindFaq(String^ faqid, CardLanguage language);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	String^					m_cardid;			// Card identifier
+	CardType				m_type;				// Card type
+	CardColor				m_color;			// Card color
+	CardRarity				m_rarity;			// Card rarity
+	List<CardDetail^>^		m_details;			// Card text
+	List<CardFaq^>^			m_faqs;				// Card questions
+	List<CardImage^>^		m_images;			// Card images
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARD_H_
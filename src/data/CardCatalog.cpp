@@ -0,0 +1,235 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardCatalog.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// to_range (local)
+//
+// Converts optional minimum and maximum values into a snapshot range
+//
+// Arguments:
+//
+//	minimum		- Optional inclusive minimum value
+//	maximum		- Optional inclusive maximum value
+
+static CatalogSnapshot::Range to_range(Nullable<int> minimum, Nullable<int> maximum)
+{
+	CatalogSnapshot::Range range;
+
+	range.enabled = (minimum.HasValue || maximum.HasValue);
+	if(minimum.HasValue) range.minimum = minimum.Value;
+	if(maximum.HasValue) range.maximum = maximum.Value;
+
+	return range;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Constructor (private)
+//
+// Arguments:
+//
+//	snapshot	- Native snapshot to take ownership of
+//	version		- Database data version the snapshot was created from
+
+CardCatalog::CardCatalog(CatalogSnapshot* snapshot, int64_t version) : m_snapshot(nullptr), m_pressure(0), m_version(version)
+{
+	CLRASSERT(snapshot != nullptr);
+
+	// The card identifiers are converted once, every filter result shares the same String^ instances
+	m_cardids = gcnew array<String^>(static_cast<int>(snapshot->CardCount()));
+	for(int index = 0; index < m_cardids->Length; index++) {
+
+		std::wstring const& cardid = snapshot->CardId(static_cast<uint32_t>(index));
+		m_cardids[index] = gcnew String(cardid.data(), 0, static_cast<int>(cardid.size()));
+	}
+
+	// Ownership of the snapshot is only taken once nothing else can throw
+	m_snapshot = snapshot;
+
+	// Let the garbage collector know about the native memory held by the snapshot
+	m_pressure = static_cast<int64_t>(snapshot->MemoryUsage());
+	if(m_pressure > 0) GC::AddMemoryPressure(m_pressure);
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Destructor (private)
+
+CardCatalog::~CardCatalog()
+{
+	if(m_disposed) return;
+
+	this->!CardCatalog();				// Release unmanaged resources
+	m_disposed = true;					// Object is now in a disposed state
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Finalizer
+
+CardCatalog::!CardCatalog()
+{
+	delete m_snapshot;
+	m_snapshot = nullptr;
+
+	if(m_pressure > 0) GC::RemoveMemoryPressure(m_pressure);
+	m_pressure = 0;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::CardCount::get
+//
+// Gets the number of cards in the catalog
+
+int CardCatalog::CardCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return static_cast<int>(m_snapshot->CardCount());
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Create (internal, static)
+//
+// Creates a new catalog snapshot from a database instance
+//
+// Arguments:
+//
+//	instance	- Database instance to create the snapshot from
+//	version		- Current data version of the database instance
+
+CardCatalog^ CardCatalog::Create(sqlite3* instance, int64_t version)
+{
+	CLRASSERT(instance != nullptr);
+
+	CatalogSnapshot* snapshot = new CatalogSnapshot();
+
+	try {
+
+		int result = snapshot->Load(instance);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+		return gcnew CardCatalog(snapshot, version);
+	}
+
+	catch(Exception^) { delete snapshot; throw; }
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Filter
+//
+// Gets the identifiers of the cards that match a filter
+//
+// Arguments:
+//
+//	filter		- Card selection criteria
+
+IReadOnlyList<String^>^ CardCatalog::Filter(CardCatalogFilter^ filter)
+{
+	CatalogSnapshot::Criteria		criteria;		// Native selection criteria
+	std::vector<uint32_t>			cards;			// Selected card indexes
+
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(filter)) throw gcnew ArgumentNullException("filter");
+
+	if(filter->Type.HasValue) criteria.type = static_cast<int32_t>(filter->Type.Value);
+	if(filter->Color.HasValue) criteria.color = static_cast<int32_t>(filter->Color.Value);
+	if(filter->Rarity.HasValue) criteria.rarity = static_cast<int32_t>(filter->Rarity.Value);
+	if(filter->Language != CardLanguage::None) criteria.language = static_cast<int32_t>(filter->Language);
+
+	criteria.cost = to_range(filter->MinCost, filter->MaxCost);
+	criteria.power = to_range(filter->MinPower, filter->MaxPower);
+	criteria.combopower = to_range(filter->MinComboPower, filter->MaxComboPower);
+
+	String^ name = filter->Name;
+	pin_ptr<const wchar_t> pinname = PtrToStringChars(name);
+	criteria.name = CLRISNOTNULL(name) ? pinname : nullptr;
+
+	// The entire scan is a single call into native code
+	m_snapshot->Filter(criteria, cards);
+
+	List<String^>^ cardids = gcnew List<String^>(static_cast<int>(cards.size()));
+	for(uint32_t card : cards) cardids->Add(m_cardids[card]);
+
+	return cardids;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Filter
+//
+// Gets the identifiers of the cards that match a filter
+//
+// Arguments:
+//
+//	predicate	- Card selection predicate
+
+IReadOnlyList<String^>^ CardCatalog::Filter(CardPredicate^ predicate)
+{
+	CatalogSnapshot::Predicate		compiled;		// Native predicate
+	std::vector<uint32_t>			cards;			// Selected card indexes
+
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(predicate)) throw gcnew ArgumentNullException("predicate");
+
+	// The expression tree is flattened into native nodes, evaluated in a single native call
+	predicate->Compile(compiled);
+	m_snapshot->Filter(compiled, cards);
+
+	List<String^>^ cardids = gcnew List<String^>(static_cast<int>(cards.size()));
+	for(uint32_t card : cards) cardids->Add(m_cardids[card]);
+
+	return cardids;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::RowCount::get
+//
+// Gets the number of card details (card, side and language) in the catalog
+
+int CardCatalog::RowCount::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return static_cast<int>(m_snapshot->RowCount());
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Version::get (internal)
+//
+// Gets the database data version the snapshot was created from
+
+int64_t CardCatalog::Version::get(void)
+{
+	return m_version;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCATALOG_H_
+#define __CARDCATALOG_H_
+#pragma once
+
+#include "CardCatalogFilter.h"
+#include "CardPredicate.h"
+#include "CatalogSnapshot.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardCatalog
+//
+// Immutable in-memory snapshot of the card attributes used to answer filter
+// queries without going through the database; see Database::GetCatalog
+//---------------------------------------------------------------------------
+
+public ref class CardCatalog sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Filter
+	//
+	// Gets the identifiers of the cards that match a filter
+	IReadOnlyList<String^>^ Filter(CardCatalogFilter^ filter);
+	IReadOnlyList<String^>^ Filter(CardPredicate^ predicate);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CardCount
+	//
+	// Gets the number of cards in the catalog
+	property int CardCount
+	{
+		int get(void);
+	}
+
+	// RowCount
+	//
+	// Gets the number of card details (card, side and language) in the catalog
+	property int RowCount
+	{
+		int get(void);
+	}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Create (static)
+	//
+	// Creates a new catalog snapshot from a database instance
+	static CardCatalog^ Create(sqlite3* instance, int64_t version);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Version
+	//
+	// Gets the database data version the snapshot was created from
+	property int64_t Version
+	{
+		int64_t get(void);
+	}
+
+private:
+
+	// Instance Constructor
+	//
+	CardCatalog(CatalogSnapshot* snapshot, int64_t version);
+
+	// Destructor
+	//
+	~CardCatalog();
+
+	// Finalizer
+	//
+	!CardCatalog();
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool				m_disposed = false;	// Object disposal flag
+	CatalogSnapshot*	m_snapshot;			// Native columnar snapshot
+	int64_t				m_pressure;			// Reported memory pressure
+	array<String^>^		m_cardids;			// Card identifiers, by index
+	int64_t				m_version;			// Database data version
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDCATALOG_H_
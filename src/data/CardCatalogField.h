@@ -0,0 +1,58 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCATALOGFIELD_H_
+#define __CARDCATALOGFIELD_H_
+#pragma once
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Enum CardCatalogField
+//
+// Describes a CardCatalog column that can be referenced by a CardPredicate;
+// enumerated fields are compared by their underlying integer value
+//---------------------------------------------------------------------------
+
+public enum class CardCatalogField
+{
+	Type = 0,
+	Color,
+	Rarity,
+	Side,
+	Language,
+	Cost,
+	Power,
+	ComboPower,
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDCATALOGFIELD_H_
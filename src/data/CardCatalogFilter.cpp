@@ -0,0 +1,265 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardCatalogFilter.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter Constructor
+//
+// Arguments:
+//
+//	NONE
+
+CardCatalogFilter::CardCatalogFilter() : m_language(CardLanguage::None)
+{
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Color::get
+//
+// Gets the card color to match
+
+Nullable<CardColor> CardCatalogFilter::Color::get(void)
+{
+	return m_color;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Color::set
+//
+// Sets the card color to match
+
+void CardCatalogFilter::Color::set(Nullable<CardColor> value)
+{
+	m_color = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Language::get
+//
+// Gets the language the Name criteria applies to; None for any
+
+CardLanguage CardCatalogFilter::Language::get(void)
+{
+	return m_language;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Language::set
+//
+// Sets the language the Name criteria applies to; None for any
+
+void CardCatalogFilter::Language::set(CardLanguage value)
+{
+	m_language = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxComboPower::get
+//
+// Gets the maximum combo power to match
+
+Nullable<int> CardCatalogFilter::MaxComboPower::get(void)
+{
+	return m_maxcombopower;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxComboPower::set
+//
+// Sets the maximum combo power to match
+
+void CardCatalogFilter::MaxComboPower::set(Nullable<int> value)
+{
+	m_maxcombopower = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxCost::get
+//
+// Gets the maximum energy cost to match
+
+Nullable<int> CardCatalogFilter::MaxCost::get(void)
+{
+	return m_maxcost;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxCost::set
+//
+// Sets the maximum energy cost to match
+
+void CardCatalogFilter::MaxCost::set(Nullable<int> value)
+{
+	m_maxcost = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxPower::get
+//
+// Gets the maximum power to match
+
+Nullable<int> CardCatalogFilter::MaxPower::get(void)
+{
+	return m_maxpower;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MaxPower::set
+//
+// Sets the maximum power to match
+
+void CardCatalogFilter::MaxPower::set(Nullable<int> value)
+{
+	m_maxpower = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinComboPower::get
+//
+// Gets the minimum combo power to match
+
+Nullable<int> CardCatalogFilter::MinComboPower::get(void)
+{
+	return m_mincombopower;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinComboPower::set
+//
+// Sets the minimum combo power to match
+
+void CardCatalogFilter::MinComboPower::set(Nullable<int> value)
+{
+	m_mincombopower = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinCost::get
+//
+// Gets the minimum energy cost to match
+
+Nullable<int> CardCatalogFilter::MinCost::get(void)
+{
+	return m_mincost;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinCost::set
+//
+// Sets the minimum energy cost to match
+
+void CardCatalogFilter::MinCost::set(Nullable<int> value)
+{
+	m_mincost = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinPower::get
+//
+// Gets the minimum power to match
+
+Nullable<int> CardCatalogFilter::MinPower::get(void)
+{
+	return m_minpower;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::MinPower::set
+//
+// Sets the minimum power to match
+
+void CardCatalogFilter::MinPower::set(Nullable<int> value)
+{
+	m_minpower = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Name::get
+//
+// Gets text that must appear in the card name
+
+String^ CardCatalogFilter::Name::get(void)
+{
+	return m_name;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Name::set
+//
+// Sets text that must appear in the card name
+
+void CardCatalogFilter::Name::set(String^ value)
+{
+	m_name = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Rarity::get
+//
+// Gets the card rarity to match
+
+Nullable<CardRarity> CardCatalogFilter::Rarity::get(void)
+{
+	return m_rarity;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Rarity::set
+//
+// Sets the card rarity to match
+
+void CardCatalogFilter::Rarity::set(Nullable<CardRarity> value)
+{
+	m_rarity = value;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Type::get
+//
+// Gets the card type to match
+
+Nullable<CardType> CardCatalogFilter::Type::get(void)
+{
+	return m_type;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalogFilter::Type::set
+//
+// Sets the card type to match
+
+void CardCatalogFilter::Type::set(Nullable<CardType> value)
+{
+	m_type = value;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,180 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCATALOGFILTER_H_
+#define __CARDCATALOGFILTER_H_
+#pragma once
+
+#include "CardColor.h"
+#include "CardLanguage.h"
+#include "CardRarity.h"
+#include "CardType.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardCatalogFilter
+//
+// Criteria used to select cards from a CardCatalog; unset criteria match
+// every card.  A card matches when any one of its sides and languages meets
+// all of the criteria
+//---------------------------------------------------------------------------
+
+public ref class CardCatalogFilter
+{
+public:
+
+	// Instance Constructor
+	//
+	CardCatalogFilter();
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Color
+	//
+	// Gets/sets the card color to match
+	property Nullable<CardColor> Color
+	{
+		Nullable<CardColor> get(void);
+		void set(Nullable<CardColor> value);
+	}
+
+	// Language
+	//
+	// Gets/sets the language the Name criteria applies to; None for any
+	property CardLanguage Language
+	{
+		CardLanguage get(void);
+		void set(CardLanguage value);
+	}
+
+	// MaxComboPower
+	//
+	// Gets/sets the maximum combo power to match
+	property Nullable<int> MaxComboPower
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MaxCost
+	//
+	// Gets/sets the maximum energy cost to match
+	property Nullable<int> MaxCost
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MaxPower
+	//
+	// Gets/sets the maximum power to match
+	property Nullable<int> MaxPower
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinComboPower
+	//
+	// Gets/sets the minimum combo power to match
+	property Nullable<int> MinComboPower
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinCost
+	//
+	// Gets/sets the minimum energy cost to match
+	property Nullable<int> MinCost
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinPower
+	//
+	// Gets/sets the minimum power to match
+	property Nullable<int> MinPower
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// Name
+	//
+	// Gets/sets text that must appear in the card name
+	property String^ Name
+	{
+		String^ get(void);
+		void set(String^ value);
+	}
+
+	// Rarity
+	//
+	// Gets/sets the card rarity to match
+	property Nullable<CardRarity> Rarity
+	{
+		Nullable<CardRarity> get(void);
+		void set(Nullable<CardRarity> value);
+	}
+
+	// Type
+	//
+	// Gets/sets the card type to match
+	property Nullable<CardType> Type
+	{
+		Nullable<CardType> get(void);
+		void set(Nullable<CardType> value);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Nullable<CardColor>		m_color;			// Card color
+	CardLanguage			m_language;			// Name language
+	Nullable<int>			m_maxcombopower;	// Maximum combo power
+	Nullable<int>			m_maxcost;			// Maximum energy cost
+	Nullable<int>			m_maxpower;			// Maximum power
+	Nullable<int>			m_mincombopower;	// Minimum combo power
+	Nullable<int>			m_mincost;			// Minimum energy cost
+	Nullable<int>			m_minpower;			// Minimum power
+	String^					m_name;				// Card name text
+	Nullable<CardRarity>	m_rarity;			// Card rarity
+	Nullable<CardType>		m_type;				// Card type
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDCATALOGFILTER_H_
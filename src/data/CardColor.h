@@ -0,0 +1,73 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCOLOR_H_
+#define __CARDCOLOR_H_
+#pragma once
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::ComponentModel;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Enum CardColor
+//
+// Describes the color of a Card
+//---------------------------------------------------------------------------
+
+public enum class CardColor
+{
+	[DescriptionAttribute("NONE")]
+	None = 0,
+
+	[DescriptionAttribute("Red")]
+	Red,
+
+	[DescriptionAttribute("Blue")]
+	Blue,
+
+	[DescriptionAttribute("Green")]
+	Green,
+
+	[DescriptionAttribute("Yellow")]
+	Yellow,
+
+	[DescriptionAttribute("Black")]
+	Black,
+
+	[DescriptionAttribute("ALL")]
+	All,
+
+	[DescriptionAttribute("no-color")]
+	NoColor,
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDCOLOR_H_
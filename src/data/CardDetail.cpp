@@ -0,0 +1,158 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardDetail.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// CardDetail Constructor (internal)
+//
+// Arguments:
+//
+//	cardid			- Card identifier
+//	side			- Card side
+//	language		- Card language
+//	name			- Card name
+//	cost			- Energy cost; can be null
+//	specifiedcost	- Specified energy cost; can be nullptr
+//	power			- Power; can be null
+//	combopower		- Combo power; can be null
+//	traits			- Traits; can be nullptr
+//	effect			- Effect text; can be nullptr
+
+CardDetail::CardDetail(String^ cardid, CardSide side, CardLanguage language, String^ name, Nullable<int> cost, String^ specifiedcost, 
+	Nullable<int> power, Nullable<int> combopower, String^ traits, String^ effect) : m_cardid(cardid), m_side(side), m_language(language), 
+	m_name(name), m_cost(cost), m_specifiedcost(specifiedcost), m_power(power), m_combopower(combopower), m_traits(traits), m_effect(effect)
+{
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	if(CLRISNULL(name)) throw gcnew ArgumentNullException("name");
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::CardId::get
+//
+// Gets the identifier of the card
+
+String^ CardDetail::CardId::get(void)
+{
+	return m_cardid;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::ComboPower::get
+//
+// Gets the combo power of the card, if any
+
+Nullable<int> CardDetail::ComboPower::get(void)
+{
+	return m_combopower;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Cost::get
+//
+// Gets the energy cost of the card, if any
+
+Nullable<int> CardDetail::Cost::get(void)
+{
+	return m_cost;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Effect::get
+//
+// Gets the effect text of the card
+
+String^ CardDetail::Effect::get(void)
+{
+	return m_effect;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Language::get
+//
+// Gets the language of the card text
+
+CardLanguage CardDetail::Language::get(void)
+{
+	return m_language;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Name::get
+//
+// Gets the name of the card
+
+String^ CardDetail::Name::get(void)
+{
+	return m_name;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Power::get
+//
+// Gets the power of the card, if any
+
+Nullable<int> CardDetail::Power::get(void)
+{
+	return m_power;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Side::get
+//
+// Gets the side of the card the text applies to
+
+CardSide CardDetail::Side::get(void)
+{
+	return m_side;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::SpecifiedCost::get
+//
+// Gets the specified energy cost of the card
+
+String^ CardDetail::SpecifiedCost::get(void)
+{
+	return m_specifiedcost;
+}
+
+//---------------------------------------------------------------------------
+// CardDetail::Traits::get
+//
+// Gets the traits of the card
+
+String^ CardDetail::Traits::get(void)
+{
+	return m_traits;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
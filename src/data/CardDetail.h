@@ -0,0 +1,159 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDDETAIL_H_
+#define __CARDDETAIL_H_
+#pragma once
+
+#include "CardLanguage.h"
+#include "CardSide.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardDetail
+//
+// Describes the language-specific text of one side of a Card
+//---------------------------------------------------------------------------
+
+public ref class CardDetail sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CardId
+	//
+	// Gets the identifier of the card
+	property String^ CardId
+	{
+		String^ get(void);
+	}
+
+	// ComboPower
+	//
+	// Gets the combo power of the card, if any
+	property Nullable<int> ComboPower
+	{
+		Nullable<int> get(void);
+	}
+
+	// Cost
+	//
+	// Gets the energy cost of the card, if any
+	property Nullable<int> Cost
+	{
+		Nullable<int> get(void);
+	}
+
+	// Effect
+	//
+	// Gets the effect text of the card
+	property String^ Effect
+	{
+		String^ get(void);
+	}
+
+	// Language
+	//
+	// Gets the language of the card text
+	property CardLanguage Language
+	{
+		CardLanguage get(void);
+	}
+
+	// Name
+	//
+	// Gets the name of the card
+	property String^ Name
+	{
+		String^ get(void);
+	}
+
+	// Power
+	//
+	// Gets the power of the card, if any
+	property Nullable<int> Power
+	{
+		Nullable<int> get(void);
+	}
+
+	// Side
+	//
+	// Gets the side of the card the text applies to
+	property CardSide Side
+	{
+		CardSide get(void);
+	}
+
+	// SpecifiedCost
+	//
+	// Gets the specified energy cost of the card
+	property String^ SpecifiedCost
+	{
+		String^ get(void);
+	}
+
+	// Traits
+	//
+	// Gets the traits of the card
+	property String^ Traits
+	{
+		String^ get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardDetail(String^ cardid, CardSide side, CardLanguage language, String^ name, Nullable<int> cost, String^ specifiedcost, 
+		Nullable<int> power, Nullable<int> combopower, String^ traits, String^ effect);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	String^				m_cardid;			// Card identifier
+	CardSide			m_side;				// Card side
+	CardLanguage		m_language;			// Card language
+	String^				m_name;				// Card name
+	Nullable<int>		m_cost;				// Energy cost
+	String^				m_specifiedcost;	// Specified energy cost
+	Nullable<int>		m_power;			// Power
+	Nullable<int>		m_combopower;		// Combo power
+	String^				m_traits;			// Traits
+	String^				m_effect;			// Effect text
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDDETAIL_H_
@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardFaq.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// CardFaq Constructor (internal)
+//
+// Arguments:
+//
+//	cardid		- Card identifier
+//	faqid		- Question identifier
+//	language	- Question language
+//	question	- Question text
+//	answer		- Answer text; can be nullptr
+
+CardFaq::CardFaq(String^ cardid, String^ faqid, CardLanguage language, String^ question, String^ answer) : m_cardid(cardid), m_faqid(faqid),
+	m_language(language), m_question(question), m_answer(answer), m_related(gcnew List<String^>())
+{
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	if(CLRISNULL(faqid)) throw gcnew ArgumentNullException("faqid");
+	if(CLRISNULL(question)) throw gcnew ArgumentNullException("question");
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::AddRelatedCardId (internal)
+//
+// Adds the identifier of a related card
+//
+// Arguments:
+//
+//	cardid		- Related card identifier
+
+void CardFaq::AddRelatedCardId(String^ cardid)
+{
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	m_related->Add(cardid);
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::Answer::get
+//
+// Gets the answer to the question
+
+String^ CardFaq::Answer::get(void)
+{
+	return m_answer;
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::CardId::get
+//
+// Gets the identifier of the card
+
+String^ CardFaq::CardId::get(void)
+{
+	return m_cardid;
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::FaqId::get
+//
+// Gets the identifier of the question
+
+String^ CardFaq::FaqId::get(void)
+{
+	return m_faqid;
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::Language::get
+//
+// Gets the language of the question and answer
+
+CardLanguage CardFaq::Language::get(void)
+{
+	return m_language;
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::Question::get
+//
+// Gets the question text
+
+String^ CardFaq::Question::get(void)
+{
+	return m_question;
+}
+
+//---------------------------------------------------------------------------
+// CardFaq::RelatedCardIds::get
+//
+// Gets the identifiers of the other cards the question refers to
+
+IReadOnlyList<String^>^ CardFaq::RelatedCardIds::get(void)
+{
+	return m_related->AsReadOnly();
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,130 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDFAQ_H_
+#define __CARDFAQ_H_
+#pragma once
+
+#include "CardLanguage.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardFaq
+//
+// Describes a frequently asked question about a Card
+//---------------------------------------------------------------------------
+
+public ref class CardFaq sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Answer
+	//
+	// Gets the answer to the question
+	property String^ Answer
+	{
+		String^ get(void);
+	}
+
+	// CardId
+	//
+	// Gets the identifier of the card
+	property String^ CardId
+	{
+		String^ get(void);
+	}
+
+	// FaqId
+	//
+	// Gets the identifier of the question
+	property String^ FaqId
+	{
+		String^ get(void);
+	}
+
+	// Language
+	//
+	// Gets the language of the question and answer
+	property CardLanguage Language
+	{
+		CardLanguage get(void);
+	}
+
+	// Question
+	//
+	// Gets the question text
+	property String^ Question
+	{
+		String^ get(void);
+	}
+
+	// RelatedCardIds
+	//
+	// Gets the identifiers of the other cards the question refers to
+	property IReadOnlyList<String^>^ RelatedCardIds
+	{
+		IReadOnlyList<String^>^ get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardFaq(String^ cardid, String^ faqid, CardLanguage language, String^ question, String^ answer);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AddRelatedCardId
+	//
+	// Adds the identifier of a related card
+	void AddRelatedCardId(String^ cardid);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	String^				m_cardid;			// Card identifier
+	String^				m_faqid;			// Question identifier
+	CardLanguage		m_language;			// Question language
+	String^				m_question;			// Question text
+	String^				m_answer;			// Answer text
+	List<String^>^		m_related;			// Related card identifiers
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDFAQ_H_
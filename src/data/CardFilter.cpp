@@ -0,0 +1,165 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardFilter.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// CardFilter Constructor
+//
+// Arguments:
+//
+//	NONE
+
+CardFilter::CardFilter() : m_language(CardLanguage::None)
+{
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Color::get
+//
+// Gets the card color to match
+
+Nullable<CardColor> CardFilter::Color::get(void)
+{
+	return m_color;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Color::set
+//
+// Sets the card color to match
+
+void CardFilter::Color::set(Nullable<CardColor> value)
+{
+	m_color = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Language::get
+//
+// Gets the language the Name and Trait criteria apply to
+
+CardLanguage CardFilter::Language::get(void)
+{
+	return m_language;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Language::set
+//
+// Sets the language the Name and Trait criteria apply to
+
+void CardFilter::Language::set(CardLanguage value)
+{
+	m_language = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Name::get
+//
+// Gets text that must appear in the card name
+
+String^ CardFilter::Name::get(void)
+{
+	return m_name;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Name::set
+//
+// Sets text that must appear in the card name
+
+void CardFilter::Name::set(String^ value)
+{
+	m_name = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Rarity::get
+//
+// Gets the card rarity to match
+
+Nullable<CardRarity> CardFilter::Rarity::get(void)
+{
+	return m_rarity;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Rarity::set
+//
+// Sets the card rarity to match
+
+void CardFilter::Rarity::set(Nullable<CardRarity> value)
+{
+	m_rarity = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Trait::get
+//
+// Gets a trait the card must have
+
+String^ CardFilter::Trait::get(void)
+{
+	return m_trait;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Trait::set
+//
+// Sets a trait the card must have
+
+void CardFilter::Trait::set(String^ value)
+{
+	m_trait = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Type::get
+//
+// Gets the card type to match
+
+Nullable<CardType> CardFilter::Type::get(void)
+{
+	return m_type;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Type::set
+//
+// Sets the card type to match
+
+void CardFilter::Type::set(Nullable<CardType> value)
+{
+	m_type = value;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,128 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDFILTER_H_
+#define __CARDFILTER_H_
+#pragma once
+
+#include "CardColor.h"
+#include "CardLanguage.h"
+#include "CardRarity.h"
+#include "CardType.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardFilter
+//
+// Criteria used to select cards; unset criteria match every card
+//---------------------------------------------------------------------------
+
+public ref class CardFilter
+{
+public:
+
+	// Instance Constructor
+	//
+	CardFilter();
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Color
+	//
+	// Gets/sets the card color to match
+	property Nullable<CardColor> Color
+	{
+		Nullable<CardColor> get(void);
+		void set(Nullable<CardColor> value);
+	}
+
+	// Language
+	//
+	// Gets/sets the language the Name and Trait criteria apply to; None for any
+	property CardLanguage Language
+	{
+		CardLanguage get(void);
+		void set(CardLanguage value);
+	}
+
+	// Name
+	//
+	// Gets/sets text that must appear in the card name
+	property String^ Name
+	{
+		String^ get(void);
+		void set(String^ value);
+	}
+
+	// Rarity
+	//
+	// Gets/sets the card rarity to match
+	property Nullable<CardRarity> Rarity
+	{
+		Nullable<CardRarity> get(void);
+		void set(Nullable<CardRarity> value);
+	}
+
+	// Trait
+	//
+	// Gets/sets a trait the card must have
+	property String^ Trait
+	{
+		String^ get(void);
+		void set(String^ value);
+	}
+
+	// Type
+	//
+	// Gets/sets the card type to match
+	property Nullable<CardType> Type
+	{
+		Nullable<CardType> get(void);
+		void set(Nullable<CardType> value);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Nullable<CardColor>		m_color;			// Card color
+	CardLanguage			m_language;			// Name and trait language
+	String^					m_name;				// Card name text
+	Nullable<CardRarity>	m_rarity;			// Card rarity
+	String^					m_trait;			// Card trait
+	Nullable<CardType>		m_type;				// Card type
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDFILTER_H_
@@ -0,0 +1,124 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardImage.h"
+
+#include "Database.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// CardImage Constructor (internal)
+//
+// Arguments:
+//
+//	database	- Owning database instance
+//	cardid		- Card identifier
+//	side		- Card side
+//	language	- Card language
+//	format		- Original image format
+
+CardImage::CardImage(Database^ database, String^ cardid, CardSide side, CardLanguage language, String^ format) : m_database(database),
+	m_cardid(cardid), m_side(side), m_language(language), m_format(format)
+{
+	if(CLRISNULL(database)) throw gcnew ArgumentNullException("database");
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	if(CLRISNULL(format)) throw gcnew ArgumentNullException("format");
+}
+
+//---------------------------------------------------------------------------
+// CardImage::CardId::get
+//
+// Gets the identifier of the card
+
+String^ CardImage::CardId::get(void)
+{
+	return m_cardid;
+}
+
+//---------------------------------------------------------------------------
+// CardImage::Format::get
+//
+// Gets the MIME type of the original image
+
+String^ CardImage::Format::get(void)
+{
+	return m_format;
+}
+
+//---------------------------------------------------------------------------
+// CardImage::GetImage
+//
+// Loads the original image
+//
+// Arguments:
+//
+//	NONE
+
+array<byte>^ CardImage::GetImage(void)
+{
+	// No variant is as wide as the original, which is the final fallback
+	return m_database->GetCardImage(m_cardid, m_side, m_language, Int32::MaxValue);
+}
+
+//---------------------------------------------------------------------------
+// CardImage::GetImage
+//
+// Loads the smallest image that is at least the requested width
+//
+// Arguments:
+//
+//	width		- Minimum width of the image; zero for the smallest available
+
+array<byte>^ CardImage::GetImage(int width)
+{
+	return m_database->GetCardImage(m_cardid, m_side, m_language, width);
+}
+
+//---------------------------------------------------------------------------
+// CardImage::Language::get
+//
+// Gets the language of the image
+
+CardLanguage CardImage::Language::get(void)
+{
+	return m_language;
+}
+
+//---------------------------------------------------------------------------
+// CardImage::Side::get
+//
+// Gets the side of the card shown in the image
+
+CardSide CardImage::Side::get(void)
+{
+	return m_side;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
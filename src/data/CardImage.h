@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDIMAGE_H_
+#define __CARDIMAGE_H_
+#pragma once
+
+#include "CardLanguage.h"
+#include "CardSide.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+// FORWARD DECLARATIONS
+//
+ref class Database;
+
+//---------------------------------------------------------------------------
+// Class CardImage
+//
+// Describes an image of a Card; the image data is only loaded on request
+//---------------------------------------------------------------------------
+
+public ref class CardImage sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetImage
+	//
+	// Loads the original image, or the smallest variant at least the requested width
+	array<byte>^ GetImage(void);
+	array<byte>^ GetImage(int width);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CardId
+	//
+	// Gets the identifier of the card
+	property String^ CardId
+	{
+		String^ get(void);
+	}
+
+	// Format
+	//
+	// Gets the MIME type of the original image
+	property String^ Format
+	{
+		String^ get(void);
+	}
+
+	// Language
+	//
+	// Gets the language of the image
+	property CardLanguage Language
+	{
+		CardLanguage get(void);
+	}
+
+	// Side
+	//
+	// Gets the side of the card shown in the image
+	property CardSide Side
+	{
+		CardSide get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardImage(Database^ database, String^ cardid, CardSide side, CardLanguage language, String^ format);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^			m_database;			// Owning database instance
+	String^				m_cardid;			// Card identifier
+	CardSide			m_side;				// Card side
+	CardLanguage		m_language;			// Card language
+	String^				m_format;			// Original image format
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDIMAGE_H_
@@ -0,0 +1,347 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardPredicate.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CompositePredicate (local)
+//
+// Predicate that combines the results of its operands with And or Or
+//---------------------------------------------------------------------------
+
+ref class CompositePredicate : public CardPredicate
+{
+public:
+
+	// Instance Constructor
+	//
+	CompositePredicate(bool conjunction, array<CardPredicate^>^ operands) : m_conjunction(conjunction), m_operands(operands) {}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compile
+	//
+	// Appends the predicate to a compiled native predicate
+	virtual void Compile(CatalogSnapshot::Predicate& predicate) override
+	{
+		if(m_conjunction) predicate.And(static_cast<uint32_t>(m_operands->Length));
+		else predicate.Or(static_cast<uint32_t>(m_operands->Length));
+
+		for each(CardPredicate^ operand in m_operands) operand->Compile(predicate);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool							m_conjunction;		// And (true) or Or (false)
+	array<CardPredicate^>^			m_operands;			// Operand predicates
+};
+
+//---------------------------------------------------------------------------
+// Class InPredicate (local)
+//
+// Predicate that matches a field equal to any of a set of values
+//---------------------------------------------------------------------------
+
+ref class InPredicate : public CardPredicate
+{
+public:
+
+	// Instance Constructor
+	//
+	InPredicate(CardCatalogField field, array<int>^ values) : m_field(field), m_values(values) {}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compile
+	//
+	// Appends the predicate to a compiled native predicate
+	virtual void Compile(CatalogSnapshot::Predicate& predicate) override
+	{
+		CatalogSnapshot::Column column = static_cast<CatalogSnapshot::Column>(m_field);
+
+		if(m_values->Length == 0) { predicate.In(column, nullptr, 0); return; }
+
+		pin_ptr<int> pinvalues = &m_values[0];
+		predicate.In(column, pinvalues, static_cast<uint32_t>(m_values->Length));
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CardCatalogField				m_field;			// Field to be matched
+	array<int>^						m_values;			// Values to be matched
+};
+
+//---------------------------------------------------------------------------
+// Class NotPredicate (local)
+//
+// Predicate that matches when its operand does not match
+//---------------------------------------------------------------------------
+
+ref class NotPredicate : public CardPredicate
+{
+public:
+
+	// Instance Constructor
+	//
+	NotPredicate(CardPredicate^ operand) : m_operand(operand) {}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compile
+	//
+	// Appends the predicate to a compiled native predicate
+	virtual void Compile(CatalogSnapshot::Predicate& predicate) override
+	{
+		predicate.Not();
+		m_operand->Compile(predicate);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CardPredicate^					m_operand;			// Operand predicate
+};
+
+//---------------------------------------------------------------------------
+// Class RangePredicate (local)
+//
+// Predicate that matches a field within an inclusive range of values
+//---------------------------------------------------------------------------
+
+ref class RangePredicate : public CardPredicate
+{
+public:
+
+	// Instance Constructor
+	//
+	RangePredicate(CardCatalogField field, int minimum, int maximum) : m_field(field), m_minimum(minimum), m_maximum(maximum) {}
+
+internal:
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compile
+	//
+	// Appends the predicate to a compiled native predicate
+	virtual void Compile(CatalogSnapshot::Predicate& predicate) override
+	{
+		predicate.Range(static_cast<CatalogSnapshot::Column>(m_field), m_minimum, m_maximum);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CardCatalogField				m_field;			// Field to be matched
+	int								m_minimum;			// Inclusive minimum value
+	int								m_maximum;			// Inclusive maximum value
+};
+
+//---------------------------------------------------------------------------
+// check_field (local)
+//
+// Verifies that a CardCatalogField value is valid
+//
+// Arguments:
+//
+//	field		- Field to be verified
+
+static void check_field(CardCatalogField field)
+{
+	if((field < CardCatalogField::Type) || (field > CardCatalogField::ComboPower)) throw gcnew ArgumentOutOfRangeException("field");
+}
+
+//---------------------------------------------------------------------------
+// check_operands (local)
+//
+// Verifies and copies an array of operand predicates
+//
+// Arguments:
+//
+//	operands	- Operand predicates to be verified
+
+static array<CardPredicate^>^ check_operands(array<CardPredicate^>^ operands)
+{
+	if(CLRISNULL(operands)) throw gcnew ArgumentNullException("operands");
+
+	for each(CardPredicate^ operand in operands)
+		if(CLRISNULL(operand)) throw gcnew ArgumentException("Operand predicates cannot be null", "operands");
+
+	// The caller's array is copied, predicates are immutable once they have been created
+	return safe_cast<array<CardPredicate^>^>(operands->Clone());
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::And (static)
+//
+// Creates a predicate that matches when all of the operands match
+//
+// Arguments:
+//
+//	operands	- Operand predicates; no operands matches every card
+
+CardPredicate^ CardPredicate::And(... array<CardPredicate^>^ operands)
+{
+	return gcnew CompositePredicate(true, check_operands(operands));
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::Between (static)
+//
+// Creates a predicate that matches a field within an inclusive range
+//
+// Arguments:
+//
+//	field		- Field to be matched
+//	minimum		- Inclusive minimum value
+//	maximum		- Inclusive maximum value
+
+CardPredicate^ CardPredicate::Between(CardCatalogField field, int minimum, int maximum)
+{
+	check_field(field);
+	return gcnew RangePredicate(field, minimum, maximum);
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::Equal (static)
+//
+// Creates a predicate that matches a field equal to a value
+//
+// Arguments:
+//
+//	field		- Field to be matched
+//	value		- Value to be matched
+
+CardPredicate^ CardPredicate::Equal(CardCatalogField field, int value)
+{
+	check_field(field);
+	return gcnew RangePredicate(field, value, value);
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::GreaterOrEqual (static)
+//
+// Creates a predicate that matches a field greater than or equal to a value
+//
+// Arguments:
+//
+//	field		- Field to be matched
+//	value		- Inclusive minimum value
+
+CardPredicate^ CardPredicate::GreaterOrEqual(CardCatalogField field, int value)
+{
+	check_field(field);
+	return gcnew RangePredicate(field, value, Int32::MaxValue);
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::In (static)
+//
+// Creates a predicate that matches a field equal to any of the values
+//
+// Arguments:
+//
+//	field		- Field to be matched
+//	values		- Values to be matched; no values matches no cards
+
+CardPredicate^ CardPredicate::In(CardCatalogField field, ... array<int>^ values)
+{
+	check_field(field);
+	if(CLRISNULL(values)) throw gcnew ArgumentNullException("values");
+
+	return gcnew InPredicate(field, safe_cast<array<int>^>(values->Clone()));
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::LessOrEqual (static)
+//
+// Creates a predicate that matches a field less than or equal to a value
+//
+// Arguments:
+//
+//	field		- Field to be matched
+//	value		- Inclusive maximum value
+
+CardPredicate^ CardPredicate::LessOrEqual(CardCatalogField field, int value)
+{
+	check_field(field);
+	return gcnew RangePredicate(field, Int32::MinValue, value);
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::Not (static)
+//
+// Creates a predicate that matches when the operand does not match
+//
+// Arguments:
+//
+//	operand		- Operand predicate
+
+CardPredicate^ CardPredicate::Not(CardPredicate^ operand)
+{
+	if(CLRISNULL(operand)) throw gcnew ArgumentNullException("operand");
+	return gcnew NotPredicate(operand);
+}
+
+//---------------------------------------------------------------------------
+// CardPredicate::Or (static)
+//
+// Creates a predicate that matches when any of the operands match
+//
+// Arguments:
+//
+//	operands	- Operand predicates; no operands matches no cards
+
+CardPredicate^ CardPredicate::Or(... array<CardPredicate^>^ operands)
+{
+	return gcnew CompositePredicate(false, check_operands(operands));
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
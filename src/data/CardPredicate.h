@@ -0,0 +1,112 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDPREDICATE_H_
+#define __CARDPREDICATE_H_
+#pragma once
+
+#include "CardCatalogField.h"
+#include "CatalogSnapshot.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CardPredicate
+//
+// Filter expression evaluated against the columns of a CardCatalog.  A card
+// matches when any one of its sides and languages satisfies the expression;
+// a NULL value never satisfies a comparison
+//---------------------------------------------------------------------------
+
+public ref class CardPredicate abstract
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// And (static)
+	//
+	// Creates a predicate that matches when all of the operands match
+	static CardPredicate^ And(... array<CardPredicate^>^ operands);
+
+	// Between (static)
+	//
+	// Creates a predicate that matches a field within an inclusive range
+	static CardPredicate^ Between(CardCatalogField field, int minimum, int maximum);
+
+	// Equal (static)
+	//
+	// Creates a predicate that matches a field equal to a value
+	static CardPredicate^ Equal(CardCatalogField field, int value);
+
+	// GreaterOrEqual (static)
+	//
+	// Creates a predicate that matches a field greater than or equal to a value
+	static CardPredicate^ GreaterOrEqual(CardCatalogField field, int value);
+
+	// In (static)
+	//
+	// Creates a predicate that matches a field equal to any of the values
+	static CardPredicate^ In(CardCatalogField field, ... array<int>^ values);
+
+	// LessOrEqual (static)
+	//
+	// Creates a predicate that matches a field less than or equal to a value
+	static CardPredicate^ LessOrEqual(CardCatalogField field, int value);
+
+	// Not (static)
+	//
+	// Creates a predicate that matches when the operand does not match
+	static CardPredicate^ Not(CardPredicate^ operand);
+
+	// Or (static)
+	//
+	// Creates a predicate that matches when any of the operands match
+	static CardPredicate^ Or(... array<CardPredicate^>^ operands);
+
+internal:
+
+	// Instance Constructor
+	//
+	CardPredicate() {}
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Compile
+	//
+	// Appends the predicate to a compiled native predicate
+	virtual void Compile(CatalogSnapshot::Predicate& predicate) abstract;
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CARDPREDICATE_H_
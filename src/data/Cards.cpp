@@ -0,0 +1,1376 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+
+#include "Database.h"
+
+#include "carray.h"
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// ENUMERATE_PAGE_SIZE
+//
+// Default number of rows read with each page of an enumeration
+#define ENUMERATE_PAGE_SIZE 256
+
+//---------------------------------------------------------------------------
+// Class StringTable (local)
+//
+// Interns the text of result columns; text that has already been seen is
+// returned as the same String^ without allocating a new one
+//---------------------------------------------------------------------------
+
+ref class StringTable
+{
+public:
+
+	// Instance Constructor
+	//
+	StringTable() : m_strings(gcnew Dictionary<uint64_t, String^>()) {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Intern
+	//
+	// Gets the String^ for a text result column; nullptr if the column is NULL
+	String^ Intern(sqlite3_stmt* statement, int index);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Dictionary<uint64_t, String^>^	m_strings;			// Interned strings
+};
+
+//---------------------------------------------------------------------------
+// Class CardReader (local)
+//
+// Materializes Card instances using a fixed set of batched statements; each
+// statement is executed once regardless of the number of cards requested
+//---------------------------------------------------------------------------
+
+ref class CardReader
+{
+public:
+
+	// Instance Constructor
+	//
+	CardReader(Database^ database, sqlite3* instance, StatementCache* cache);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// FindCards
+	//
+	// Reads the cards that match a filter
+	List<Card^>^ FindCards(CardFilter^ filter);
+
+	// GetCards
+	//
+	// Reads the specified cards
+	List<Card^>^ GetCards(IEnumerable<String^>^ cardids);
+
+	// ReadCardDetailPage
+	//
+	// Reads the page of card details that follows a key
+	List<CardDetail^>^ ReadCardDetailPage(CardLanguage language, CardDetail^ after, int pagesize);
+
+	// ReadCardFaqPage
+	//
+	// Reads the page of card questions that follows a key
+	List<CardFaq^>^ ReadCardFaqPage(CardLanguage language, CardFaq^ after, int pagesize);
+
+	// ReadCardPage
+	//
+	// Reads the page of cards that follows a key
+	List<Card^>^ ReadCardPage(String^ after, int pagesize);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AcquireStatement
+	//
+	// Acquires a statement from the cache and binds the card identifiers to it
+	sqlite3_stmt* AcquireStatement(wchar_t const* sql, carray_text const* cardids);
+
+	// Execute
+	//
+	// Executes a statement that returns no rows
+	void Execute(wchar_t const* sql);
+
+	// ReadCardIds
+	//
+	// Reads the identifiers of the cards that match a filter
+	List<String^>^ ReadCardIds(CardFilter^ filter);
+
+	// ReadCards
+	//
+	// Reads the specified cards and all of their child rows
+	List<Card^>^ ReadCards(List<String^>^ cardids);
+
+	// Text
+	//
+	// Gets the string table for a language
+	StringTable^ Text(CardLanguage language);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^				m_database;			// Owning database instance
+	sqlite3*				m_instance;			// Database connection
+	StatementCache*			m_cache;			// Prepared statement cache
+	StringTable^			m_keys;				// Interned identifiers
+	array<StringTable^>^	m_text;				// Interned text, by language
+};
+
+//---------------------------------------------------------------------------
+// Class KeysetEnumerator (local, abstract)
+//
+// Enumerates rows one page at a time; each page is read after the key of the
+// last row of the previous page rather than at an offset into the results
+//---------------------------------------------------------------------------
+
+generic<typename T> where T : ref class
+ref class KeysetEnumerator abstract : public IEnumerable<T>, public IEnumerator<T>
+{
+public:
+
+	// Destructor
+	//
+	~KeysetEnumerator() {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetEnumerator
+	//
+	// Gets an enumerator over the rows; the first call returns this instance
+	virtual IEnumerator<T>^ GetEnumerator(void)
+	{
+		if(m_enumerated) return Clone();
+
+		m_enumerated = true;
+		return this;
+	}
+
+	// MoveNext
+	//
+	// Advances to the next row, reading the next page when necessary
+	virtual bool MoveNext(void)
+	{
+		if((m_index + 1) < m_page->Count) { m_index++; return true; }
+
+		// A short page is the last one, there is no need to read an empty page to find the end
+		if(m_complete) { m_index = m_page->Count; return false; }
+
+		m_page = ReadPage(m_last, m_pagesize);
+		m_complete = (m_page->Count < m_pagesize);
+		m_index = 0;
+
+		if(m_page->Count == 0) return false;
+
+		m_last = m_page[m_page->Count - 1];
+		return true;
+	}
+
+	// Reset
+	//
+	// Resets the enumerator to before the first row
+	virtual void Reset(void)
+	{
+		m_page = gcnew List<T>();
+		m_index = -1;
+		m_last = T();
+		m_complete = false;
+	}
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Current
+	//
+	// Gets the current row
+	property T Current
+	{
+		virtual T get(void)
+		{
+			if((m_index < 0) || (m_index >= m_page->Count)) throw gcnew InvalidOperationException();
+			return m_page[m_index];
+		}
+	}
+
+protected:
+
+	// Instance Constructor
+	//
+	KeysetEnumerator(int pagesize) : m_pagesize(pagesize), m_page(gcnew List<T>()), m_index(-1) {}
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// Clone
+	//
+	// Creates a new enumerator over the same rows
+	virtual KeysetEnumerator<T>^ Clone(void) abstract;
+
+	// ReadPage
+	//
+	// Reads the page of rows that follows the specified row; T() for the first page
+	virtual List<T>^ ReadPage(T after, int pagesize) abstract;
+
+	//-----------------------------------------------------------------------
+	// Protected Properties
+
+	// PageSize
+	//
+	// Gets the maximum number of rows read with each page
+	property int PageSize
+	{
+		int get(void) { return m_pagesize; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetEnumerator (IEnumerable)
+	//
+	// Gets an enumerator over the rows
+	virtual System::Collections::IEnumerator^ GetEnumeratorObject(void) sealed = System::Collections::IEnumerable::GetEnumerator
+	{
+		return GetEnumerator();
+	}
+
+	//-----------------------------------------------------------------------
+	// Private Properties
+
+	// Current (IEnumerator)
+	//
+	// Gets the current row
+	property Object^ CurrentObject
+	{
+		virtual Object^ get(void) sealed = System::Collections::IEnumerator::Current::get { return Current; }
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int						m_pagesize;			// Rows read with each page
+	List<T>^				m_page;				// Current page of rows
+	int						m_index;			// Index into the current page
+	T						m_last;				// Last row read so far
+	bool					m_complete = false;	// Last page has been read
+	bool					m_enumerated = false;	// GetEnumerator() has been called
+};
+
+//---------------------------------------------------------------------------
+// Class CardDetailEnumerator (local)
+//
+// Enumerates card details in primary key order
+//---------------------------------------------------------------------------
+
+ref class CardDetailEnumerator : public KeysetEnumerator<CardDetail^>
+{
+public:
+
+	// Instance Constructor
+	//
+	CardDetailEnumerator(Database^ database, CardLanguage language, int pagesize) : KeysetEnumerator<CardDetail^>(pagesize),
+		m_database(database), m_language(language) {}
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// Clone
+	//
+	// Creates a new enumerator over the same rows
+	virtual KeysetEnumerator<CardDetail^>^ Clone(void) override { return gcnew CardDetailEnumerator(m_database, m_language, PageSize); }
+
+	// ReadPage
+	//
+	// Reads the page of rows that follows the specified row
+	virtual List<CardDetail^>^ ReadPage(CardDetail^ after, int pagesize) override { return m_database->ReadCardDetailPage(m_language, after, pagesize); }
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^				m_database;			// Database instance
+	CardLanguage			m_language;			// Language filter
+};
+
+//---------------------------------------------------------------------------
+// Class CardEnumerator (local)
+//
+// Enumerates cards in card identifier order
+//---------------------------------------------------------------------------
+
+ref class CardEnumerator : public KeysetEnumerator<Card^>
+{
+public:
+
+	// Instance Constructor
+	//
+	CardEnumerator(Database^ database, int pagesize) : KeysetEnumerator<Card^>(pagesize), m_database(database) {}
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// Clone
+	//
+	// Creates a new enumerator over the same rows
+	virtual KeysetEnumerator<Card^>^ Clone(void) override { return gcnew CardEnumerator(m_database, PageSize); }
+
+	// ReadPage
+	//
+	// Reads the page of rows that follows the specified row
+	virtual List<Card^>^ ReadPage(Card^ after, int pagesize) override 
+	{ 
+		return m_database->ReadCardPage(CLRISNULL(after) ? nullptr : after->CardId, pagesize); 
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^				m_database;			// Database instance
+};
+
+//---------------------------------------------------------------------------
+// Class CardFaqEnumerator (local)
+//
+// Enumerates card questions in primary key order
+//---------------------------------------------------------------------------
+
+ref class CardFaqEnumerator : public KeysetEnumerator<CardFaq^>
+{
+public:
+
+	// Instance Constructor
+	//
+	CardFaqEnumerator(Database^ database, CardLanguage language, int pagesize) : KeysetEnumerator<CardFaq^>(pagesize),
+		m_database(database), m_language(language) {}
+
+protected:
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// Clone
+	//
+	// Creates a new enumerator over the same rows
+	virtual KeysetEnumerator<CardFaq^>^ Clone(void) override { return gcnew CardFaqEnumerator(m_database, m_language, PageSize); }
+
+	// ReadPage
+	//
+	// Reads the page of rows that follows the specified row
+	virtual List<CardFaq^>^ ReadPage(CardFaq^ after, int pagesize) override { return m_database->ReadCardFaqPage(m_language, after, pagesize); }
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^				m_database;			// Database instance
+	CardLanguage			m_language;			// Language filter
+};
+
+//---------------------------------------------------------------------------
+// bind_text (local)
+//
+// Binds a text parameter to a statement; a nullptr string is bound as NULL
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	index			- Index of the parameter
+//	value			- Parameter value
+
+static int bind_text(sqlite3_stmt* statement, int index, String^ value)
+{
+	if(CLRISNULL(value)) return sqlite3_bind_null(statement, index);
+
+	pin_ptr<const wchar_t> pinvalue = PtrToStringChars(value);
+	return sqlite3_bind_text16(statement, index, pinvalue, -1, SQLITE_TRANSIENT);
+}
+
+//---------------------------------------------------------------------------
+// column_nullable_int (local)
+//
+// Converts a SQLite integer result column into a Nullable<int>
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	index			- Index of the result column
+
+static Nullable<int> column_nullable_int(sqlite3_stmt* statement, int index)
+{
+	if(sqlite3_column_type(statement, index) == SQLITE_NULL) return Nullable<int>();
+	return Nullable<int>(sqlite3_column_int(statement, index));
+}
+
+//---------------------------------------------------------------------------
+// escape_like (local)
+//
+// Escapes the wildcard characters of a LIKE pattern with a backslash
+//
+// Arguments:
+//
+//	value			- Text to be matched literally
+
+static String^ escape_like(String^ value)
+{
+	CLRASSERT(CLRISNOTNULL(value));
+	return value->Replace(L"\\", L"\\\\")->Replace(L"%", L"\\%")->Replace(L"_", L"\\_");
+}
+
+//---------------------------------------------------------------------------
+// CardReader Constructor
+//
+// Arguments:
+//
+//	database	- Owning database instance
+//	instance	- Database connection
+//	cache		- Prepared statement cache for the connection
+
+CardReader::CardReader(Database^ database, sqlite3* instance, StatementCache* cache) : m_database(database), m_instance(instance),
+	m_cache(cache), m_keys(gcnew StringTable()), m_text(gcnew array<StringTable^>(static_cast<int>(CardLanguage::Japanese) + 1))
+{
+	CLRASSERT(CLRISNOTNULL(database));
+	CLRASSERT(instance != nullptr);
+	CLRASSERT(cache != nullptr);
+
+	for(int index = 0; index < m_text->Length; index++) m_text[index] = gcnew StringTable();
+}
+
+//---------------------------------------------------------------------------
+// CardReader::AcquireStatement (private)
+//
+// Acquires a statement from the cache and binds the card identifiers to it
+//
+// Arguments:
+//
+//	sql			- SQL text of the statement
+//	cardids		- Array of card identifiers to bind as ?1
+
+sqlite3_stmt* CardReader::AcquireStatement(wchar_t const* sql, carray_text const* cardids)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	CLRASSERT(cardids != nullptr);
+
+	int result = m_cache->Acquire(sql, &statement);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+	// The array is owned by the caller and outlives the statement execution; the binding
+	// is cleared when the statement is released back to the cache
+	result = sqlite3_bind_pointer(statement, 1, const_cast<carray_text*>(cardids), CARRAY_POINTER_TYPE, nullptr);
+	if(result != SQLITE_OK) { m_cache->Release(sql, statement); throw gcnew SQLiteException(result); }
+
+	return statement;
+}
+
+//---------------------------------------------------------------------------
+// CardReader::Execute (private)
+//
+// Executes a statement that returns no rows
+//
+// Arguments:
+//
+//	sql			- SQL text of the statement
+
+void CardReader::Execute(wchar_t const* sql)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	int result = m_cache->Acquire(sql, &statement);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+	try {
+
+		result = sqlite3_step(statement);
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(sql, statement); }
+}
+
+//---------------------------------------------------------------------------
+// CardReader::FindCards
+//
+// Reads the cards that match a filter
+//
+// Arguments:
+//
+//	filter		- Card selection criteria
+
+List<Card^>^ CardReader::FindCards(CardFilter^ filter)
+{
+	CLRASSERT(CLRISNOTNULL(filter));
+
+	// A read transaction gives all of the statements the same snapshot of the database
+	Execute(L"begin transaction");
+
+	try {
+
+		List<Card^>^ cards = ReadCards(ReadCardIds(filter));
+		Execute(L"commit transaction");
+
+		return cards;
+	}
+
+	catch(Exception^) {
+
+		if(!sqlite3_get_autocommit(m_instance)) Execute(L"rollback transaction");
+		throw;
+	}
+}
+
+//---------------------------------------------------------------------------
+// CardReader::GetCards
+//
+// Reads the specified cards
+//
+// Arguments:
+//
+//	cardids		- Card identifiers
+
+List<Card^>^ CardReader::GetCards(IEnumerable<String^>^ cardids)
+{
+	CLRASSERT(CLRISNOTNULL(cardids));
+
+	// Remove any duplicate identifiers, preserving the order of the first occurrence
+	List<String^>^ distinct = gcnew List<String^>();
+	HashSet<String^>^ seen = gcnew HashSet<String^>(StringComparer::Ordinal);
+
+	for each(String^ cardid in cardids) {
+
+		if(CLRISNULL(cardid)) throw gcnew ArgumentException("Card identifiers cannot be null", "cardids");
+		if(seen->Add(cardid)) distinct->Add(cardid);
+	}
+
+	if(distinct->Count == 0) return gcnew List<Card^>();
+
+	// A read transaction gives all of the statements the same snapshot of the database
+	Execute(L"begin transaction");
+
+	try {
+
+		List<Card^>^ cards = ReadCards(distinct);
+		Execute(L"commit transaction");
+
+		return cards;
+	}
+
+	catch(Exception^) {
+
+		if(!sqlite3_get_autocommit(m_instance)) Execute(L"rollback transaction");
+		throw;
+	}
+}
+
+//---------------------------------------------------------------------------
+// CardReader::ReadCardDetailPage
+//
+// Reads the page of card details that follows a key
+//
+// Arguments:
+//
+//	language	- Language of the details, or CardLanguage::None for all
+//	after		- Last card detail of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of card details to read
+
+List<CardDetail^>^ CardReader::ReadCardDetailPage(CardLanguage language, CardDetail^ after, int pagesize)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	CLRASSERT(pagesize > 0);
+
+	// The page starts after the key of the previous page; the row value comparison is a range
+	// seek on the primary key, so reading any page costs the same as reading the first one
+	auto sql = L"select cardid, side, language, name, cost, specifiedcost, power, combopower, traits, effect from carddetail "
+		"where (cardid, side, language) > (?1, ?2, ?3) and (?4 = 0 or language = ?4) order by cardid, side, language limit ?5";
+
+	int result = m_cache->Acquire(sql, &statement);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+	try {
+
+		// The first page starts after an empty card identifier, which precedes all of the others
+		result = bind_text(statement, 1, CLRISNULL(after) ? String::Empty : after->CardId);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 2, CLRISNULL(after) ? 0 : static_cast<int>(after->Side));
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 3, CLRISNULL(after) ? 0 : static_cast<int>(after->Language));
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 4, static_cast<int>(language));
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 5, pagesize);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		List<CardDetail^>^ details = gcnew List<CardDetail^>();
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			CardLanguage rowlanguage = static_cast<CardLanguage>(sqlite3_column_int(statement, 2));
+			StringTable^ text = Text(rowlanguage);
+
+			details->Add(gcnew CardDetail(m_keys->Intern(statement, 0), static_cast<CardSide>(sqlite3_column_int(statement, 1)), rowlanguage, 
+				text->Intern(statement, 3), column_nullable_int(statement, 4), text->Intern(statement, 5), column_nullable_int(statement, 6), 
+				column_nullable_int(statement, 7), text->Intern(statement, 8), text->Intern(statement, 9)));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+		return details;
+	}
+
+	finally { m_cache->Release(sql, statement); }
+}
+
+//---------------------------------------------------------------------------
+// CardReader::ReadCardFaqPage
+//
+// Reads the page of card questions that follows a key
+//
+// Arguments:
+//
+//	language	- Language of the questions, or CardLanguage::None for all
+//	after		- Last card question of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of card questions to read
+
+List<CardFaq^>^ CardReader::ReadCardFaqPage(CardLanguage language, CardFaq^ after, int pagesize)
+{
+	sqlite3_stmt* statement = nullptr;
+	int result;
+
+	CLRASSERT(pagesize > 0);
+
+	List<CardFaq^>^ faqs = gcnew List<CardFaq^>();
+
+	// A read transaction gives both of the statements the same snapshot of the database
+	Execute(L"begin transaction");
+
+	try {
+
+		// CARDFAQ
+		//
+		// The page starts after the key of the previous page; the row value comparison is a range
+		// seek on the primary key, so reading any page costs the same as reading the first one
+		auto faqsql = L"select cardid, faqid, language, question, answer from cardfaq "
+			"where (cardid, faqid, language) > (?1, ?2, ?3) and (?4 = 0 or language = ?4) order by cardid, faqid, language limit ?5";
+
+		result = m_cache->Acquire(faqsql, &statement);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+		try {
+
+			// The first page starts after an empty card identifier, which precedes all of the others
+			result = bind_text(statement, 1, CLRISNULL(after) ? String::Empty : after->CardId);
+			if(result == SQLITE_OK) result = bind_text(statement, 2, CLRISNULL(after) ? String::Empty : after->FaqId);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 3, CLRISNULL(after) ? 0 : static_cast<int>(after->Language));
+			if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 4, static_cast<int>(language));
+			if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 5, pagesize);
+			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+			while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+				// Questions and answers are not repeated between cards, only the identifiers are interned
+				wchar_t const* answer = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 4));
+
+				faqs->Add(gcnew CardFaq(m_keys->Intern(statement, 0), m_keys->Intern(statement, 1), 
+					static_cast<CardLanguage>(sqlite3_column_int(statement, 2)), 
+					gcnew String(reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 3))), 
+					(answer == nullptr) ? nullptr : gcnew String(answer)));
+			}
+
+			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+		}
+
+		finally { m_cache->Release(faqsql, statement); }
+
+		// CARDFAQRELATED
+		//
+		// The related cards are read for the same range of keys as the page of questions
+		if(faqs->Count > 0) {
+
+			auto relatedsql = L"select cardid, faqid, language, relatedcardid from cardfaqrelated "
+				"where (cardid, faqid, language) >= (?1, ?2, ?3) and (cardid, faqid, language) <= (?4, ?5, ?6) and (?7 = 0 or language = ?7) "
+				"order by cardid, faqid, language, relatedcardid";
+
+			result = m_cache->Acquire(relatedsql, &statement);
+			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+			try {
+
+				CardFaq^ first = faqs[0];
+				CardFaq^ last = faqs[faqs->Count - 1];
+
+				result = bind_text(statement, 1, first->CardId);
+				if(result == SQLITE_OK) result = bind_text(statement, 2, first->FaqId);
+				if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 3, static_cast<int>(first->Language));
+				if(result == SQLITE_OK) result = bind_text(statement, 4, last->CardId);
+				if(result == SQLITE_OK) result = bind_text(statement, 5, last->FaqId);
+				if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 6, static_cast<int>(last->Language));
+				if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 7, static_cast<int>(language));
+				if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+				// Both statements return their rows in primary key order, so each related card belongs
+				// to either the current question or one that follows it in the page
+				int index = 0;
+				while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+					String^ cardid = m_keys->Intern(statement, 0);
+					String^ faqid = m_keys->Intern(statement, 1);
+					CardLanguage faqlanguage = static_cast<CardLanguage>(sqlite3_column_int(statement, 2));
+
+					while((index < faqs->Count) && !(String::Equals(faqs[index]->CardId, cardid) && String::Equals(faqs[index]->FaqId, faqid) 
+						&& (faqs[index]->Language == faqlanguage))) index++;
+
+					if(index < faqs->Count) faqs[index]->AddRelatedCardId(m_keys->Intern(statement, 3));
+				}
+
+				if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+			}
+
+			finally { m_cache->Release(relatedsql, statement); }
+		}
+
+		Execute(L"commit transaction");
+	}
+
+	catch(Exception^) {
+
+		if(!sqlite3_get_autocommit(m_instance)) Execute(L"rollback transaction");
+		throw;
+	}
+
+	return faqs;
+}
+
+//---------------------------------------------------------------------------
+// CardReader::ReadCardIds (private)
+//
+// Reads the identifiers of the cards that match a filter
+//
+// Arguments:
+//
+//	filter		- Card selection criteria
+
+List<String^>^ CardReader::ReadCardIds(CardFilter^ filter)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	CLRASSERT(CLRISNOTNULL(filter));
+
+	// Unset criteria are bound as NULL so that a single prepared statement serves every filter
+	auto sql = L"select cardid from card where (?1 is null or type = ?1) and (?2 is null or color = ?2) and (?3 is null or rarity = ?3) "
+		"and (?4 is null or exists(select 1 from carddetail where carddetail.cardid = card.cardid and (?6 = 0 or carddetail.language = ?6) "
+		"and carddetail.name like '%' || ?4 || '%' escape '\\')) "
+		"and (?5 is null or exists(select 1 from carddetailtrait where carddetailtrait.cardid = card.cardid and carddetailtrait.trait = ?5 "
+		"and (?6 = 0 or carddetailtrait.language = ?6))) "
+		"order by cardid";
+
+	int result = m_cache->Acquire(sql, &statement);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+	try {
+
+		String^ name = CLRISNOTNULL(filter->Name) ? escape_like(filter->Name) : nullptr;
+		String^ trait = filter->Trait;
+
+		// Bind the query parameter(s)
+		result = (filter->Type.HasValue) ? sqlite3_bind_int(statement, 1, static_cast<int>(filter->Type.Value)) : sqlite3_bind_null(statement, 1);
+		if(result == SQLITE_OK) result = (filter->Color.HasValue) ? sqlite3_bind_int(statement, 2, static_cast<int>(filter->Color.Value)) : sqlite3_bind_null(statement, 2);
+		if(result == SQLITE_OK) result = (filter->Rarity.HasValue) ? sqlite3_bind_int(statement, 3, static_cast<int>(filter->Rarity.Value)) : sqlite3_bind_null(statement, 3);
+
+		if(result == SQLITE_OK) {
+
+			pin_ptr<const wchar_t> pinname = PtrToStringChars(name);
+			result = CLRISNOTNULL(name) ? sqlite3_bind_text16(statement, 4, pinname, -1, SQLITE_TRANSIENT) : sqlite3_bind_null(statement, 4);
+		}
+
+		if(result == SQLITE_OK) {
+
+			pin_ptr<const wchar_t> pintrait = PtrToStringChars(trait);
+			result = CLRISNOTNULL(trait) ? sqlite3_bind_text16(statement, 5, pintrait, -1, SQLITE_TRANSIENT) : sqlite3_bind_null(statement, 5);
+		}
+
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 6, static_cast<int>(filter->Language));
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		List<String^>^ cardids = gcnew List<String^>();
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) cardids->Add(m_keys->Intern(statement, 0));
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+		return cardids;
+	}
+
+	finally { m_cache->Release(sql, statement); }
+}
+
+//---------------------------------------------------------------------------
+// CardReader::ReadCardPage
+//
+// Reads the page of cards that follows a key
+//
+// Arguments:
+//
+//	after		- Identifier of the last card of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of cards to read
+
+List<Card^>^ CardReader::ReadCardPage(String^ after, int pagesize)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	CLRASSERT(pagesize > 0);
+
+	List<String^>^ cardids = gcnew List<String^>();
+
+	// A read transaction gives all of the statements the same snapshot of the database
+	Execute(L"begin transaction");
+
+	try {
+
+		// The page starts after the identifier of the previous page; the comparison is a range seek
+		// on the primary key, so reading any page costs the same as reading the first one
+		auto sql = L"select cardid from card where cardid > ?1 order by cardid limit ?2";
+
+		int result = m_cache->Acquire(sql, &statement);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+
+		try {
+
+			// The first page starts after an empty card identifier, which precedes all of the others
+			result = bind_text(statement, 1, CLRISNULL(after) ? String::Empty : after);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 2, pagesize);
+			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+			while((result = sqlite3_step(statement)) == SQLITE_ROW) cardids->Add(m_keys->Intern(statement, 0));
+			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+		}
+
+		finally { m_cache->Release(sql, statement); }
+
+		List<Card^>^ cards = ReadCards(cardids);
+		Execute(L"commit transaction");
+
+		return cards;
+	}
+
+	catch(Exception^) {
+
+		if(!sqlite3_get_autocommit(m_instance)) Execute(L"rollback transaction");
+		throw;
+	}
+}
+
+//---------------------------------------------------------------------------
+// CardReader::ReadCards (private)
+//
+// Reads the specified cards and all of their child rows
+//
+// Arguments:
+//
+//	cardids		- Distinct card identifiers
+
+List<Card^>^ CardReader::ReadCards(List<String^>^ cardids)
+{
+	sqlite3_stmt* statement = nullptr;
+	Card^ card = nullptr;
+	int result;
+
+	CLRASSERT(CLRISNOTNULL(cardids));
+
+	List<Card^>^ ordered = gcnew List<Card^>(cardids->Count);
+	if(cardids->Count == 0) return ordered;
+
+	// Every statement selects from the same set of card identifiers, bound as a single array
+	carray_text values;
+	values.reserve(static_cast<size_t>(cardids->Count), static_cast<size_t>(cardids->Count) * 16);
+
+	for each(String^ cardid in cardids) {
+
+		pin_ptr<const wchar_t> pincardid = PtrToStringChars(cardid);
+		values.append(pincardid, cardid->Length);
+	}
+
+	Dictionary<String^, Card^>^ cards = gcnew Dictionary<String^, Card^>(cardids->Count, StringComparer::Ordinal);
+
+	// CARD
+	//
+	auto cardsql = L"select cardid, type, color, rarity from card where cardid in carray(?1)";
+	statement = AcquireStatement(cardsql, &values);
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			String^ cardid = m_keys->Intern(statement, 0);
+			cards->Add(cardid, gcnew Card(cardid, static_cast<CardType>(sqlite3_column_int(statement, 1)), 
+				static_cast<CardColor>(sqlite3_column_int(statement, 2)), static_cast<CardRarity>(sqlite3_column_int(statement, 3))));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(cardsql, statement); }
+
+	// CARDDETAIL
+	//
+	auto detailsql = L"select cardid, side, language, name, cost, specifiedcost, power, combopower, traits, effect from carddetail "
+		"where cardid in carray(?1) order by cardid, side, language";
+	statement = AcquireStatement(detailsql, &values);
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			if(!cards->TryGetValue(m_keys->Intern(statement, 0), card)) continue;
+
+			CardLanguage language = static_cast<CardLanguage>(sqlite3_column_int(statement, 2));
+			StringTable^ text = Text(language);
+
+			card->Add(gcnew CardDetail(card->CardId, static_cast<CardSide>(sqlite3_column_int(statement, 1)), language, text->Intern(statement, 3),
+				column_nullable_int(statement, 4), text->Intern(statement, 5), column_nullable_int(statement, 6), 
+				column_nullable_int(statement, 7), text->Intern(statement, 8), text->Intern(statement, 9)));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(detailsql, statement); }
+
+	// CARDFAQ
+	//
+	auto faqsql = L"select cardid, faqid, language, question, answer from cardfaq "
+		"where cardid in carray(?1) order by cardid, faqid, language";
+	statement = AcquireStatement(faqsql, &values);
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			if(!cards->TryGetValue(m_keys->Intern(statement, 0), card)) continue;
+
+			// Questions and answers are not repeated between cards, only the identifiers are interned
+			CardLanguage language = static_cast<CardLanguage>(sqlite3_column_int(statement, 2));
+			wchar_t const* answer = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 4));
+
+			card->Add(gcnew CardFaq(card->CardId, m_keys->Intern(statement, 1), language, 
+				gcnew String(reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 3))), 
+				(answer == nullptr) ? nullptr : gcnew String(answer)));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(faqsql, statement); }
+
+	// CARDFAQRELATED
+	//
+	auto relatedsql = L"select cardid, faqid, language, relatedcardid from cardfaqrelated "
+		"where cardid in carray(?1) order by cardid, faqid, language, relatedcardid";
+	statement = AcquireStatement(relatedsql, &values);
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			if(!cards->TryGetValue(m_keys->Intern(statement, 0), card)) continue;
+
+			CardFaq^ faq = card->FindFaq(m_keys->Intern(statement, 1), static_cast<CardLanguage>(sqlite3_column_int(statement, 2)));
+			if(CLRISNOTNULL(faq)) faq->AddRelatedCardId(m_keys->Intern(statement, 3));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(relatedsql, statement); }
+
+	// CARDIMAGE
+	//
+	// Only the image metadata is read here, the image data is loaded on demand by CardImage
+	auto imagesql = L"select cardid, side, language, format from cardimage "
+		"where cardid in carray(?1) order by cardid, side, language";
+	statement = AcquireStatement(imagesql, &values);
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			if(!cards->TryGetValue(m_keys->Intern(statement, 0), card)) continue;
+
+			card->Add(gcnew CardImage(m_database, card->CardId, static_cast<CardSide>(sqlite3_column_int(statement, 1)), 
+				static_cast<CardLanguage>(sqlite3_column_int(statement, 2)), m_keys->Intern(statement, 3)));
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(m_instance));
+	}
+
+	finally { m_cache->Release(imagesql, statement); }
+
+	// Return the cards in the order they were requested; unknown identifiers are omitted
+	for each(String^ cardid in cardids) if(cards->TryGetValue(cardid, card)) ordered->Add(card);
+
+	return ordered;
+}
+
+//---------------------------------------------------------------------------
+// CardReader::Text (private)
+//
+// Gets the string table for a language
+//
+// Arguments:
+//
+//	language	- Language of the text
+
+StringTable^ CardReader::Text(CardLanguage language)
+{
+	int index = static_cast<int>(language);
+	return ((index >= 0) && (index < m_text->Length)) ? m_text[index] : m_text[0];
+}
+
+//---------------------------------------------------------------------------
+// StringTable::Intern
+//
+// Gets the String^ for a text result column; nullptr if the column is NULL
+//
+// Arguments:
+//
+//	statement	- SQL statement instance
+//	index		- Index of the result column
+
+String^ StringTable::Intern(sqlite3_stmt* statement, int index)
+{
+	String^ existing = nullptr;
+
+	// The database is UTF-16, the column text is returned without conversion
+	wchar_t const* text = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, index));
+	if(text == nullptr) return nullptr;
+
+	int length = sqlite3_column_bytes16(statement, index) / sizeof(wchar_t);
+
+	// FNV-1a hash of the UTF-16 code units
+	uint64_t hash = 14695981039346656037ULL;
+	for(int offset = 0; offset < length; offset++) { hash ^= text[offset]; hash *= 1099511628211ULL; }
+
+	if(m_strings->TryGetValue(hash, existing)) {
+
+		// The text has to be compared, the hash alone does not guarantee a match
+		if(existing->Length == length) {
+
+			pin_ptr<const wchar_t> pinexisting = PtrToStringChars(existing);
+			if(wmemcmp(pinexisting, text, length) == 0) return existing;
+		}
+
+		// A colliding string is not interned, it is allocated every time it is seen
+		return gcnew String(text, 0, length);
+	}
+
+	String^ value = gcnew String(text, 0, length);
+	m_strings->Add(hash, value);
+
+	return value;
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardDetails
+//
+// Enumerates the card details one page at a time
+//
+// Arguments:
+//
+//	language	- Language of the details, or CardLanguage::None for all
+
+IEnumerable<CardDetail^>^ Database::EnumerateCardDetails(CardLanguage language)
+{
+	return EnumerateCardDetails(language, ENUMERATE_PAGE_SIZE);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardDetails
+//
+// Enumerates the card details one page at a time
+//
+// Arguments:
+//
+//	language	- Language of the details, or CardLanguage::None for all
+//	pagesize	- Maximum number of card details to read with each page
+
+IEnumerable<CardDetail^>^ Database::EnumerateCardDetails(CardLanguage language, int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(pagesize <= 0) throw gcnew ArgumentOutOfRangeException("pagesize");
+
+	return gcnew CardDetailEnumerator(this, language, pagesize);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardFaqs
+//
+// Enumerates the card questions one page at a time
+//
+// Arguments:
+//
+//	language	- Language of the questions, or CardLanguage::None for all
+
+IEnumerable<CardFaq^>^ Database::EnumerateCardFaqs(CardLanguage language)
+{
+	return EnumerateCardFaqs(language, ENUMERATE_PAGE_SIZE);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardFaqs
+//
+// Enumerates the card questions one page at a time
+//
+// Arguments:
+//
+//	language	- Language of the questions, or CardLanguage::None for all
+//	pagesize	- Maximum number of card questions to read with each page
+
+IEnumerable<CardFaq^>^ Database::EnumerateCardFaqs(CardLanguage language, int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(pagesize <= 0) throw gcnew ArgumentOutOfRangeException("pagesize");
+
+	return gcnew CardFaqEnumerator(this, language, pagesize);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates the cards one page at a time
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Card^>^ Database::EnumerateCards(void)
+{
+	return EnumerateCards(ENUMERATE_PAGE_SIZE);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates the cards one page at a time
+//
+// Arguments:
+//
+//	pagesize	- Maximum number of cards to read with each page
+
+IEnumerable<Card^>^ Database::EnumerateCards(int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(pagesize <= 0) throw gcnew ArgumentOutOfRangeException("pagesize");
+
+	return gcnew CardEnumerator(this, pagesize);
+}
+
+//---------------------------------------------------------------------------
+// Database::FindCards
+//
+// Gets the cards that match a filter
+//
+// Arguments:
+//
+//	filter		- Card selection criteria
+
+IReadOnlyList<Card^>^ Database::FindCards(CardFilter^ filter)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(filter)) throw gcnew ArgumentNullException("filter");
+
+	// Borrow a read-only connection when there is a pool, otherwise serialize on the writer
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return (gcnew CardReader(this, reader, reader.Statements))->FindCards(filter);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return (gcnew CardReader(this, instance, m_statements))->FindCards(filter);
+}
+
+//---------------------------------------------------------------------------
+// Database::GetCard
+//
+// Gets a single card
+//
+// Arguments:
+//
+//	cardid		- Card identifier
+
+Card^ Database::GetCard(String^ cardid)
+{
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+
+	IReadOnlyList<Card^>^ cards = GetCards(gcnew array<String^> { cardid });
+	return (cards->Count == 0) ? nullptr : cards[0];
+}
+
+//---------------------------------------------------------------------------
+// Database::GetCards
+//
+// Gets multiple cards; unknown card identifiers are omitted from the result
+//
+// Arguments:
+//
+//	cardids		- Card identifiers
+
+IReadOnlyList<Card^>^ Database::GetCards(IEnumerable<String^>^ cardids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardids)) throw gcnew ArgumentNullException("cardids");
+
+	// Borrow a read-only connection when there is a pool, otherwise serialize on the writer
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return (gcnew CardReader(this, reader, reader.Statements))->GetCards(cardids);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return (gcnew CardReader(this, instance, m_statements))->GetCards(cardids);
+}
+
+//---------------------------------------------------------------------------
+// Database::ReadCardDetailPage (internal)
+//
+// Reads the page of card details that follows a key
+//
+// Arguments:
+//
+//	language	- Language of the details, or CardLanguage::None for all
+//	after		- Last card detail of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of card details to read
+
+List<CardDetail^>^ Database::ReadCardDetailPage(CardLanguage language, CardDetail^ after, int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// Each page borrows a connection only for as long as it takes to read it; the keyset statement
+	// remains prepared in the connection's statement cache between pages
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return (gcnew CardReader(this, reader, reader.Statements))->ReadCardDetailPage(language, after, pagesize);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return (gcnew CardReader(this, instance, m_statements))->ReadCardDetailPage(language, after, pagesize);
+}
+
+//---------------------------------------------------------------------------
+// Database::ReadCardFaqPage (internal)
+//
+// Reads the page of card questions that follows a key
+//
+// Arguments:
+//
+//	language	- Language of the questions, or CardLanguage::None for all
+//	after		- Last card question of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of card questions to read
+
+List<CardFaq^>^ Database::ReadCardFaqPage(CardLanguage language, CardFaq^ after, int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// Each page borrows a connection only for as long as it takes to read it; the keyset statement
+	// remains prepared in the connection's statement cache between pages
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return (gcnew CardReader(this, reader, reader.Statements))->ReadCardFaqPage(language, after, pagesize);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return (gcnew CardReader(this, instance, m_statements))->ReadCardFaqPage(language, after, pagesize);
+}
+
+//---------------------------------------------------------------------------
+// Database::ReadCardPage (internal)
+//
+// Reads the page of cards that follows a key
+//
+// Arguments:
+//
+//	after		- Identifier of the last card of the previous page; nullptr for the first page
+//	pagesize	- Maximum number of cards to read
+
+List<Card^>^ Database::ReadCardPage(String^ after, int pagesize)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// Each page borrows a connection only for as long as it takes to read it; the keyset statement
+	// remains prepared in the connection's statement cache between pages
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return (gcnew CardReader(this, reader, reader.Statements))->ReadCardPage(after, pagesize);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return (gcnew CardReader(this, instance, m_statements))->ReadCardPage(after, pagesize);
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
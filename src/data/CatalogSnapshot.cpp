@@ -0,0 +1,457 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CatalogSnapshot.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <intrin.h>
+#include <iterator>
+#include <unordered_map>
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+// The snapshot is compiled as native code, it never interacts with managed objects
+// and the filter loops have to be free of any managed/native transitions
+#pragma managed(push, off)
+
+//---------------------------------------------------------------------------
+// ENUM_BITMAP_LIMIT
+//
+// Enumeration values at or above this limit are not given a value bitmap
+#define ENUM_BITMAP_LIMIT 64
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot Constructor
+//
+// Arguments:
+//
+//	NONE
+
+CatalogSnapshot::CatalogSnapshot()
+{
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::AndContains (private, static)
+//
+// Masks out the rows of a string column that do not contain the text
+//
+// Arguments:
+//
+//	column		- Dictionary encoded string column
+//	text		- Text to search for, case-insensitive
+//	mask		- Row selection mask to be updated
+
+void CatalogSnapshot::AndContains(string_column_t const& column, wchar_t const* text, bitmap_t& mask)
+{
+	assert(text != nullptr);
+
+	int length = static_cast<int>(wcslen(text));
+	if(length == 0) return;
+
+	// Search each distinct value once, the rows then only have to look up their code
+	std::vector<bool> matches(column.dictionary.size());
+	for(size_t index = 0; index < column.dictionary.size(); index++) {
+
+		std::wstring const& value = column.dictionary[index];
+		matches[index] = (FindStringOrdinal(FIND_FROMSTART, value.data(), static_cast<int>(value.size()), text, length, TRUE) >= 0);
+	}
+
+	for(size_t word = 0; word < mask.size(); word++) {
+
+		uint64_t bits = mask[word];
+		while(bits != 0) {
+
+			unsigned long bit;
+			_BitScanForward64(&bit, bits);
+			bits &= bits - 1;
+
+			if(!matches[column.codes[(word * 64) + bit]]) mask[word] &= ~(1ULL << bit);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::BuildBitmaps (private, static)
+//
+// Builds the value bitmaps for an enumeration column
+//
+// Arguments:
+//
+//	column		- Enumeration column
+//	rows		- Number of rows in the column, excluding any padding
+
+void CatalogSnapshot::BuildBitmaps(enum_column_t& column, size_t rows)
+{
+	assert(column.values.size() >= rows);
+
+	int32_t maximum = -1;
+	for(size_t row = 0; row < rows; row++) if((column.values[row] < ENUM_BITMAP_LIMIT) && (column.values[row] > maximum)) maximum = column.values[row];
+
+	// The bitmaps are stored one after another in value order, each one a whole number of words
+	size_t words = (rows + 63) / 64;
+	column.numbitmaps = static_cast<size_t>(maximum + 1);
+	column.bitmaps.assign(column.numbitmaps * words, 0);
+
+	for(size_t row = 0; row < rows; row++) {
+
+		int32_t value = column.values[row];
+		if((value >= 0) && (value <= maximum)) column.bitmaps[(static_cast<size_t>(value) * words) + (row / 64)] |= (1ULL << (row % 64));
+	}
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::CardCount
+//
+// Gets the number of distinct cards in the snapshot
+//
+// Arguments:
+//
+//	NONE
+
+size_t CatalogSnapshot::CardCount(void) const
+{
+	return m_cardid.dictionary.size();
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::CardId
+//
+// Gets the identifier of a card by its index
+//
+// Arguments:
+//
+//	card		- Index of the card
+
+std::wstring const& CatalogSnapshot::CardId(uint32_t card) const
+{
+	assert(card < m_cardid.dictionary.size());
+	return m_cardid.dictionary[card];
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::Collect (private)
+//
+// Converts a row selection mask into card indexes
+//
+// Arguments:
+//
+//	mask		- Row selection mask
+//	cards		- On return, contains the indexes of the selected cards
+
+void CatalogSnapshot::Collect(bitmap_t const& mask, std::vector<uint32_t>& cards) const
+{
+	cards.clear();
+
+	// The rows of each card are adjacent, a card is only added for its first selected row
+	for(size_t word = 0; word < mask.size(); word++) {
+
+		uint64_t bits = mask[word];
+		while(bits != 0) {
+
+			unsigned long bit;
+			_BitScanForward64(&bit, bits);
+			bits &= bits - 1;
+
+			uint32_t card = m_cardid.codes[(word * 64) + bit];
+			if(cards.empty() || (cards.back() != card)) cards.push_back(card);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::Filter
+//
+// Selects the indexes of the cards with at least one row matching the criteria
+//
+// Arguments:
+//
+//	criteria	- Row selection criteria
+//	cards		- On return, contains the indexes of the matching cards
+
+void CatalogSnapshot::Filter(Criteria const& criteria, std::vector<uint32_t>& cards) const
+{
+	Predicate predicate;
+
+	// The language only applies to the name criteria, same as it does for CardFilter
+	bool language = ((criteria.name != nullptr) && (criteria.language >= 0));
+
+	// The criteria are evaluated as a single conjunction
+	predicate.And(static_cast<uint32_t>((criteria.type >= 0) + (criteria.color >= 0) + (criteria.rarity >= 0) + language + 
+		criteria.cost.enabled + criteria.power.enabled + criteria.combopower.enabled));
+
+	if(criteria.type >= 0) predicate.Range(Column::Type, criteria.type, criteria.type);
+	if(criteria.color >= 0) predicate.Range(Column::Color, criteria.color, criteria.color);
+	if(criteria.rarity >= 0) predicate.Range(Column::Rarity, criteria.rarity, criteria.rarity);
+	if(language) predicate.Range(Column::Language, criteria.language, criteria.language);
+
+	if(criteria.cost.enabled) predicate.Range(Column::Cost, criteria.cost.minimum, criteria.cost.maximum);
+	if(criteria.power.enabled) predicate.Range(Column::Power, criteria.power.minimum, criteria.power.maximum);
+	if(criteria.combopower.enabled) predicate.Range(Column::ComboPower, criteria.combopower.minimum, criteria.combopower.maximum);
+
+	bitmap_t mask = Select(predicate);
+
+	// The name is tested last, only against the rows that matched everything else
+	if(criteria.name != nullptr) AndContains(m_name, criteria.name, mask);
+
+	Collect(mask, cards);
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::Filter
+//
+// Selects the indexes of the cards with at least one row matching a predicate
+//
+// Arguments:
+//
+//	predicate	- Compiled predicate
+//	cards		- On return, contains the indexes of the matching cards
+
+void CatalogSnapshot::Filter(Predicate const& predicate, std::vector<uint32_t>& cards) const
+{
+	Collect(Select(predicate), cards);
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::Load
+//
+// Loads the snapshot from a database instance
+//
+// Arguments:
+//
+//	instance	- Database instance to load the snapshot from
+
+int CatalogSnapshot::Load(sqlite3* instance)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	assert(instance != nullptr);
+	assert(m_rows == 0);
+
+	auto sql = L"select carddetail.cardid, card.type, card.color, card.rarity, carddetail.side, carddetail.language, carddetail.cost, "
+		"carddetail.power, carddetail.combopower, carddetail.name from carddetail inner join card on card.cardid = carddetail.cardid "
+		"order by carddetail.cardid, carddetail.side, carddetail.language";
+
+	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
+	if(result != SQLITE_OK) return result;
+
+	// Appends a nullable integer column value and its validity bit
+	auto append_int = [&](int_column_t& column, int index) -> void {
+
+		if((m_rows % 64) == 0) column.valid.push_back(0);
+
+		bool isnull = (sqlite3_column_type(statement, index) == SQLITE_NULL);
+		column.values.push_back(isnull ? 0 : sqlite3_column_int(statement, index));
+		if(!isnull) column.valid.back() |= (1ULL << (m_rows % 64));
+	};
+
+	try {
+
+		std::unordered_map<std::wstring, uint32_t> names;
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			// The database is UTF-16, the column text is read without conversion
+			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			size_t cardidlength = sqlite3_column_bytes16(statement, 0) / sizeof(wchar_t);
+
+			// The rows are in card identifier order, a new card starts whenever the identifier changes
+			if(m_cardid.dictionary.empty() || (m_cardid.dictionary.back().compare(0, std::wstring::npos, cardid, cardidlength) != 0))
+				m_cardid.dictionary.emplace_back(cardid, cardidlength);
+
+			m_cardid.codes.push_back(static_cast<uint32_t>(m_cardid.dictionary.size() - 1));
+
+			m_type.values.push_back(sqlite3_column_int(statement, 1));
+			m_color.values.push_back(sqlite3_column_int(statement, 2));
+			m_rarity.values.push_back(sqlite3_column_int(statement, 3));
+			m_side.values.push_back(sqlite3_column_int(statement, 4));
+			m_language.values.push_back(sqlite3_column_int(statement, 5));
+
+			append_int(m_cost, 6);
+			append_int(m_power, 7);
+			append_int(m_combopower, 8);
+
+			// Names repeat across cards and printings, each distinct name is stored once
+			std::wstring name(reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 9)), sqlite3_column_bytes16(statement, 9) / sizeof(wchar_t));
+			auto found = names.emplace(std::move(name), static_cast<uint32_t>(m_name.dictionary.size()));
+			if(found.second) m_name.dictionary.push_back(found.first->first);
+
+			m_name.codes.push_back(found.first->second);
+
+			m_rows++;
+		}
+	}
+
+	catch(std::bad_alloc const&) { result = SQLITE_NOMEM; }
+
+	sqlite3_finalize(statement);
+	if(result != SQLITE_DONE) return result;
+
+	try {
+
+		// The columns are padded out to a whole number of words so that the comparison
+		// kernels never have to deal with a partial word
+		size_t padded = ((m_rows + 63) / 64) * 64;
+		for(auto column : { &m_type, &m_color, &m_rarity, &m_side, &m_language }) column->values.resize(padded);
+		for(auto column : { &m_cost, &m_power, &m_combopower }) column->values.resize(padded);
+
+		BuildBitmaps(m_type, m_rows);
+		BuildBitmaps(m_color, m_rows);
+		BuildBitmaps(m_rarity, m_rows);
+		BuildBitmaps(m_side, m_rows);
+		BuildBitmaps(m_language, m_rows);
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::MemoryUsage
+//
+// Gets the approximate number of bytes held by the snapshot
+//
+// Arguments:
+//
+//	NONE
+
+size_t CatalogSnapshot::MemoryUsage(void) const
+{
+	// Bytes held by a string column and its dictionary
+	auto string_usage = [](string_column_t const& column) -> size_t {
+
+		size_t usage = column.codes.capacity() * sizeof(uint32_t);
+		for(auto const& value : column.dictionary) usage += sizeof(std::wstring) + (value.capacity() * sizeof(wchar_t));
+
+		return usage;
+	};
+
+	// Bytes held by an enumeration column and its bitmaps
+	auto enum_usage = [](enum_column_t const& column) -> size_t {
+
+		return (column.values.capacity() * sizeof(int32_t)) + (column.bitmaps.capacity() * sizeof(uint64_t));
+	};
+
+	// Bytes held by a nullable integer column and its validity bitmap
+	auto int_usage = [](int_column_t const& column) -> size_t {
+
+		return (column.values.capacity() * sizeof(int32_t)) + (column.valid.capacity() * sizeof(uint64_t));
+	};
+
+	return string_usage(m_cardid) + enum_usage(m_type) + enum_usage(m_color) + enum_usage(m_rarity) + enum_usage(m_side) +
+		enum_usage(m_language) + int_usage(m_cost) + int_usage(m_power) + int_usage(m_combopower) + string_usage(m_name);
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::RowCount
+//
+// Gets the number of rows in the snapshot
+//
+// Arguments:
+//
+//	NONE
+
+size_t CatalogSnapshot::RowCount(void) const
+{
+	return m_rows;
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::Select (private)
+//
+// Creates a row selection mask from a predicate
+//
+// Arguments:
+//
+//	predicate	- Compiled predicate
+
+CatalogSnapshot::bitmap_t CatalogSnapshot::Select(Predicate const& predicate) const
+{
+	bitmap_t mask((m_rows + 63) / 64);
+
+	// The filter nodes refer to the columns by their Column value
+	core::filter_column_t columns[] = {
+
+		View(Column::Type), View(Column::Color), View(Column::Rarity), View(Column::Side), View(Column::Language),
+		View(Column::Cost), View(Column::Power), View(Column::ComboPower),
+	};
+
+	// The predicate is only ever built through its own member functions, it can't be malformed
+	int result = core::filter_select(predicate.m_nodes.data(), predicate.m_nodes.size(), predicate.m_values.data(), predicate.m_values.size(),
+		columns, std::size(columns), m_rows, mask.data());
+	assert(result == SQLITE_OK);
+	(void)result;
+
+	return mask;
+}
+
+//---------------------------------------------------------------------------
+// CatalogSnapshot::View (private)
+//
+// Gets a uniform view of a column
+//
+// Arguments:
+//
+//	column		- Column to be viewed
+
+core::filter_column_t CatalogSnapshot::View(Column column) const
+{
+	// Bitmap view of an enumeration column
+	auto enum_view = [](enum_column_t const& column) -> core::filter_column_t {
+
+		return { column.values.data(), nullptr, column.bitmaps.data(), column.numbitmaps };
+	};
+
+	// Validity view of a nullable integer column
+	auto int_view = [](int_column_t const& column) -> core::filter_column_t {
+
+		return { column.values.data(), column.valid.data(), nullptr, 0 };
+	};
+
+	switch(column) {
+
+		case Column::Type: return enum_view(m_type);
+		case Column::Color: return enum_view(m_color);
+		case Column::Rarity: return enum_view(m_rarity);
+		case Column::Side: return enum_view(m_side);
+		case Column::Language: return enum_view(m_language);
+		case Column::Cost: return int_view(m_cost);
+		case Column::Power: return int_view(m_power);
+		case Column::ComboPower: return int_view(m_combopower);
+	}
+
+	assert(false);
+	return enum_view(m_type);
+}
+
+#pragma managed(pop)
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
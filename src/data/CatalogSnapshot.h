@@ -0,0 +1,278 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CATALOGSNAPSHOT_H_
+#define __CATALOGSNAPSHOT_H_
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "dbcore.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class CatalogSnapshot (internal)
+//
+// Immutable columnar copy of the card attributes, one row per card detail
+// (card, side and language) in primary key order.  Integer attributes are
+// stored as flat arrays alongside bitmaps, and strings are dictionary encoded
+//---------------------------------------------------------------------------
+
+class CatalogSnapshot
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// Column
+	//
+	// Integer columns that can be referenced by a predicate; must be kept in the
+	// same order as the managed CardCatalogField enumeration, the value is the
+	// index of the column passed to core::filter_select()
+	enum class Column : int32_t {
+
+		Type = 0,
+		Color,
+		Rarity,
+		Side,
+		Language,
+		Cost,
+		Power,
+		ComboPower,
+	};
+
+	// Predicate
+	//
+	// Compiled predicate expression, evaluated by core::filter_select(); the nodes are
+	// stored in prefix order with the operands of each And, Or and Not node immediately
+	// following it
+	class Predicate
+	{
+	public:
+
+		// And
+		//
+		// Appends a node that matches when all of the following operands match
+		void And(uint32_t operands) { m_nodes.push_back({ core::filter_and, operands }); }
+
+		// In
+		//
+		// Appends a node that matches when a column holds any of the values
+		void In(Column column, int32_t const* values, uint32_t count)
+		{
+			m_nodes.push_back({ core::filter_in, count, static_cast<uint32_t>(column), 0, 0, static_cast<uint32_t>(m_values.size()) });
+			m_values.insert(m_values.end(), values, values + count);
+		}
+
+		// Not
+		//
+		// Appends a node that matches when the following operand does not match
+		void Not(void) { m_nodes.push_back({ core::filter_not, 1 }); }
+
+		// Or
+		//
+		// Appends a node that matches when any of the following operands match
+		void Or(uint32_t operands) { m_nodes.push_back({ core::filter_or, operands }); }
+
+		// Range
+		//
+		// Appends a node that matches when a column holds a value within a range
+		void Range(Column column, int32_t minimum, int32_t maximum)
+		{
+			m_nodes.push_back({ core::filter_range, 0, static_cast<uint32_t>(column), minimum, maximum });
+		}
+
+	private:
+
+		friend class CatalogSnapshot;
+
+		std::vector<core::filter_node_t>	m_nodes;		// Nodes, in prefix order
+		std::vector<int32_t>				m_values;		// In node values
+	};
+
+	// Range
+	//
+	// Inclusive range of values to match against a nullable integer column;
+	// a disabled range matches every row including the NULL ones
+	struct Range {
+
+		bool			enabled = false;		// Range is applied
+		int32_t			minimum = INT32_MIN;	// Minimum value
+		int32_t			maximum = INT32_MAX;	// Maximum value
+	};
+
+	// Criteria
+	//
+	// Row selection criteria; negative enumeration values match every row
+	struct Criteria {
+
+		int32_t			type = -1;				// Card type
+		int32_t			color = -1;				// Card color
+		int32_t			rarity = -1;			// Card rarity
+		int32_t			language = -1;			// Name language
+		Range			cost;					// Energy cost
+		Range			power;					// Power
+		Range			combopower;				// Combo power
+		wchar_t const*	name = nullptr;			// Card name text
+	};
+
+	// Instance Constructor
+	//
+	CatalogSnapshot();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// CardCount
+	//
+	// Gets the number of distinct cards in the snapshot
+	size_t CardCount(void) const;
+
+	// CardId
+	//
+	// Gets the identifier of a card by its index
+	std::wstring const& CardId(uint32_t card) const;
+
+	// Filter
+	//
+	// Selects the indexes of the cards with at least one row matching the criteria
+	void Filter(Criteria const& criteria, std::vector<uint32_t>& cards) const;
+	void Filter(Predicate const& predicate, std::vector<uint32_t>& cards) const;
+
+	// Load
+	//
+	// Loads the snapshot from a database instance
+	int Load(sqlite3* instance);
+
+	// MemoryUsage
+	//
+	// Gets the approximate number of bytes held by the snapshot
+	size_t MemoryUsage(void) const;
+
+	// RowCount
+	//
+	// Gets the number of rows in the snapshot
+	size_t RowCount(void) const;
+
+private:
+
+	CatalogSnapshot(CatalogSnapshot const&) = delete;
+	CatalogSnapshot& operator=(CatalogSnapshot const&) = delete;
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// bitmap_t
+	//
+	// One bit per row, packed into 64-bit words
+	using bitmap_t = std::vector<uint64_t>;
+
+	// dictionary_t
+	//
+	// Distinct string values, referenced from a column by index
+	using dictionary_t = std::vector<std::wstring>;
+
+	// enum_column_t
+	//
+	// Integer column with a bitmap of the rows holding each distinct value
+	struct enum_column_t {
+
+		std::vector<int32_t>	values;			// Value of each row
+		bitmap_t				bitmaps;		// Consecutive bitmaps of the rows holding each value
+		size_t					numbitmaps = 0;	// Number of value bitmaps
+	};
+
+	// int_column_t
+	//
+	// Nullable integer column with a bitmap of the non-NULL rows
+	struct int_column_t {
+
+		std::vector<int32_t>	values;			// Value of each row
+		bitmap_t				valid;			// Rows that are not NULL
+	};
+
+	// string_column_t
+	//
+	// Dictionary encoded string column
+	struct string_column_t {
+
+		std::vector<uint32_t>	codes;			// Dictionary index of each row
+		dictionary_t			dictionary;		// Distinct values
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AndContains (static)
+	//
+	// Masks out the rows of a string column that do not contain the text
+	static void AndContains(string_column_t const& column, wchar_t const* text, bitmap_t& mask);
+
+	// BuildBitmaps (static)
+	//
+	// Builds the value bitmaps for an enumeration column
+	static void BuildBitmaps(enum_column_t& column, size_t rows);
+
+	// Collect
+	//
+	// Converts a row selection mask into card indexes
+	void Collect(bitmap_t const& mask, std::vector<uint32_t>& cards) const;
+
+	// Select
+	//
+	// Creates a row selection mask from a predicate
+	bitmap_t Select(Predicate const& predicate) const;
+
+	// View
+	//
+	// Gets a uniform view of a column
+	core::filter_column_t View(Column column) const;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	size_t					m_rows = 0;			// Number of rows
+	string_column_t			m_cardid;			// Card identifiers
+	enum_column_t			m_type;				// Card types
+	enum_column_t			m_color;			// Card colors
+	enum_column_t			m_rarity;			// Card rarities
+	enum_column_t			m_side;				// Card sides
+	enum_column_t			m_language;			// Card languages
+	int_column_t			m_cost;				// Energy costs
+	int_column_t			m_power;			// Powers
+	int_column_t			m_combopower;		// Combo powers
+	string_column_t			m_name;				// Card names
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __CATALOGSNAPSHOT_H_
@@ -25,8 +25,10 @@
 
 #include <string>
 
+#include "Extensions.h"
 #include "SQLiteException.h"
 
+using namespace System::ComponentModel;
 using namespace System::IO;
 using namespace System::Runtime::InteropServices;
 
@@ -34,6 +36,57 @@ using namespace System::Runtime::InteropServices;
 
 namespace zuki::dbsfw::data {
 
+//---------------------------------------------------------------------------
+// STATEMENT_CACHE_SIZE
+//
+// Maximum number of prepared statements held in the statement cache
+#define STATEMENT_CACHE_SIZE 32
+
+//---------------------------------------------------------------------------
+// COMPACT_SUFFIX
+//
+// Suffix appended to the database file name for the compacted copy
+#define COMPACT_SUFFIX ".compact"
+
+//---------------------------------------------------------------------------
+// READONLY_MMAP_SIZE
+//
+// Memory-mapped I/O limit applied to immutable database connections
+#define READONLY_MMAP_SIZE (1024LL * 1024 * 1024)
+
+//---------------------------------------------------------------------------
+// Class VacuumTask (local)
+//
+// Binds the arguments of an asynchronous vacuum operation
+//---------------------------------------------------------------------------
+
+ref class VacuumTask
+{
+public:
+
+	// Instance Constructor
+	//
+	VacuumTask(Database^ database, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation) :
+		m_database(database), m_progress(progress), m_cancellation(cancellation) {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Invoke
+	//
+	// Invokes the vacuum operation
+	int64_t Invoke(void) { int64_t oldsize; return m_database->Vacuum(oldsize, m_progress, m_cancellation); }
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^							m_database;			// Database instance
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+};
+
 //---------------------------------------------------------------------------
 // bind_parameter (local)
 //
@@ -99,6 +152,23 @@ static Guid column_uuid(sqlite3_stmt* statement, int index)
 	return Guid(blob);
 }
 
+//---------------------------------------------------------------------------
+// release_statement (local)
+//
+// Releases a prepared statement back into the statement cache or finalizes it
+//
+// Arguments:
+//
+//	cache			- Prepared statement cache; can be nullptr
+//	sql				- SQL text of the statement
+//	statement		- Prepared statement to be released
+
+static void release_statement(StatementCache* cache, wchar_t const* sql, sqlite3_stmt* statement)
+{
+	if(cache != nullptr) cache->Release(sql, statement);
+	else sqlite3_finalize(statement);
+}
+
 //---------------------------------------------------------------------------
 // execute_non_query (local)
 //
@@ -107,11 +177,12 @@ static Guid column_uuid(sqlite3_stmt* statement, int index)
 // Arguments:
 //
 //	instance		- Database instance
+//	cache			- Prepared statement cache; can be nullptr
 //	sql				- SQL query to execute
 //	parameters		- Parameters to be bound to the query
 
 template<typename... _parameters>
-static int execute_non_query(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+static int execute_non_query(sqlite3* instance, StatementCache* cache, wchar_t const* sql, _parameters&&... parameters)
 {
 	sqlite3_stmt* statement = nullptr;
 	int	paramindex = 1;
@@ -122,8 +193,8 @@ static int execute_non_query(sqlite3* instance, wchar_t const* sql, _parameters&
 	// Suppress unreferenced local variable warning when there are no parameters to bind
 	(void)paramindex;
 
-	// Prepare the statement
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
+	// Prepare the statement or acquire it from the statement cache
+	int result = (cache != nullptr) ? cache->Acquire(sql, &statement) : sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
 	try {
@@ -139,13 +210,30 @@ static int execute_non_query(sqlite3* instance, wchar_t const* sql, _parameters&
 		// The final result from sqlite3_step should be SQLITE_DONE
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
-		sqlite3_finalize(statement);
+		release_statement(cache, sql, statement);
 
 		// Return the number of changes made by the statement
 		return sqlite3_changes(instance);
 	}
 
-	catch(Exception^) { sqlite3_finalize(statement); throw; }
+	catch(Exception^) { release_statement(cache, sql, statement); throw; }
+}
+
+//---------------------------------------------------------------------------
+// execute_non_query (local)
+//
+// Executes a database query without the statement cache
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	parameters		- Parameters to be bound to the query
+
+template<typename... _parameters>
+static int execute_non_query(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+{
+	return execute_non_query(instance, static_cast<StatementCache*>(nullptr), sql, parameters...);
 }
 
 //---------------------------------------------------------------------------
@@ -156,11 +244,12 @@ static int execute_non_query(sqlite3* instance, wchar_t const* sql, _parameters&
 // Arguments:
 //
 //	instance		- Database instance
+//	cache			- Prepared statement cache; can be nullptr
 //	sql				- SQL query to execute
 //	parameters		- Parameters to be bound to the query
 
 template<typename... _parameters>
-static int execute_scalar_int(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+static int execute_scalar_int(sqlite3* instance, StatementCache* cache, wchar_t const* sql, _parameters&&... parameters)
 {
 	sqlite3_stmt* statement = nullptr;
 	int	paramindex = 1;
@@ -172,8 +261,8 @@ static int execute_scalar_int(sqlite3* instance, wchar_t const* sql, _parameters
 	// Suppress unreferenced local variable warning when there are no parameters to bind
 	(void)paramindex;
 
-	// Prepare the statement
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
+	// Prepare the statement or acquire it from the statement cache
+	int result = (cache != nullptr) ? cache->Acquire(sql, &statement) : sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
 	try {
@@ -188,13 +277,30 @@ static int execute_scalar_int(sqlite3* instance, wchar_t const* sql, _parameters
 		if(result == SQLITE_ROW) value = sqlite3_column_int(statement, 0);
 		else if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
-		sqlite3_finalize(statement);
+		release_statement(cache, sql, statement);
 
 		// Return the resultant value from the scalar query
 		return value;
 	}
 
-	catch(Exception^) { sqlite3_finalize(statement); throw; }
+	catch(Exception^) { release_statement(cache, sql, statement); throw; }
+}
+
+//---------------------------------------------------------------------------
+// execute_scalar_int (local)
+//
+// Executes a scalar integer query without the statement cache
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	parameters		- Parameters to be bound to the query
+
+template<typename... _parameters>
+static int execute_scalar_int(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+{
+	return execute_scalar_int(instance, static_cast<StatementCache*>(nullptr), sql, parameters...);
 }
 
 //---------------------------------------------------------------------------
@@ -205,11 +311,12 @@ static int execute_scalar_int(sqlite3* instance, wchar_t const* sql, _parameters
 // Arguments:
 //
 //	instance		- Database instance
+//	cache			- Prepared statement cache; can be nullptr
 //	sql				- SQL query to execute
 //	parameters		- Parameters to be bound to the query
 
 template<typename... _parameters>
-static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+static int64_t execute_scalar_int64(sqlite3* instance, StatementCache* cache, wchar_t const* sql, _parameters&&... parameters)
 {
 	sqlite3_stmt* statement = nullptr;
 	int	paramindex = 1;
@@ -221,8 +328,8 @@ static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _para
 	// Suppress unreferenced local variable warning when there are no parameters to bind
 	(void)paramindex;
 
-	// Prepare the statement
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
+	// Prepare the statement or acquire it from the statement cache
+	int result = (cache != nullptr) ? cache->Acquire(sql, &statement) : sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
 	try {
@@ -237,13 +344,211 @@ static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _para
 		if(result == SQLITE_ROW) value = sqlite3_column_int64(statement, 0);
 		else if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
-		sqlite3_finalize(statement);
+		release_statement(cache, sql, statement);
 
 		// Return the resultant value from the scalar query
 		return value;
 	}
 
-	catch(Exception^) { sqlite3_finalize(statement); throw; }
+	catch(Exception^) { release_statement(cache, sql, statement); throw; }
+}
+
+//---------------------------------------------------------------------------
+// execute_scalar_int64 (local)
+//
+// Executes a scalar 64-bit integer query without the statement cache
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	parameters		- Parameters to be bound to the query
+
+template<typename... _parameters>
+static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _parameters&&... parameters)
+{
+	return execute_scalar_int64(instance, static_cast<StatementCache*>(nullptr), sql, parameters...);
+}
+
+//---------------------------------------------------------------------------
+// database_size (local)
+//
+// Gets the size of the main database in bytes
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	cache			- Prepared statement cache; can be nullptr
+
+static int64_t database_size(sqlite3* instance, StatementCache* cache)
+{
+	int pagesize = execute_scalar_int(instance, cache, L"pragma page_size");
+	int64_t pagecount = execute_scalar_int64(instance, cache, L"pragma page_count");
+
+	return pagecount * pagesize;
+}
+
+//---------------------------------------------------------------------------
+// to_connection_options (local)
+//
+// Converts the managed database options into portable core connection options
+//
+// Arguments:
+//
+//	options			- Database connection options
+
+static core::connection_options_t to_connection_options(DatabaseOptions^ options)
+{
+	CLRASSERT(CLRISNOTNULL(options));
+
+	core::connection_options_t connectionoptions = {};
+
+	connectionoptions.busytimeout = options->BusyTimeout;
+	connectionoptions.cachesize = options->CacheSize;
+	connectionoptions.lookasidecount = options->LookasideSlotCount;
+	connectionoptions.lookasidesize = options->LookasideSlotSize;
+	connectionoptions.mmapsize = options->MmapSize;
+	connectionoptions.pagesize = options->PageSize;
+	connectionoptions.synchronous = static_cast<int>(options->Synchronous);
+	connectionoptions.walautocheckpoint = options->WalAutoCheckpoint;
+
+	return connectionoptions;
+}
+
+//---------------------------------------------------------------------------
+// apply_connection_options (local)
+//
+// Applies the per-connection options to a database connection
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	options			- Database connection options
+
+static void apply_connection_options(sqlite3* instance, DatabaseOptions^ options)
+{
+	CLRASSERT(instance != nullptr);
+	CLRASSERT(CLRISNOTNULL(options));
+
+	core::connection_options_t connectionoptions = to_connection_options(options);
+
+	int result = core::apply_connection_options(instance, &connectionoptions);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+}
+
+//---------------------------------------------------------------------------
+// immutable_uri (local)
+//
+// Converts a database file path into an immutable read-only URI filename
+//
+// Arguments:
+//
+//	path			- Fully qualified path to the database file
+
+static String^ immutable_uri(String^ path)
+{
+	CLRASSERT(CLRISNOTNULL(path));
+
+	// System::Uri percent-encodes the path as UTF-8, which is what SQLite expects
+	return (gcnew Uri(path))->AbsoluteUri + "?mode=ro&immutable=1";
+}
+
+//---------------------------------------------------------------------------
+// open_database (local)
+//
+// Opens a database connection and wraps it in a safe handle
+//
+// Arguments:
+//
+//	path			- Path or URI of the database file
+//	flags			- Flags to pass to sqlite3_open_v2
+
+static SQLiteSafeHandle^ open_database(String^ path, int flags)
+{
+	sqlite3* instance = nullptr;
+
+	CLRASSERT(CLRISNOTNULL(path));
+
+	// Attempt to open the database on the specified path
+	int result = core::open_database(utf8_string(path).c_str(), flags, &instance);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+	// Create the safe handle wrapper around the sqlite3*
+	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
+	CLRASSERT(instance == nullptr);
+
+	return handle;
+}
+
+//---------------------------------------------------------------------------
+// rebuild_search_indexes (local)
+//
+// Rebuilds the external content full-text indexes
+//
+// Arguments:
+//
+//	instance		- Database instance
+
+static void rebuild_search_indexes(sqlite3* instance)
+{
+	int result = core::rebuild_search_indexes(instance);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+}
+
+//---------------------------------------------------------------------------
+// select_cardimage (local)
+//
+// Selects the smallest card image that is at least the requested width
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	cache			- Prepared statement cache
+//	cardid			- Card identifier
+//	side			- Card side
+//	language		- Card language
+//	width			- Minimum width of the image
+
+static array<byte>^ select_cardimage(sqlite3* instance, StatementCache* cache, String^ cardid, CardSide side, CardLanguage language, int width)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	CLRASSERT(instance != nullptr);
+	CLRASSERT(cache != nullptr);
+	CLRASSERT(CLRISNOTNULL(cardid));
+
+	// The original image sorts after every variant so it is only selected as a fallback
+	auto sql = L"select image from (select width, image from cardimagevariant where cardid = ?1 and side = ?2 and language = ?3 and width >= ?4 "
+		"union all select 2147483647 as width, image from cardimage where cardid = ?1 and side = ?2 and language = ?3) "
+		"order by width limit 1";
+
+	// Acquire the prepared query from the statement cache
+	int result = cache->Acquire(sql, &statement);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+	try {
+
+		// Bind the query parameter(s)
+		int paramindex = 1;
+		bind_parameter(statement, paramindex, cardid);
+		result = sqlite3_bind_int(statement, paramindex++, static_cast<int>(side));
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, paramindex++, static_cast<int>(language));
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, paramindex++, width);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		// Execute the query; there will be no rows if the card image does not exist
+		result = sqlite3_step(statement);
+		if(result == SQLITE_DONE) return nullptr;
+		if(result != SQLITE_ROW) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+		int bloblen = sqlite3_column_bytes(statement, 0);
+		array<byte>^ image = gcnew array<byte>(bloblen);
+		if(bloblen > 0) Marshal::Copy(IntPtr(const_cast<void*>(sqlite3_column_blob(statement, 0))), image, 0, bloblen);
+
+		return image;
+	}
+
+	finally { cache->Release(sql, statement); }
 }
 
 //---------------------------------------------------------------------------
@@ -255,8 +560,9 @@ static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _para
 	
 static Database::Database()
 {
-	// Automatically register the built-in database extension library functions
-	s_result = sqlite3_auto_extension(reinterpret_cast<void(*)()>(sqlite3_extension_init));
+	// Automatically register the portable core functions and the built-in database extension library
+	s_result = core::initialize();
+	if(s_result == SQLITE_OK) s_result = sqlite3_auto_extension(reinterpret_cast<void(*)()>(sqlite3_extension_init));
 }
 
 //---------------------------------------------------------------------------
@@ -264,15 +570,45 @@ static Database::Database()
 //
 // Arguments:
 //
-//	handle		- SQLiteSafeHandle instance
+//	handle			- SQLiteSafeHandle instance
+//	options			- Database connection options
 
-Database::Database(SQLiteSafeHandle^ handle) : m_handle(handle)
+Database::Database(SQLiteSafeHandle^ handle, DatabaseOptions^ options) : m_handle(handle), m_writelock(gcnew Object())
 {
 	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	// Keep a copy of the options, they are applied again to each new pooled connection
+	m_options = options->Clone();
 
 	// Ensure that the static initialization completed successfully
 	if(s_result != SQLITE_OK)
 		throw gcnew Exception("Static initialization failed", gcnew SQLiteException(s_result));
+
+	// Create the prepared statement cache for the database instance
+	SQLiteSafeHandle::Reference instance(handle);
+	m_statements = new StatementCache(instance, STATEMENT_CACHE_SIZE);
+
+	// Reads are spread across a pool of read-only connections when the database is a file;
+	// WAL mode gives each of them a consistent snapshot alongside the writer connection
+	char const* filename = sqlite3_db_filename(instance, "main");
+	if((m_options->ReadConnections > 0) && (filename != nullptr) && (*filename != '\0')) {
+
+		Action<SQLiteSafeHandle^>^ initializer = gcnew Action<SQLiteSafeHandle^>(this, &Database::InitializeReadConnection);
+
+		// Immutable databases have to be opened the same way for each pooled connection
+		m_readonly = (sqlite3_db_readonly(instance, "main") == 1);
+		if(m_readonly) {
+
+			msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+			String^ uri = immutable_uri(gcnew String(filename, 0, static_cast<int>(strlen(filename)), Text::Encoding::UTF8));
+
+			m_readers = gcnew ReadConnectionPool(context->marshal_as<char const*>(uri), SQLITE_OPEN_URI, m_options->ReadConnections, 
+				STATEMENT_CACHE_SIZE, initializer);
+		}
+
+		else m_readers = gcnew ReadConnectionPool(filename, 0, m_options->ReadConnections, STATEMENT_CACHE_SIZE, initializer);
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -282,10 +618,272 @@ Database::~Database()
 {
 	if(m_disposed) return;
 
+	delete m_readers;					// Close the read-only connections
+	this->!Database();					// Release unmanaged resources
 	delete m_handle;					// Release the safe handle
 	m_disposed = true;					// Object is now in a disposed state
 }
 
+//---------------------------------------------------------------------------
+// Database Finalizer
+
+Database::!Database()
+{
+	// The cached statements have to be finalized before the database is closed
+	delete m_statements;
+	m_statements = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// Database::Compact
+//
+// Compacts the database into a new file and swaps it into place
+//
+// Arguments:
+//
+//	NONE
+
+int64_t Database::Compact(void)
+{
+	int64_t unused;
+	return Compact(unused);
+}
+
+//---------------------------------------------------------------------------
+// Database::Compact
+//
+// Compacts the database into a new file and swaps it into place; pooled
+// readers continue to run until the compacted file is ready to be swapped
+//
+// Arguments:
+//
+//	oldsize		- Size of the database prior to compaction
+
+int64_t Database::Compact([OutAttribute] int64_t% oldsize)
+{
+	String^ path = nullptr;					// Path to the database file
+	String^ compactpath = nullptr;			// Path to the compacted database file
+
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// Writes have to be blocked until the swap, they would not be in the compacted file
+	msclr::lock lock(m_writelock);
+
+	{
+		SQLiteSafeHandle::Reference instance(m_handle);
+
+		char const* filename = sqlite3_db_filename(instance, "main");
+		if((filename == nullptr) || (*filename == '\0')) throw gcnew InvalidOperationException("An in-memory database cannot be compacted");
+		if(sqlite3_db_readonly(instance, "main") == 1) throw gcnew InvalidOperationException("A read-only database cannot be compacted");
+
+		path = gcnew String(filename, 0, static_cast<int>(strlen(filename)), Text::Encoding::UTF8);
+		compactpath = path + COMPACT_SUFFIX;
+
+		// Get the size of the database prior to compaction
+		oldsize = database_size(instance, m_statements);
+
+		// VACUUM INTO will not overwrite an existing file, remove any left by a failed attempt
+		File::Delete(compactpath);
+
+		// VACUUM INTO only holds a read transaction, the pooled readers are not blocked
+		execute_non_query(instance, L"vacuum into ?1", compactpath);
+	}
+
+	try {
+
+		SQLiteSafeHandle^ compacted = open_database(compactpath, SQLITE_OPEN_READWRITE);
+
+		// Rebuild the full-text indexes in the compacted file before it is swapped in
+		try { SQLiteSafeHandle::Reference instance(compacted); rebuild_search_indexes(instance); }
+		finally { delete compacted; }
+	}
+
+	catch(Exception^) { File::Delete(compactpath); throw; }
+
+	// Every connection has to be closed before the database file can be replaced
+	if(CLRISNOTNULL(m_readers)) m_readers->Suspend();
+
+	try {
+
+		msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+		DWORD error = ERROR_SUCCESS;
+
+		// The cached statements have to be finalized before the database is closed
+		delete m_statements;
+		m_statements = nullptr;
+
+		// Closing the last connection checkpoints the WAL into the database file and removes it
+		delete m_handle;
+		m_handle = nullptr;
+
+		// A WAL that remains (another process has the database open) would be replayed against
+		// the compacted file; otherwise replace the database file in a single rename operation
+		if(File::Exists(path + "-wal")) error = ERROR_SHARING_VIOLATION;
+		else if(!MoveFileExW(context->marshal_as<wchar_t const*>(compactpath), context->marshal_as<wchar_t const*>(path),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) error = GetLastError();
+
+		// The data version of the new connection cannot be compared with the old one
+		m_catalog = nullptr;
+
+		// Reopen whichever database file is now in place; the new connection and statement cache
+		// are only assigned to the members once both have been successfully initialized
+		SQLiteSafeHandle^ handle = nullptr;
+		StatementCache* statements = nullptr;
+
+		try {
+
+			handle = open_database(path, SQLITE_OPEN_READWRITE);
+			InitializeInstance(handle, m_options);
+
+			SQLiteSafeHandle::Reference instance(handle);
+			statements = new StatementCache(instance, STATEMENT_CACHE_SIZE);
+		}
+
+		catch(Exception^) {
+
+			if(CLRISNOTNULL(handle)) delete handle;
+
+			// The original connection is already closed and cannot be restored; the instance is
+			// left disposed so that any further use throws ObjectDisposedException. Waiting readers
+			// are released first, the pool closes their connections as they are returned
+			if(CLRISNOTNULL(m_readers)) { m_readers->Resume(); delete m_readers; m_readers = nullptr; }
+			m_disposed = true;
+
+			if(error != ERROR_SUCCESS) File::Delete(compactpath);
+			throw;
+		}
+
+		m_handle = handle;
+		m_statements = statements;
+
+		SQLiteSafeHandle::Reference instance(m_handle);
+
+		if(error != ERROR_SUCCESS) {
+
+			File::Delete(compactpath);
+			throw gcnew Win32Exception(static_cast<int>(error));
+		}
+
+		// Get the size of the database after compaction
+		return database_size(instance, m_statements);
+	}
+
+	finally { if(CLRISNOTNULL(m_readers)) m_readers->Resume(); }
+}
+
+//---------------------------------------------------------------------------
+// Database::GetCardImage
+//
+// Gets the smallest card image that is at least the requested width; the
+// original image is returned if no precomputed variant is wide enough
+//
+// Arguments:
+//
+//	cardid		- Card identifier
+//	side		- Card side
+//	language	- Card language
+//	width		- Minimum width of the image; zero for the smallest available
+
+array<byte>^ Database::GetCardImage(String^ cardid, CardSide side, CardLanguage language, int width)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	if(width < 0) throw gcnew ArgumentOutOfRangeException("width");
+
+	// Borrow a read-only connection when there is a pool, otherwise serialize on the writer
+	if(CLRISNOTNULL(m_readers)) {
+
+		ReadConnectionPool::Reference reader(m_readers);
+		return select_cardimage(reader, reader.Statements, cardid, side, language, width);
+	}
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	return select_cardimage(instance, m_statements, cardid, side, language, width);
+}
+
+//---------------------------------------------------------------------------
+// Database::GetCatalog
+//
+// Gets an in-memory snapshot of the card attributes, rebuilt after the database changes
+//
+// Arguments:
+//
+//	NONE
+
+CardCatalog^ Database::GetCatalog(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// An immutable database cannot change, the first snapshot remains current
+	CardCatalog^ catalog = m_catalog;
+	if(m_readonly && CLRISNOTNULL(catalog)) return catalog;
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	// The data version of the writer connection changes whenever another connection commits to
+	// the database; the writer itself never modifies the card data once the database is open
+	int64_t version = execute_scalar_int64(instance, m_statements, L"pragma data_version");
+	if(CLRISNOTNULL(m_catalog) && (m_catalog->Version == version)) return m_catalog;
+
+	// The previous snapshot may still be in use by the caller(s), it is left to the finalizer
+	m_catalog = CardCatalog::Create(instance, version);
+
+	return m_catalog;
+}
+
+//---------------------------------------------------------------------------
+// Database::IncrementalVacuum
+//
+// Releases up to the specified number of free pages from the database
+//
+// Arguments:
+//
+//	pages		- Maximum number of free pages to release
+
+int64_t Database::IncrementalVacuum(int pages)
+{
+	int64_t unused;
+	return IncrementalVacuum(pages, unused);
+}
+
+//---------------------------------------------------------------------------
+// Database::IncrementalVacuum
+//
+// Releases up to the specified number of free pages from the database
+//
+// Arguments:
+//
+//	pages		- Maximum number of free pages to release
+//	oldsize		- Size of the database prior to the incremental vacuum
+
+int64_t Database::IncrementalVacuum(int pages, [OutAttribute] int64_t% oldsize)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// SQLite releases the entire free list for a count of zero, which is what Vacuum() is for
+	if(pages <= 0) throw gcnew ArgumentOutOfRangeException("pages");
+
+	msclr::lock lock(m_writelock);
+	SQLiteSafeHandle::Reference instance(m_handle);
+
+	// Get the size of the database prior to the incremental vacuum
+	oldsize = database_size(instance, m_statements);
+
+	int result = core::incremental_vacuum(instance, pages);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+	// Get the size of the database after the incremental vacuum
+	return database_size(instance, m_statements);
+}
+
 //---------------------------------------------------------------------------
 // Database::InitializeInstance (private, static)
 //
@@ -294,21 +892,26 @@ Database::~Database()
 // Arguments:
 //
 //	handle		- SQLiteSafeHandle instance
+//	options		- Database connection options
 
-void Database::InitializeInstance(SQLiteSafeHandle^ handle)
+void Database::InitializeInstance(SQLiteSafeHandle^ handle, DatabaseOptions^ options)
 {
 	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
 	
 	SQLiteSafeHandle::Reference instance(handle);
 
 	// Set the instance to report extended error codes
 	sqlite3_extended_result_codes(instance, TRUE);
 
-	// Set a busy timeout handler for this connection
-	sqlite3_busy_timeout(instance, 5000);
+	// Apply the lookaside, busy timeout, cache and memory-mapping options
+	apply_connection_options(instance, options);
 
-	// Switch the database to write-ahead logging
-	execute_non_query(instance, L"pragma journal_mode=wal");
+	// Apply the page size, incremental auto-vacuum, write-ahead logging, durability and WAL
+	// checkpoint options; the page size has to be set before the switch to write-ahead logging
+	core::connection_options_t writeroptions = to_connection_options(options);
+	int result = core::apply_writer_options(instance, &writeroptions);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
 	// Switch the database to UTF-16 encoding
 	execute_non_query(instance, L"pragma encoding='UTF-16'");
@@ -316,58 +919,15 @@ void Database::InitializeInstance(SQLiteSafeHandle^ handle)
 	// Enable foreign key constraints
 	execute_non_query(instance, L"pragma foreign_keys=ON");
 
-	// Get the database schema version
-	int dbversion = execute_scalar_int(instance, L"pragma user_version");
+	// Apply any schema migration steps that have not yet been applied to the database
+	char* errmsg = nullptr;
+	result = core::upgrade_database(instance, &errmsg);
+	if(result != SQLITE_OK) {
 
-	// SCHEMA VERSION 0 -> VERSION 1
-	//
-	// Original database schema
-	if(dbversion == 0) {
-
-		// table: card
-		//
-		// cardid(pk) | type | color | rarity
-		execute_non_query(instance, L"create table card(cardid text not null, type text not null, color text not null, rarity text not null, "
-			"primary key(cardid), "
-			"check(type in ('LEADER', 'BATTLE', 'EXTRA')), check(color in ('Red', 'Blue', 'Green', 'Yellow', 'Black')), "
-			"check(rarity in ('L', 'C', 'R', 'SR', 'SCR', 'PR')))");
-
-		// table: carddetail
-		//
-		// cardid(pk|fk) | side(pk) | language(pk) | name | cost | specifiedcost | power | combopower | traits | effect
-		execute_non_query(instance, L"create table carddetail(cardid text not null, side text null, language text not null, name text not null, "
-			"cost integer null, specifiedcost text null, power integer null, combopower integer null, traits text null, effect text null, "
-			"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
-			"check(side in (null, 'FRONT', 'BACK')), check(language in('EN', 'JP')))");
-
-		// table: cardfaq
-		//
-		// cardid(pk|fk) | faqid(pk) | language(pk) | question | answer
-		execute_non_query(instance, L"create table cardfaq(cardid text not null, faqid text not null, language text not null, question text not null, "
-			"answer text null, "
-			"primary key(cardid, faqid, language) foreign key(cardid) references card(cardid), "
-			"check(language in('EN', 'JP')))");
-
-		// table: cardfaqrelated
-		//
-		// cardid(pk|fk) | faqid(pk|fk) | language(pk|fk) | relatedcardid (pk)
-		execute_non_query(instance, L"create table cardfaqrelated(cardid text not null, faqid text null, language text not null, relatedcardid text not null, "
-			"primary key(cardid, faqid, language, relatedcardid) foreign key(cardid, faqid, language) references cardfaq(cardid, faqid, language), "
-			"check(language in('EN', 'JP')))");
-
-		// table: cardimage
-		//
-		// cardid(pk|fk) | side(pk) | language(pk) | format | image
-		execute_non_query(instance, L"create table cardimage(cardid text not null, side text null, language text not null, "
-			"format text not null, image blob not null, "
-			"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
-			"check(side in (null, 'FRONT', 'BACK')), check(language in ('EN', 'JP')))");
-
-		execute_non_query(instance, L"pragma user_version = 1");
-		dbversion = 1;
+		SQLiteException^ exception = gcnew SQLiteException(result, (errmsg) ? errmsg : sqlite3_errmsg(instance));
+		sqlite3_free(errmsg);
+		throw exception;
 	}
-
-	CLRASSERT(dbversion == 1);
 }
 
 //---------------------------------------------------------------------------
@@ -381,34 +941,204 @@ void Database::InitializeInstance(SQLiteSafeHandle^ handle)
 
 Database^ Database::Open(String^ path)
 {
-	sqlite3* instance = nullptr;
+	return Open(path, Environment::ProcessorCount);
+}
 
-	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+//---------------------------------------------------------------------------
+// Database::Open (static)
+//
+// Opens an existing database file
+//
+// Arguments:
+//
+//	path			- Path on which to open the database file
+//	readconnections	- Maximum number of pooled read-only connections
 
-	// Create a marshaling context to convert the String^ into an ANSI C-style string
-	msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+Database^ Database::Open(String^ path, int readconnections)
+{
+	DatabaseOptions^ options = DatabaseOptions::Default;
+	options->ReadConnections = readconnections;
 
-	// Attempt to open the database on the specified path
-	int result = sqlite3_open_v2(context->marshal_as<char const*>(Path::GetFullPath(path)), &instance,
-		SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
-	if(result != SQLITE_OK) {
+	return Open(path, options);
+}
 
-		if(instance != nullptr) sqlite3_close(instance);
-		throw gcnew SQLiteException(result);
-	}
+//---------------------------------------------------------------------------
+// Database::Open (static)
+//
+// Opens an existing database file
+//
+// Arguments:
+//
+//	path			- Path on which to open the database file
+//	options			- Database connection options
 
-	// Create the safe handle wrapper around the sqlite3*
-	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
-	CLRASSERT(instance == nullptr);
+Database^ Database::Open(String^ path, DatabaseOptions^ options)
+{
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	// Attempt to open the database on the specified path
+	SQLiteSafeHandle^ handle = open_database(Path::GetFullPath(path), SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
 
 	// Initialize the database instance
-	InitializeInstance(handle);
+	InitializeInstance(handle, options);
 
 	// Delete the safe handle on a construction failure
-	try { return gcnew Database(handle); }
+	try { return gcnew Database(handle, options); }
+	catch(Exception^) { delete handle; throw; }
+}
+
+//---------------------------------------------------------------------------
+// Database::InitializeReadConnection (private)
+//
+// Initializes a pooled read-only connection for use
+//
+// Arguments:
+//
+//	handle		- SQLiteSafeHandle instance
+
+void Database::InitializeReadConnection(SQLiteSafeHandle^ handle)
+{
+	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+
+	// Pooled connections to an immutable database are initialized just like the main connection
+	if(m_readonly) { InitializeReadOnlyInstance(handle, m_options); return; }
+
+	SQLiteSafeHandle::Reference instance(handle);
+
+	// Set the instance to report extended error codes
+	sqlite3_extended_result_codes(instance, TRUE);
+
+	// Apply the lookaside, busy timeout, cache and memory-mapping options
+	apply_connection_options(instance, m_options);
+}
+
+//---------------------------------------------------------------------------
+// Database::InitializeReadOnlyInstance (private, static)
+//
+// Initializes an immutable database instance for use
+//
+// Arguments:
+//
+//	handle		- SQLiteSafeHandle instance
+//	options		- Database connection options
+
+void Database::InitializeReadOnlyInstance(SQLiteSafeHandle^ handle, DatabaseOptions^ options)
+{
+	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	SQLiteSafeHandle::Reference instance(handle);
+
+	// Set the instance to report extended error codes
+	sqlite3_extended_result_codes(instance, TRUE);
+
+	// Apply the lookaside, busy timeout, cache and memory-mapping options; a memory-mapped
+	// immutable database reads pages directly from the mapping rather than the page cache
+	apply_connection_options(instance, options);
+
+	// Reject any write attempts before they reach the file
+	execute_non_query(instance, L"pragma query_only=ON");
+
+	// The schema cannot be upgraded in place, the database file must already be current
+	if(execute_scalar_int(instance, L"pragma user_version") != core::schema_version)
+		throw gcnew Exception("Database schema version is not current; open the database for write access to upgrade it");
+}
+
+//---------------------------------------------------------------------------
+// Database::OpenReadOnly (static)
+//
+// Opens an existing database file as immutable
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
+
+Database^ Database::OpenReadOnly(String^ path)
+{
+	return OpenReadOnly(path, Environment::ProcessorCount);
+}
+
+//---------------------------------------------------------------------------
+// Database::OpenReadOnly (static)
+//
+// Opens an existing database file as immutable
+//
+// Arguments:
+//
+//	path			- Path on which to open the database file
+//	readconnections	- Maximum number of pooled read-only connections
+
+Database^ Database::OpenReadOnly(String^ path, int readconnections)
+{
+	DatabaseOptions^ options = DatabaseOptions::Default;
+	options->MmapSize = READONLY_MMAP_SIZE;
+	options->ReadConnections = readconnections;
+
+	return OpenReadOnly(path, options);
+}
+
+//---------------------------------------------------------------------------
+// Database::OpenReadOnly (static)
+//
+// Opens an existing database file as immutable
+//
+// Arguments:
+//
+//	path			- Path on which to open the database file
+//	options			- Database connection options
+
+Database^ Database::OpenReadOnly(String^ path, DatabaseOptions^ options)
+{
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	// The database is opened with immutable=1, SQLite will neither lock the file nor look
+	// for a journal or WAL, which allows the file to reside on read-only media
+	SQLiteSafeHandle^ handle = open_database(immutable_uri(Path::GetFullPath(path)), SQLITE_OPEN_READONLY | SQLITE_OPEN_URI);
+
+	// Delete the safe handle on an initialization or construction failure
+	try {
+
+		InitializeReadOnlyInstance(handle, options);
+		return gcnew Database(handle, options);
+	}
+
 	catch(Exception^) { delete handle; throw; }
 }
 
+//---------------------------------------------------------------------------
+// Database::StatementCacheHits::get
+//
+// Gets the number of prepared statements reused from the statement cache
+
+int64_t Database::StatementCacheHits::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// The statement cache is replaced by Compact() while it holds the writer lock
+	msclr::lock lock(m_writelock);
+	CHECK_DISPOSED(m_disposed);
+
+	return static_cast<int64_t>(m_statements->Hits());
+}
+
+//---------------------------------------------------------------------------
+// Database::StatementCacheMisses::get
+//
+// Gets the number of statements that had to be prepared
+
+int64_t Database::StatementCacheMisses::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// The statement cache is replaced by Compact() while it holds the writer lock
+	msclr::lock lock(m_writelock);
+	CHECK_DISPOSED(m_disposed);
+
+	return static_cast<int64_t>(m_statements->Misses());
+}
+
 //---------------------------------------------------------------------------
 // Database::Vacuum
 //
@@ -434,24 +1164,81 @@ int64_t Database::Vacuum(void)
 //	oldsize		- Size of the database prior to vacuum
 
 int64_t Database::Vacuum([OutAttribute] int64_t% oldsize)
+{
+	return Vacuum(oldsize, nullptr, CancellationToken::None);
+}
+
+//---------------------------------------------------------------------------
+// Database::Vacuum (internal)
+//
+// Vacuums the database
+//
+// Arguments:
+//
+//	oldsize			- Size of the database prior to vacuum
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+int64_t Database::Vacuum(int64_t% oldsize, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
 {
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
+	msclr::lock lock(m_writelock);
 	SQLiteSafeHandle::Reference instance(m_handle);
 
+	cancellation.ThrowIfCancellationRequested();
+	if(CLRISNOTNULL(progress)) progress->Report(gcnew DatabaseProgress(0, nullptr));
+
 	// Get the size of the database prior to vacuuming
-	int pagesize = execute_scalar_int(instance, L"pragma page_size");
-	int64_t pagecount = execute_scalar_int64(instance, L"pragma page_count");
-	oldsize = pagecount * pagesize;
+	oldsize = database_size(instance, m_statements);
+
+	// Cancellation interrupts the VACUUM, which leaves the database as it was
+	CancellationTokenRegistration registration = cancellation.Register(gcnew Action(m_handle, &SQLiteSafeHandle::Interrupt));
+
+	try {
+
+		// The VACUUM is executed apart from core::vacuum() so that only it can be interrupted
+		int result = core::execute_non_query(instance, "vacuum", nullptr);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	catch(SQLiteException^) {
+
+		// An interrupted query fails with SQLITE_INTERRUPT, report that as a cancellation
+		cancellation.ThrowIfCancellationRequested();
+		throw;
+	}
+
+	// The full-text index rebuild cannot be interrupted, the indexes would be left inconsistent
+	finally { registration.Dispose(); }
+
+	if(CLRISNOTNULL(progress)) progress->Report(gcnew DatabaseProgress(80, nullptr));
+
+	// Rebuild the full-text indexes against the reassigned rowids
+	rebuild_search_indexes(instance);
 
-	execute_non_query(instance, L"vacuum");
+	if(CLRISNOTNULL(progress)) progress->Report(gcnew DatabaseProgress(100, nullptr));
 
 	// Get the size of the database after vacuuming
-	pagesize = execute_scalar_int(instance, L"pragma page_size");
-	pagecount = execute_scalar_int64(instance, L"pragma page_count");
+	return database_size(instance, m_statements);
+}
 
-	return pagecount * pagesize;
+//---------------------------------------------------------------------------
+// Database::VacuumAsync
+//
+// Asynchronously vacuums the database
+//
+// Arguments:
+//
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Task<int64_t>^ Database::VacuumAsync(IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	return Task::Run<int64_t>(gcnew Func<int64_t>(gcnew VacuumTask(this, progress, cancellation), &VacuumTask::Invoke), cancellation);
 }
 
 //---------------------------------------------------------------------------
@@ -26,11 +26,23 @@
 
 #pragma warning(push, 4)
 
+#include "Card.h"
+#include "CardCatalog.h"
+#include "CardFilter.h"
+#include "CardLanguage.h"
+#include "CardSide.h"
+#include "DatabaseOptions.h"
+#include "DatabaseProgress.h"
+#include "dbcore.h"
+#include "ReadConnectionPool.h"
 #include "SQLiteSafeHandle.h"
+#include "StatementCache.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
 using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
 
 // dbextension.cpp
 //
@@ -51,20 +63,110 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// Backup
+	//
+	// Copies the live database into a backup file
+	void Backup(String^ path);
+	void Backup(String^ path, int pagesperstep, int pausems);
+
+	// BackupAsync
+	//
+	// Asynchronously copies the live database into a backup file
+	Task^ BackupAsync(String^ path, int pagesperstep, int pausems, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// Compact
+	//
+	// Compacts the database into a new file and swaps it into place
+	int64_t Compact(void);
+	int64_t Compact([OutAttribute] int64_t% oldsize);
+
 	// Export
 	//
 	// Exports the database into flat files for storage
 	void Export(String^ path);
 
+	// ExportAsync
+	//
+	// Asynchronously exports the database into flat files for storage
+	Task^ ExportAsync(String^ path, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// EnumerateCardDetails
+	//
+	// Enumerates the card details one page at a time
+	IEnumerable<CardDetail^>^ EnumerateCardDetails(CardLanguage language);
+	IEnumerable<CardDetail^>^ EnumerateCardDetails(CardLanguage language, int pagesize);
+
+	// EnumerateCardFaqs
+	//
+	// Enumerates the card questions one page at a time
+	IEnumerable<CardFaq^>^ EnumerateCardFaqs(CardLanguage language);
+	IEnumerable<CardFaq^>^ EnumerateCardFaqs(CardLanguage language, int pagesize);
+
+	// EnumerateCards
+	//
+	// Enumerates the cards one page at a time
+	IEnumerable<Card^>^ EnumerateCards(void);
+	IEnumerable<Card^>^ EnumerateCards(int pagesize);
+
+	// FindCards
+	//
+	// Gets the cards that match a filter
+	IReadOnlyList<Card^>^ FindCards(CardFilter^ filter);
+
+	// GetCard
+	//
+	// Gets a single card
+	Card^ GetCard(String^ cardid);
+
+	// GetCardImage
+	//
+	// Gets the smallest card image that is at least the requested width
+	array<byte>^ GetCardImage(String^ cardid, CardSide side, CardLanguage language, int width);
+
+	// GetCards
+	//
+	// Gets multiple cards; unknown card identifiers are omitted from the result
+	IReadOnlyList<Card^>^ GetCards(IEnumerable<String^>^ cardids);
+
+	// GetCatalog
+	//
+	// Gets an in-memory snapshot of the card attributes, rebuilt after the database changes
+	CardCatalog^ GetCatalog(void);
+
 	// Import
 	//
 	// Creates a new database instance via import
 	static Database^ Import(String^ path, String^ outputfile);
+	static Database^ Import(String^ path, String^ outputfile, array<int>^ variantwidths);
+	static Database^ Import(String^ path, String^ outputfile, DatabaseOptions^ options);
+	static Database^ Import(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options);
+
+	// ImportAsync
+	//
+	// Asynchronously creates a new database instance via import
+	static Task<Database^>^ ImportAsync(String^ path, String^ outputfile, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+	static Task<Database^>^ ImportAsync(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options, 
+		IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// IncrementalVacuum
+	//
+	// Releases up to the specified number of free pages from the database
+	int64_t IncrementalVacuum(int pages);
+	int64_t IncrementalVacuum(int pages, [OutAttribute] int64_t% oldsize);
 
 	// Open
 	//
 	// Opens a new database instance
 	static Database^ Open(String^ path);
+	static Database^ Open(String^ path, int readconnections);
+	static Database^ Open(String^ path, DatabaseOptions^ options);
+
+	// OpenReadOnly
+	//
+	// Opens an existing database file as immutable
+	static Database^ OpenReadOnly(String^ path);
+	static Database^ OpenReadOnly(String^ path, int readconnections);
+	static Database^ OpenReadOnly(String^ path, DatabaseOptions^ options);
 
 	// Vacuum
 	//
@@ -72,8 +174,71 @@ public:
 	int64_t Vacuum(void);
 	int64_t Vacuum([OutAttribute] int64_t% oldsize);
 
+	// VacuumAsync
+	//
+	// Asynchronously vacuums the database
+	Task<int64_t>^ VacuumAsync(IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// StatementCacheHits
+	//
+	// Gets the number of prepared statements reused from the statement cache
+	property int64_t StatementCacheHits
+	{
+		int64_t get(void);
+	}
+
+	// StatementCacheMisses
+	//
+	// Gets the number of statements that had to be prepared
+	property int64_t StatementCacheMisses
+	{
+		int64_t get(void);
+	}
+
 internal:
 
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Backup
+	//
+	// Copies the live database into a backup file
+	void Backup(String^ path, int pagesperstep, int pausems, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// Export
+	//
+	// Exports the database into flat files for storage
+	void Export(String^ path, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// Import
+	//
+	// Creates a new database instance via import
+	static Database^ Import(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options, 
+		IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
+	// ReadCardDetailPage
+	//
+	// Reads the page of card details that follows a key
+	List<CardDetail^>^ ReadCardDetailPage(CardLanguage language, CardDetail^ after, int pagesize);
+
+	// ReadCardFaqPage
+	//
+	// Reads the page of card questions that follows a key
+	List<CardFaq^>^ ReadCardFaqPage(CardLanguage language, CardFaq^ after, int pagesize);
+
+	// ReadCardPage
+	//
+	// Reads the page of cards that follows a key
+	List<Card^>^ ReadCardPage(String^ after, int pagesize);
+
+	// Vacuum
+	//
+	// Vacuums the database
+	int64_t Vacuum(int64_t% oldsize, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation);
+
 private:
 
 	// Static Constructor
@@ -82,25 +247,45 @@ private:
 
 	// Instance Constructor
 	//
-	Database(SQLiteSafeHandle^ handle);
+	Database(SQLiteSafeHandle^ handle, DatabaseOptions^ options);
 
 	// Destructor
 	//
 	~Database();
 
+	// Finalizer
+	//
+	!Database();
+
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
 	// InitializeInstance (static)
 	//
 	// Initializes the database instance for use
-	static void InitializeInstance(SQLiteSafeHandle^ handle);
+	static void InitializeInstance(SQLiteSafeHandle^ handle, DatabaseOptions^ options);
+
+	// InitializeReadConnection
+	//
+	// Initializes a pooled read-only connection for use
+	void InitializeReadConnection(SQLiteSafeHandle^ handle);
+
+	// InitializeReadOnlyInstance (static)
+	//
+	// Initializes an immutable database instance for use
+	static void InitializeReadOnlyInstance(SQLiteSafeHandle^ handle, DatabaseOptions^ options);
 
 	//-----------------------------------------------------------------------
 	// Member Variables
 
 	bool					m_disposed = false;		// Object disposal flag
 	SQLiteSafeHandle^		m_handle;				// Database safe handle
+	StatementCache*			m_statements = nullptr;	// Prepared statement cache
+	ReadConnectionPool^		m_readers;				// Read-only connection pool
+	Object^					m_writelock;			// Writer connection lock
+	DatabaseOptions^		m_options;				// Connection options
+	bool					m_readonly = false;		// Immutable database flag
+	CardCatalog^			m_catalog;				// Current catalog snapshot
 	
 	static int				s_result = SQLITE_OK;	// Result from static init
 };
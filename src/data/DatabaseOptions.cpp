@@ -0,0 +1,313 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DatabaseOptions.h"
+
+#include "dbcore.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// apply_preset (local)
+//
+// Applies one of the portable core connection option presets
+//
+// Arguments:
+//
+//	options		- Options to be updated
+//	preset		- Connection option preset
+
+static void apply_preset(DatabaseOptions^ options, core::connection_options_t const& preset)
+{
+	options->BusyTimeout = preset.busytimeout;
+	options->CacheSize = preset.cachesize;
+	options->LookasideSlotCount = preset.lookasidecount;
+	options->LookasideSlotSize = preset.lookasidesize;
+	options->MmapSize = preset.mmapsize;
+	options->PageSize = preset.pagesize;
+	options->Synchronous = static_cast<SynchronousMode>(preset.synchronous);
+	options->WalAutoCheckpoint = preset.walautocheckpoint;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions Constructor
+//
+// Arguments:
+//
+//	NONE
+
+DatabaseOptions::DatabaseOptions() : m_readconnections(Environment::ProcessorCount)
+{
+	apply_preset(this, core::default_options);
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::BusyTimeout::get
+//
+// Gets the busy timeout of each connection, in milliseconds
+
+int DatabaseOptions::BusyTimeout::get(void)
+{
+	return m_busytimeout;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::BusyTimeout::set
+//
+// Sets the busy timeout of each connection, in milliseconds
+
+void DatabaseOptions::BusyTimeout::set(int value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_busytimeout = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::CacheSize::get
+//
+// Gets the page cache size of each connection, in KiB
+
+int DatabaseOptions::CacheSize::get(void)
+{
+	return m_cachesize;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::CacheSize::set
+//
+// Sets the page cache size of each connection, in KiB
+
+void DatabaseOptions::CacheSize::set(int value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_cachesize = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::Clone
+//
+// Creates a copy of the options
+//
+// Arguments:
+//
+//	NONE
+
+DatabaseOptions^ DatabaseOptions::Clone(void)
+{
+	return safe_cast<DatabaseOptions^>(MemberwiseClone());
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::Compact::get (static)
+//
+// Gets options for a small memory footprint, suitable for metadata-only clients
+
+DatabaseOptions^ DatabaseOptions::Compact::get(void)
+{
+	DatabaseOptions^ options = gcnew DatabaseOptions();
+
+	apply_preset(options, core::compact_options);
+	options->ReadConnections = 1;				// Single read connection
+
+	return options;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::Default::get (static)
+//
+// Gets the default options
+
+DatabaseOptions^ DatabaseOptions::Default::get(void)
+{
+	return gcnew DatabaseOptions();
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::ImageCatalog::get (static)
+//
+// Gets options suited to heavy access of the card images
+
+DatabaseOptions^ DatabaseOptions::ImageCatalog::get(void)
+{
+	DatabaseOptions^ options = gcnew DatabaseOptions();
+	apply_preset(options, core::imagecatalog_options);
+
+	return options;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::LookasideSlotCount::get
+//
+// Gets the number of lookaside memory slots of each connection
+
+int DatabaseOptions::LookasideSlotCount::get(void)
+{
+	return m_lookasidecount;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::LookasideSlotCount::set
+//
+// Sets the number of lookaside memory slots of each connection
+
+void DatabaseOptions::LookasideSlotCount::set(int value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_lookasidecount = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::LookasideSlotSize::get
+//
+// Gets the size of each lookaside memory slot, in bytes
+
+int DatabaseOptions::LookasideSlotSize::get(void)
+{
+	return m_lookasidesize;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::LookasideSlotSize::set
+//
+// Sets the size of each lookaside memory slot, in bytes
+
+void DatabaseOptions::LookasideSlotSize::set(int value)
+{
+	// SQLite rounds the slot size down to a multiple of 8 and ignores very small slots
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_lookasidesize = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::MmapSize::get
+//
+// Gets the memory-mapped I/O limit of each connection, in bytes
+
+int64_t DatabaseOptions::MmapSize::get(void)
+{
+	return m_mmapsize;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::MmapSize::set
+//
+// Sets the memory-mapped I/O limit of each connection, in bytes
+
+void DatabaseOptions::MmapSize::set(int64_t value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_mmapsize = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::PageSize::get
+//
+// Gets the page size used when a database is created, in bytes
+
+int DatabaseOptions::PageSize::get(void)
+{
+	return m_pagesize;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::PageSize::set
+//
+// Sets the page size used when a database is created, in bytes
+
+void DatabaseOptions::PageSize::set(int value)
+{
+	// The page size must be a power of two between 512 and 65536
+	if((value < 512) || (value > 65536) || ((value & (value - 1)) != 0)) throw gcnew ArgumentOutOfRangeException("value");
+	m_pagesize = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::ReadConnections::get
+//
+// Gets the maximum number of pooled read-only connections
+
+int DatabaseOptions::ReadConnections::get(void)
+{
+	return m_readconnections;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::ReadConnections::set
+//
+// Sets the maximum number of pooled read-only connections
+
+void DatabaseOptions::ReadConnections::set(int value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_readconnections = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::Synchronous::get
+//
+// Gets the synchronous mode of the writer connection
+
+SynchronousMode DatabaseOptions::Synchronous::get(void)
+{
+	return m_synchronous;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::Synchronous::set
+//
+// Sets the synchronous mode of the writer connection
+
+void DatabaseOptions::Synchronous::set(SynchronousMode value)
+{
+	if((value < SynchronousMode::Off) || (value > SynchronousMode::Extra)) throw gcnew ArgumentOutOfRangeException("value");
+	m_synchronous = value;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::WalAutoCheckpoint::get
+//
+// Gets the WAL automatic checkpoint threshold, in pages
+
+int DatabaseOptions::WalAutoCheckpoint::get(void)
+{
+	return m_walautocheckpoint;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseOptions::WalAutoCheckpoint::set
+//
+// Sets the WAL automatic checkpoint threshold, in pages; zero disables
+
+void DatabaseOptions::WalAutoCheckpoint::set(int value)
+{
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_walautocheckpoint = value;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
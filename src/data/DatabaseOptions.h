@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DATABASEOPTIONS_H_
+#define __DATABASEOPTIONS_H_
+#pragma once
+
+#include "SynchronousMode.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class DatabaseOptions
+//
+// Performance settings applied to the database connections
+//---------------------------------------------------------------------------
+
+public ref class DatabaseOptions
+{
+public:
+
+	// Instance Constructor
+	//
+	DatabaseOptions();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Clone
+	//
+	// Creates a copy of the options
+	DatabaseOptions^ Clone(void);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// BusyTimeout
+	//
+	// Gets/sets the busy timeout of each connection, in milliseconds
+	property int BusyTimeout
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// CacheSize
+	//
+	// Gets/sets the page cache size of each connection, in KiB
+	property int CacheSize
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// Compact (static)
+	//
+	// Gets options for a small memory footprint, suitable for metadata-only clients
+	static property DatabaseOptions^ Compact
+	{
+		DatabaseOptions^ get(void);
+	}
+
+	// Default (static)
+	//
+	// Gets the default options
+	static property DatabaseOptions^ Default
+	{
+		DatabaseOptions^ get(void);
+	}
+
+	// ImageCatalog (static)
+	//
+	// Gets options suited to heavy access of the card images
+	static property DatabaseOptions^ ImageCatalog
+	{
+		DatabaseOptions^ get(void);
+	}
+
+	// LookasideSlotCount
+	//
+	// Gets/sets the number of lookaside memory slots of each connection
+	property int LookasideSlotCount
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// LookasideSlotSize
+	//
+	// Gets/sets the size of each lookaside memory slot, in bytes
+	property int LookasideSlotSize
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// MmapSize
+	//
+	// Gets/sets the memory-mapped I/O limit of each connection, in bytes
+	property int64_t MmapSize
+	{
+		int64_t get(void);
+		void set(int64_t value);
+	}
+
+	// PageSize
+	//
+	// Gets/sets the page size used when a database is created, in bytes
+	property int PageSize
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// ReadConnections
+	//
+	// Gets/sets the maximum number of pooled read-only connections
+	property int ReadConnections
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// Synchronous
+	//
+	// Gets/sets the synchronous mode of the writer connection
+	property SynchronousMode Synchronous
+	{
+		SynchronousMode get(void);
+		void set(SynchronousMode value);
+	}
+
+	// WalAutoCheckpoint
+	//
+	// Gets/sets the WAL automatic checkpoint threshold, in pages
+	property int WalAutoCheckpoint
+	{
+		int get(void);
+		void set(int value);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int						m_busytimeout;			// Busy timeout
+	int						m_cachesize;			// Page cache size
+	int						m_lookasidecount;		// Lookaside slot count
+	int						m_lookasidesize;		// Lookaside slot size
+	int64_t					m_mmapsize;				// Memory-mapped I/O limit
+	int						m_pagesize;				// Database page size
+	int						m_readconnections;		// Pooled read connections
+	SynchronousMode			m_synchronous;			// Synchronous mode
+	int						m_walautocheckpoint;	// WAL checkpoint threshold
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __DATABASEOPTIONS_H_
@@ -0,0 +1,67 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DatabaseProgress.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// DatabaseProgress Constructor (internal)
+//
+// Arguments:
+//
+//	percentage	- Percentage of the operation that has completed
+//	cardid		- Identifier of the card being processed; can be nullptr
+
+DatabaseProgress::DatabaseProgress(int percentage, String^ cardid) : m_percentage(percentage), m_cardid(cardid)
+{
+	if((percentage < 0) || (percentage > 100)) throw gcnew ArgumentOutOfRangeException("percentage");
+}
+
+//---------------------------------------------------------------------------
+// DatabaseProgress::CardId::get
+//
+// Gets the identifier of the card being processed, if any
+
+String^ DatabaseProgress::CardId::get(void)
+{
+	return m_cardid;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseProgress::Percentage::get
+//
+// Gets the percentage of the operation that has completed
+
+int DatabaseProgress::Percentage::get(void)
+{
+	return m_percentage;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,83 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DATABASEPROGRESS_H_
+#define __DATABASEPROGRESS_H_
+#pragma once
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class DatabaseProgress
+//
+// Describes the progress of a long-running database operation
+//---------------------------------------------------------------------------
+
+public ref class DatabaseProgress sealed
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CardId
+	//
+	// Gets the identifier of the card being processed, if any
+	property String^ CardId
+	{
+		String^ get(void);
+	}
+
+	// Percentage
+	//
+	// Gets the percentage of the operation that has completed
+	property int Percentage
+	{
+		int get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	DatabaseProgress(int percentage, String^ cardid);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	int					m_percentage;		// Completed percentage
+	String^				m_cardid;			// Current card identifier
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __DATABASEPROGRESS_H_
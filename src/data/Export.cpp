@@ -24,6 +24,7 @@
 
 #include "Database.h"
 
+#include "Extensions.h"
 #include "SQLiteException.h"
 
 using namespace System::IO;
@@ -33,92 +34,113 @@ using namespace System::IO;
 namespace zuki::dbsfw::data {
 
 //---------------------------------------------------------------------------
-// export_card (local)
+// Class ExportTask (local)
 //
-// Exports the card tables
-//
-// Arguments:
-//
-//	handle		- Database instance handle
-//	path		- Path on which to export the table data
+// Binds the arguments of an asynchronous export operation
+//---------------------------------------------------------------------------
 
-static void export_card(SQLiteSafeHandle^ handle, String^ path)
+ref class ExportTask
 {
-	CLRASSERT(CLRISNOTNULL(handle));
-	CLRASSERT(CLRISNOTNULL(path));
+public:
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
-	auto sql = LR"(
-		select card.cardid, prettyjson(json_object(
-			'cardid', card.cardid, 
-			'type', card.type, 
-			'color', card.color, 
-			'rarity', card.rarity,
-			'detail',
-			(
-				with detail(cardid, json) as
-				(
-				select detail.cardid, json_object('side', detail.side, 'language', detail.language, 'name', detail.name, 'cost', detail.cost, 
-				  'specifiedcost', detail.specifiedcost, 'power', detail.power, 'combopower', detail.combopower, 'traits', detail.traits, 'effect', detail.effect) 
-				from carddetail as detail where detail.cardid = card.cardid
-				order by detail.language asc, detail.side desc
-				)
-				select case when detail.json is null then null else json_group_array(json(detail.json)) end from detail	
-			),
-			'faq',
-			(
-				with faq(cardid, json) as
-				(
-				select faq.cardid, json_object('faqid', faq.faqid, 'language', faq.language, 'question', faq.question, 'answer', faq.answer, 'related', 
-				  case when related.relatedcardid is null then null else json_group_array(related.relatedcardid) end)
-				from cardfaq as faq left outer join cardfaqrelated as related on faq.cardid = related.cardid and faq.faqid = related.faqid and faq.language = related.language
-				where faq.cardid = card.cardid
-				group by faq.cardid, faq.faqid, faq.language
-				order by faq.language asc, faq.faqid asc
-				)
-				select case when faq.json is null then null else json_group_array(json(faq.json)) end from faq
-			),
-			'image',
-			(
-				with image(cardid, json) as
-				(
-				select image.cardid, json_object('side', image.side, 'language', image.language, 'format', image.format, 'image', base64encode(image.image))
-				from cardimage as image where image.cardid = card.cardid
-				order by image.language asc, image.side desc
-				)
-				select case when image.json is null then null else json_group_array(json(image.json)) end from image
-			)
-		)) from card
-	)";
-
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Instance Constructor
+	//
+	ExportTask(Database^ database, String^ path, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation) :
+		m_database(database), m_path(path), m_progress(progress), m_cancellation(cancellation) {}
 
-	try {
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Invoke
+	//
+	// Invokes the export operation
+	void Invoke(void) { m_database->Export(m_path, m_progress, m_cancellation); }
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Database^							m_database;			// Database instance
+	String^								m_path;				// Export path
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+};
+
+//---------------------------------------------------------------------------
+// Class ExportProgress (local)
+//
+// Relays the progress of the native export operation
+//---------------------------------------------------------------------------
+
+ref class ExportProgress
+{
+public:
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+	// Instance Constructor
+	//
+	ExportProgress(IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation) : m_progress(progress), m_cancellation(cancellation) {}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
 
-			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
-			if(cardid != nullptr) {
+	// Report
+	//
+	// Reports the progress of the export operation; returns false to stop the export
+	bool Report(int64_t completed, int64_t total, char const* cardid)
+	{
+		if(m_cancellation.IsCancellationRequested) return false;
 
-				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
-			}
+		try {
 
-			result = sqlite3_step(statement);			// Move to the next result set row
+			if(CLRISNOTNULL(m_progress) && (total > 0))
+				m_progress->Report(gcnew DatabaseProgress(static_cast<int>((completed * 100) / total), 
+					(cardid == nullptr) ? nullptr : gcnew String(cardid, 0, static_cast<int>(strlen(cardid)), Text::Encoding::UTF8)));
 		}
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		// Exceptions cannot propagate through the native export, they are rethrown after it stops
+		catch(Exception^ ex) { m_exception = ex; return false; }
+
+		return true;
 	}
 
-	finally { sqlite3_finalize(statement); }
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// ReportException
+	//
+	// Gets the exception thrown by the progress reporter, if any
+	property Exception^ ReportException
+	{
+		Exception^ get(void) { return m_exception; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+	Exception^							m_exception;		// Progress reporter exception
+};
+
+//---------------------------------------------------------------------------
+// export_progress (local)
+//
+// Native progress callback for core::export_database
+//
+// Arguments:
+//
+//	context		- Pointer to the gcroot<ExportProgress^>
+//	completed	- Number of cards that have been exported
+//	total		- Total number of cards to be exported
+//	cardid		- Identifier of the card that was exported
+
+static bool export_progress(void* context, int64_t completed, int64_t total, char const* cardid)
+{
+	CLRASSERT(context != nullptr);
+	return (*reinterpret_cast<gcroot<ExportProgress^>*>(context))->Report(completed, total, cardid);
 }
 
 //---------------------------------------------------------------------------
@@ -154,6 +176,22 @@ static bool try_create_directory(String^ path)
 //	path		- Base path for the export operation
 
 void Database::Export(String^ path)
+{
+	Export(path, nullptr, CancellationToken::None);
+}
+
+//---------------------------------------------------------------------------
+// Database::Export (internal)
+//
+// Exports the database into flat files for storage
+//
+// Arguments:
+//
+//	path			- Base path for the export operation
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+void Database::Export(String^ path, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
 {
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
@@ -164,12 +202,51 @@ void Database::Export(String^ path)
 	path = Path::GetFullPath(path);
 	if(!try_create_directory(path)) throw gcnew Exception("Unable to create specified export directory");
 
-	// CARD
-	//
-	String^ cardpath = Path::Combine(path, "card");
-	if(!try_create_directory(cardpath)) throw gcnew Exception("Unable to create card export directory");
-	
-	export_card(m_handle, cardpath);
+	msclr::lock lock(m_writelock);
+
+	// Cancellation interrupts the query that is executing on the database handle
+	CancellationTokenRegistration registration = cancellation.Register(gcnew Action(m_handle, &SQLiteSafeHandle::Interrupt));
+
+	try {
+
+		SQLiteSafeHandle::Reference instance(m_handle);
+
+		// The export runs as native code, the progress reporter is only invoked once per card
+		gcroot<ExportProgress^> tracker(gcnew ExportProgress(progress, cancellation));
+		int result = core::export_database(instance, utf8_string(path).c_str(), export_progress, &tracker);
+
+		if(CLRISNOTNULL(tracker->ReportException)) throw tracker->ReportException;
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	catch(SQLiteException^) {
+
+		// An interrupted query fails with SQLITE_INTERRUPT, report that as a cancellation
+		cancellation.ThrowIfCancellationRequested();
+		throw;
+	}
+
+	finally { registration.Dispose(); }
+}
+
+//---------------------------------------------------------------------------
+// Database::ExportAsync
+//
+// Asynchronously exports the database into flat files for storage
+//
+// Arguments:
+//
+//	path			- Base path for the export operation
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Task^ Database::ExportAsync(String^ path, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+
+	return Task::Run(gcnew Action(gcnew ExportTask(this, path, progress, cancellation), &ExportTask::Invoke), cancellation);
 }
 
 //---------------------------------------------------------------------------
@@ -60,6 +60,26 @@ String^ Extensions::EnumDescription(T value)
 	return value->ToString();			// Default to a ToString()
 }
 
+//---------------------------------------------------------------------------
+// utf8_string
+//
+// Converts a String^ into a UTF-8 encoded std::string
+//
+// Arguments:
+//
+//	value	- String to be converted
+
+std::string utf8_string(String^ value)
+{
+	if(CLRISNULL(value)) throw gcnew ArgumentNullException("value");
+
+	array<byte>^ bytes = Text::Encoding::UTF8->GetBytes(value);
+	if(bytes->Length == 0) return std::string();
+
+	pin_ptr<byte> pinbytes = &bytes[0];
+	return std::string(reinterpret_cast<char const*>(pinbytes), bytes->Length);
+}
+
 //---------------------------------------------------------------------------
 
 }
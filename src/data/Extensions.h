@@ -24,6 +24,8 @@
 #define __EXTENSIONS_H_
 #pragma once
 
+#include <string>
+
 #pragma warning(push, 4)
 
 using namespace System;
@@ -53,6 +55,15 @@ public:
 	[ExtensionAttribute] static String^ EnumDescription(T value);
 };
 
+//---------------------------------------------------------------------------
+// Marshaling Helpers
+//---------------------------------------------------------------------------
+
+// utf8_string
+//
+// Converts a String^ into a UTF-8 encoded std::string
+std::string utf8_string(String^ value);
+
 //---------------------------------------------------------------------------
 
 }
@@ -22,356 +22,257 @@
 
 #include "stdafx.h"
 
+#include <vector>
+
 #include "Database.h"
 
+#include "Extensions.h"
 #include "SQLiteException.h"
 
 using namespace System::IO;
+using namespace System::Threading::Tasks;
 
 #pragma warning(push, 4)
 
 namespace zuki::dbsfw::data {
 
 //---------------------------------------------------------------------------
-// execute_non_query (local)
-//
-// Executes a database query and returns the number of rows affected
+// Class ImportProgress (local)
 //
-// Arguments:
-//
-//	handle		- Database instance handle
-//	sql			- SQL query to execute
+// Tracks and reports the progress of an import operation
+//---------------------------------------------------------------------------
 
-static int execute_non_query(SQLiteSafeHandle^ handle, wchar_t const* sql)
+ref class ImportProgress
 {
-	int changes = 0;
+public:
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
+	// Instance Constructor
+	//
+	ImportProgress(IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation, int steps) :
+		m_progress(progress), m_cancellation(cancellation), m_steps(Math::Max(steps, 1)) {}
 
-	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
-	if(sql == nullptr) throw gcnew ArgumentNullException("sql");
+	//-----------------------------------------------------------------------
+	// Member Functions
 
-	// Prepare the statement
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Step
+	//
+	// Completes a step of the import operation; throws if cancellation has been requested
+	void Step(String^ cardid)
+	{
+		m_cancellation.ThrowIfCancellationRequested();
 
-	try {
+		if(m_completed < m_steps) m_completed++;
+		if(CLRISNOTNULL(m_progress)) m_progress->Report(gcnew DatabaseProgress((m_completed * 100) / m_steps, cardid));
+	}
 
-		// Execute the query; ignore any rows that are returned
-		do result = sqlite3_step(statement);
-		while(result == SQLITE_ROW);
+	// TryStep
+	//
+	// Completes a step of the import operation; returns false if the step threw an exception
+	bool TryStep(String^ cardid)
+	{
+		// Exceptions cannot propagate through the native import, they are rethrown after it stops
+		try { Step(cardid); }
+		catch(Exception^ ex) { m_stepexception = ex; return false; }
+
+		return true;
+	}
 
-		// The final result from sqlite3_step should be SQLITE_DONE
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	//-----------------------------------------------------------------------
+	// Properties
 
-		// Record the number of changes made by the statement
-		changes = sqlite3_changes(instance);
+	// StepException
+	//
+	// Gets the exception thrown by TryStep, if any
+	property Exception^ StepException
+	{
+		Exception^ get(void) { return m_stepexception; }
 	}
 
-	finally { sqlite3_finalize(statement); }
+private:
 
-	return changes;
-}
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+	int									m_steps;			// Total number of steps
+	int									m_completed = 0;	// Completed number of steps
+	Exception^							m_stepexception;	// Exception thrown by TryStep
+};
 
 //---------------------------------------------------------------------------
-// import_card (local)
-//
-// Imports the card table 
-//
-// Arguments:
+// Class ImportTask (local)
 //
-//	handle		- Database instance handle
-//	path		- Path to the import files
+// Binds the arguments of an asynchronous import operation
+//---------------------------------------------------------------------------
 
-static void import_card(SQLiteSafeHandle^ handle, String^ path)
+ref class ImportTask
 {
-	CLRASSERT(CLRISNOTNULL(handle));
-	CLRASSERT(CLRISNOTNULL(path));
+public:
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
+	// Instance Constructor
+	//
+	ImportTask(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options, IProgress<DatabaseProgress^>^ progress, 
+		CancellationToken cancellation) : m_path(path), m_outputfile(outputfile), m_variantwidths(variantwidths), m_options(options), 
+		m_progress(progress), m_cancellation(cancellation) {}
 
-	// cardid | type | color | rarity
-	auto sql = L"with input(value) as (select ?1) "
-		"insert into card select json_extract(input.value, '$.cardid'), json_extract(input.value, '$.type'), "
-		"json_extract(input.value, '$.color'), json_extract(input.value, '$.rarity') from input";
+	//-----------------------------------------------------------------------
+	// Member Functions
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Invoke
+	//
+	// Invokes the import operation
+	Database^ Invoke(void) { return Database::Import(m_path, m_outputfile, m_variantwidths, m_options, m_progress, m_cancellation); }
 
-	try {
-
-		for each(String^ importfile in Directory::GetFiles(path)) {
+private:
 
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+	//-----------------------------------------------------------------------
+	// Member Variables
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	String^								m_path;				// Import path
+	String^								m_outputfile;		// Output database file
+	array<int>^							m_variantwidths;	// Image variant widths
+	DatabaseOptions^					m_options;			// Database options
+	IProgress<DatabaseProgress^>^		m_progress;			// Progress reporter
+	CancellationToken					m_cancellation;		// Cancellation token
+};
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+//---------------------------------------------------------------------------
+// import_progress (local)
+//
+// Native progress callback for core::import_database
+//
+// Arguments:
+//
+//	context		- Pointer to the gcroot<ImportProgress^>
+//	completed	- Number of import steps that have been completed
+//	total		- Total number of import steps
+//	cardid		- Identifier of the card that was imported, or null
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
+static bool import_progress(void* context, int64_t completed, int64_t total, char const* cardid)
+{
+	UNREFERENCED_PARAMETER(completed);
+	UNREFERENCED_PARAMETER(total);
 
-	finally { sqlite3_finalize(statement); }
+	CLRASSERT(context != nullptr);
+	return (*reinterpret_cast<gcroot<ImportProgress^>*>(context))->TryStep((cardid == nullptr) ? nullptr :
+		gcnew String(cardid, 0, static_cast<int>(strlen(cardid)), Text::Encoding::UTF8));
 }
 
 //---------------------------------------------------------------------------
-// import_carddetail (local)
+// import_database (local)
 //
-// Imports the carddetail table 
+// Imports the flat files in the import directory into the database
 //
 // Arguments:
 //
-//	handle		- Database instance handle
-//	path		- Path to the import files
+//	handle			- Database instance handle
+//	path			- Path to the import files created via Export()
+//	variantwidths	- Widths of the card image variants to generate
+//	progress		- Import progress tracker
 
-static void import_carddetail(SQLiteSafeHandle^ handle, String^ path)
+static void import_database(SQLiteSafeHandle^ handle, String^ path, array<int>^ variantwidths, ImportProgress^ progress)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
+	CLRASSERT(CLRISNOTNULL(variantwidths));
+	CLRASSERT(CLRISNOTNULL(progress));
 
 	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
 
-	// cardid | side | language | name | cost | specifiedcost | power | combopower | traits | effect
-	auto sql = L"with input(value) as (select ?1) "
-		"insert into carddetail select json_extract(input.value, '$.cardid'), "
-		"json_extract(detail.value, '$.side'), json_extract(detail.value, '$.language'), json_extract(detail.value, '$.name'), "
-		"json_extract(detail.value, '$.cost'), json_extract(detail.value, '$.specifiedcost'), json_extract(detail.value, '$.power'), "
-		"json_extract(detail.value, '$.combopower'), json_extract(detail.value, '$.traits'), json_extract(detail.value, '$.effect') "
-		"from input, json_each(input.value, '$.detail') as detail "
-		"where json_extract(input.value, '$.detail') is not null";
+	std::vector<int> widths(variantwidths->Length);
+	if(!widths.empty()) Marshal::Copy(variantwidths, 0, IntPtr(widths.data()), variantwidths->Length);
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// The files are read, bound and inserted and the variants encoded as native code within a
+	// single transaction; the progress tracker is only invoked once per file and derived step
+	char* errmsg = nullptr;
+	gcroot<ImportProgress^> tracker(progress);
+	int result = core::import_database(instance, utf8_string(path).c_str(), widths.data(), widths.size(), import_progress, &tracker, &errmsg);
 
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	if(result != SQLITE_OK) {
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		SQLiteException^ exception = gcnew SQLiteException(result, (errmsg) ? errmsg : sqlite3_errmsg(instance));
+		sqlite3_free(errmsg);
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
+		if(CLRISNOTNULL(progress->StepException)) throw progress->StepException;
+		throw exception;
 	}
-
-	finally { sqlite3_finalize(statement); }
 }
 
 //---------------------------------------------------------------------------
-// import_cardfaq (local)
+// VARIANT_WIDTHS
+//
+// Default set of image variant widths generated during import
+#define VARIANT_WIDTHS { 150, 300 }
+
+//---------------------------------------------------------------------------
+// try_create_directory (local)
 //
-// Imports the cardfaq table 
+// Attempts to create a directory if it does not exist
 //
 // Arguments:
 //
-//	handle		- Database instance handle
-//	path		- Path to the import files
+//	path		- Directory to be created
 
-static void import_cardfaq(SQLiteSafeHandle^ handle, String^ path)
+static bool try_create_directory(String^ path)
 {
-	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
-	// cardid | faqid | language | question | answer
-	auto sql = L"with input(value) as (select ?1) "
-		"insert into cardfaq select json_extract(input.value, '$.cardid'), "
-		"json_extract(faq.value, '$.faqid'), json_extract(faq.value, '$.language'), json_extract(faq.value, '$.question'), "
-		"json_extract(faq.value, '$.answer') "
-		"from input, json_each(input.value, '$.faq') as faq "
-		"where json_extract(input.value, '$.faq') is not null";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	if(!Directory::Exists(path)) {
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
+		try { Directory::CreateDirectory(path); }
+		catch(Exception^) { return false; }
 	}
 
-	finally { sqlite3_finalize(statement); }
+	return true;
 }
 
 //---------------------------------------------------------------------------
-// import_cardfaqrelated (local)
+// Database::Import (static)
 //
-// Imports the cardfaqrelated table 
+// Creates a new database instance via import
 //
 // Arguments:
 //
-//	handle		- Database instance handle
-//	path		- Path to the import files
+//	path		- Path to the import files created via Export()
+//	output		- Path to the output database file
 
-static void import_cardfaqrelated(SQLiteSafeHandle^ handle, String^ path)
+Database^ Database::Import(String^ path, String^ outputfile)
 {
-	CLRASSERT(CLRISNOTNULL(handle));
-	CLRASSERT(CLRISNOTNULL(path));
-
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
-	// cardid | faqid | language | relatedcardid
-	auto sql = L"with input(value) as (select ?1) "
-		"insert into cardfaqrelated select json_extract(input.value, '$.cardid'), "
-		"json_extract(faq.value, '$.faqid'), json_extract(faq.value, '$.language'), related.value "
-		"from input, json_each(input.value, '$.faq') as faq, json_each(faq.value, '$.related') as related "
-		"where json_extract(faq.value, '$.related') is not null";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	return Import(path, outputfile, gcnew array<int>VARIANT_WIDTHS, DatabaseOptions::Default);
 }
 
 //---------------------------------------------------------------------------
-// import_cardimage (local)
+// Database::Import (static)
 //
-// Imports the cardimage table 
+// Creates a new database instance via import
 //
 // Arguments:
 //
-//	handle		- Database instance handle
-//	path		- Path to the import files
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	variantwidths	- Widths of the card image variants to generate
 
-static void import_cardimage(SQLiteSafeHandle^ handle, String^ path)
+Database^ Database::Import(String^ path, String^ outputfile, array<int>^ variantwidths)
 {
-	CLRASSERT(CLRISNOTNULL(handle));
-	CLRASSERT(CLRISNOTNULL(path));
-
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
-	// cardid | side | language | format | image
-	auto sql = L"with input(value) as (select ?1) "
-		"insert into cardimage select json_extract(input.value, '$.cardid'), "
-		"json_extract(image.value, '$.side'), json_extract(image.value, '$.language'), json_extract(image.value, '$.format'), "
-		"base64decode(json_extract(image.value, '$.image')) "
-		"from input, json_each(input.value, '$.image') as image "
-		"where json_extract(input.value, '$.image') is not null";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	return Import(path, outputfile, variantwidths, DatabaseOptions::Default);
 }
 
 //---------------------------------------------------------------------------
-// try_create_directory (local)
+// Database::Import (static)
 //
-// Attempts to create a directory if it does not exist
+// Creates a new database instance via import
 //
 // Arguments:
 //
-//	path		- Directory to be created
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	options			- Database connection options
 
-static bool try_create_directory(String^ path)
+Database^ Database::Import(String^ path, String^ outputfile, DatabaseOptions^ options)
 {
-	CLRASSERT(CLRISNOTNULL(path));
-	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
-
-	if(!Directory::Exists(path)) {
-
-		try { Directory::CreateDirectory(path); }
-		catch(Exception^) { return false; }
-	}
-
-	return true;
+	return Import(path, outputfile, gcnew array<int>VARIANT_WIDTHS, options);
 }
 
 //---------------------------------------------------------------------------
@@ -381,15 +282,46 @@ static bool try_create_directory(String^ path)
 //
 // Arguments:
 //
-//	path		- Path to the import files created via Export()
-//	output		- Path to the output database file
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	variantwidths	- Widths of the card image variants to generate
+//	options			- Database connection options
 
-Database^ Database::Import(String^ path, String^ outputfile)
+Database^ Database::Import(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options)
+{
+	return Import(path, outputfile, variantwidths, options, nullptr, CancellationToken::None);
+}
+
+//---------------------------------------------------------------------------
+// Database::Import (internal, static)
+//
+// Creates a new database instance via import
+//
+// Arguments:
+//
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	variantwidths	- Widths of the card image variants to generate
+//	options			- Database connection options
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Database^ Database::Import(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options, 
+	IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
 {
 	sqlite3* instance = nullptr;			// SQLite instance handle
+	Database^ database = nullptr;			// Imported database instance
 
 	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
 	if(CLRISNULL(outputfile)) throw gcnew ArgumentNullException("outputfile");
+	if(CLRISNULL(variantwidths)) throw gcnew ArgumentNullException("variantwidths");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	// Order and deduplicate the variant widths, all widths must be positive
+	SortedSet<int>^ widths = gcnew SortedSet<int>(variantwidths);
+	if((widths->Count > 0) && (widths->Min <= 0)) throw gcnew ArgumentOutOfRangeException("variantwidths");
+	variantwidths = gcnew array<int>(widths->Count);
+	widths->CopyTo(variantwidths);
 
 	// Canonicalize the paths to prevent traversal
 	path = Path::GetFullPath(path);
@@ -420,43 +352,92 @@ Database^ Database::Import(String^ path, String^ outputfile)
 	CLRASSERT(instance == nullptr);
 
 	// Initialize the database instance
-	InitializeInstance(handle);
+	InitializeInstance(handle, options);
 
-	try {
+	// Cancellation interrupts any query that is executing on the database handle
+	CancellationTokenRegistration registration = cancellation.Register(gcnew Action(handle, &SQLiteSafeHandle::Interrupt));
 
-		// Begin a transaction to improve insert performance
-		execute_non_query(handle, L"begin immediate transaction");
+	try {
 
 		// CARD
 		//
 		String^ cardpath = Path::Combine(path, "card");
 		if(!Directory::Exists(cardpath)) throw gcnew Exception("Unable to access card import directory");
 
-		import_card(handle, cardpath);
-		import_carddetail(handle, cardpath);
-		import_cardfaq(handle, cardpath);
-		import_cardfaqrelated(handle, cardpath);
-		import_cardimage(handle, cardpath);
-		
-		// Commit the transaction
-		execute_non_query(handle, L"commit transaction");
+		// Each import file is processed once by each of the five file-based steps, followed by
+		// the four steps that derive data from the imported tables and the final vacuum
+		ImportProgress^ tracker = gcnew ImportProgress(progress, cancellation, (Directory::GetFiles(cardpath)->Length * 5) + 5);
+
+		import_database(handle, path, variantwidths, tracker);
 
-		// Create and Vacuum the database instance
-		Database^ database = gcnew Database(handle);
-		database->Vacuum();
+		// Create and Vacuum the database instance; Vacuum() registers its own interrupt
+		registration.Dispose();
+		database = gcnew Database(handle, options);
+		int64_t oldsize = 0;
+		database->Vacuum(oldsize, nullptr, cancellation);
+		tracker->Step(nullptr);
 
 		return database;
 	}
 
 	catch(Exception^) {
 		
-		// Roll back the transaction
-		execute_non_query(handle, L"rollback transaction");
+		// The import has already rolled back its transaction; delete the database
+		// instance or the safe handle
+		if(CLRISNOTNULL(database)) delete database;
+		else delete handle;
 
-		delete handle;				// Delete the safe handle
 		File::Delete(outputfile);	// Delete the invalid output file
+
+		// An interrupted query fails with SQLITE_INTERRUPT, report that as a cancellation
+		cancellation.ThrowIfCancellationRequested();
 		throw;
 	}
+
+	finally { registration.Dispose(); }
+}
+
+//---------------------------------------------------------------------------
+// Database::ImportAsync (static)
+//
+// Asynchronously creates a new database instance via import
+//
+// Arguments:
+//
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Task<Database^>^ Database::ImportAsync(String^ path, String^ outputfile, IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	return ImportAsync(path, outputfile, gcnew array<int>VARIANT_WIDTHS, DatabaseOptions::Default, progress, cancellation);
+}
+
+//---------------------------------------------------------------------------
+// Database::ImportAsync (static)
+//
+// Asynchronously creates a new database instance via import
+//
+// Arguments:
+//
+//	path			- Path to the import files created via Export()
+//	output			- Path to the output database file
+//	variantwidths	- Widths of the card image variants to generate
+//	options			- Database connection options
+//	progress		- Optional progress reporter
+//	cancellation	- Cancellation token
+
+Task<Database^>^ Database::ImportAsync(String^ path, String^ outputfile, array<int>^ variantwidths, DatabaseOptions^ options, 
+	IProgress<DatabaseProgress^>^ progress, CancellationToken cancellation)
+{
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(CLRISNULL(outputfile)) throw gcnew ArgumentNullException("outputfile");
+	if(CLRISNULL(variantwidths)) throw gcnew ArgumentNullException("variantwidths");
+	if(CLRISNULL(options)) throw gcnew ArgumentNullException("options");
+
+	ImportTask^ task = gcnew ImportTask(path, outputfile, variantwidths, options, progress, cancellation);
+	return Task::Run<Database^>(gcnew Func<Database^>(task, &ImportTask::Invoke), cancellation);
 }
 
 //---------------------------------------------------------------------------
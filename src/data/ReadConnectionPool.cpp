@@ -0,0 +1,245 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "ReadConnectionPool.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool Constructor
+//
+// Arguments:
+//
+//	path		- Path or URI of the database file (UTF-8)
+//	flags		- Flags to pass to sqlite3_open_v2 for each connection
+//	capacity	- Maximum number of read-only connections
+//	cachesize	- Prepared statement cache size of each connection
+//	initializer	- Optional initializer to invoke against each new connection
+
+ReadConnectionPool::ReadConnectionPool(char const* path, int flags, int capacity, size_t cachesize, Action<SQLiteSafeHandle^>^ initializer) :
+	m_flags(flags), m_capacity(capacity), m_cachesize(cachesize), m_initializer(initializer)
+{
+	if(path == nullptr) throw gcnew ArgumentNullException("path");
+	if(capacity <= 0) throw gcnew ArgumentOutOfRangeException("capacity");
+	if((flags & SQLITE_OPEN_READWRITE) == SQLITE_OPEN_READWRITE) throw gcnew ArgumentOutOfRangeException("flags");
+
+	// Keep a null-terminated copy of the UTF-8 path to open new connections with
+	int length = static_cast<int>(strlen(path)) + 1;
+	m_path = gcnew array<byte>(length);
+	Marshal::Copy(IntPtr(const_cast<char*>(path)), m_path, 0, length);
+
+	// Connections are opened on demand, the semaphore limits how many can exist
+	m_available = gcnew SemaphoreSlim(capacity, capacity);
+	m_connections = gcnew ConcurrentBag<Connection^>();
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool Destructor
+
+ReadConnectionPool::~ReadConnectionPool()
+{
+	Connection^ connection;
+
+	if(m_disposed) return;
+
+	// Close all of the idle connections; borrowed connections are closed when returned
+	m_disposed = true;
+	while(m_connections->TryTake(connection)) delete connection;
+
+	delete m_available;
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Borrow (private)
+//
+// Borrows a connection from the pool, opening a new one if necessary
+//
+// Arguments:
+//
+//	NONE
+
+ReadConnectionPool::Connection^ ReadConnectionPool::Borrow(void)
+{
+	Connection^ connection;
+	sqlite3* instance = nullptr;
+
+	CHECK_DISPOSED(m_disposed);
+
+	m_available->Wait();
+
+	try {
+
+		// Reuse an idle connection if one is available
+		if(m_connections->TryTake(connection)) return connection;
+
+		// Each connection is only ever used by one thread at a time, SQLite doesn't need to serialize
+		pin_ptr<byte> pinpath = &m_path[0];
+		int result = sqlite3_open_v2(reinterpret_cast<char const*>(pinpath), &instance, m_flags | SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+		if(result != SQLITE_OK) {
+
+			if(instance != nullptr) sqlite3_close(instance);
+			throw gcnew SQLiteException(result);
+		}
+
+		// Wait briefly rather than fail if the writer is recovering or checkpointing the WAL
+		sqlite3_busy_timeout(instance, 5000);
+
+		// Create the safe handle wrapper around the sqlite3*
+		SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
+		CLRASSERT(instance == nullptr);
+
+		// Delete the safe handle on an initialization or construction failure
+		try {
+
+			if(CLRISNOTNULL(m_initializer)) m_initializer(handle);
+			return gcnew Connection(handle, m_cachesize);
+		}
+
+		catch(Exception^) { delete handle; throw; }
+	}
+
+	catch(Exception^) { m_available->Release(); throw; }
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Resume
+//
+// Allows connections to be borrowed again after Suspend()
+//
+// Arguments:
+//
+//	NONE
+
+void ReadConnectionPool::Resume(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	m_available->Release(m_capacity);
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Return (private)
+//
+// Returns a borrowed connection to the pool
+//
+// Arguments:
+//
+//	connection	- Connection obtained from Borrow()
+
+void ReadConnectionPool::Return(Connection^ connection)
+{
+	CLRASSERT(CLRISNOTNULL(connection));
+
+	// The pool may have been disposed of while the connection was borrowed
+	if(m_disposed) { delete connection; return; }
+
+	m_connections->Add(connection);
+	m_available->Release();
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Suspend
+//
+// Waits for all borrowed connections to be returned and closes them; new
+// borrowers will block until Resume() is called
+//
+// Arguments:
+//
+//	NONE
+
+void ReadConnectionPool::Suspend(void)
+{
+	Connection^ connection;
+
+	CHECK_DISPOSED(m_disposed);
+
+	// Owning every slot of the semaphore guarantees that no connections are borrowed
+	for(int index = 0; index < m_capacity; index++) m_available->Wait();
+
+	// Close all of the connections, they will be reopened on demand after Resume()
+	while(m_connections->TryTake(connection)) delete connection;
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Connection Constructor
+//
+// Arguments:
+//
+//	handle		- SQLiteSafeHandle instance
+//	cachesize	- Prepared statement cache size
+
+ReadConnectionPool::Connection::Connection(SQLiteSafeHandle^ handle, size_t cachesize) : Handle(handle)
+{
+	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+
+	SQLiteSafeHandle::Reference instance(handle);
+	Statements = new StatementCache(instance, cachesize);
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Connection Destructor
+
+ReadConnectionPool::Connection::~Connection()
+{
+	this->!Connection();				// Release unmanaged resources
+	delete Handle;						// Release the safe handle
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Connection Finalizer
+
+ReadConnectionPool::Connection::!Connection()
+{
+	// The cached statements have to be finalized before the database is closed
+	delete Statements;
+	Statements = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Reference Constructor
+//
+// Arguments:
+//
+//	pool		- ReadConnectionPool instance
+
+ReadConnectionPool::Reference::Reference(ReadConnectionPool^ pool) : m_pool(pool), m_connection(pool->Borrow()), m_instance(m_connection->Handle)
+{
+}
+
+//---------------------------------------------------------------------------
+// ReadConnectionPool::Reference Destructor
+
+ReadConnectionPool::Reference::~Reference()
+{
+	m_pool->Return(m_connection);
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
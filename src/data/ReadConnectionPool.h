@@ -0,0 +1,167 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __READCONNECTIONPOOL_H_
+#define __READCONNECTIONPOOL_H_
+#pragma once
+
+#include "SQLiteSafeHandle.h"
+#include "StatementCache.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Concurrent;
+using namespace System::Threading;
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class ReadConnectionPool (internal)
+//
+// Pool of read-only database connections; each reader borrows a connection
+// and sees a consistent WAL snapshot for the duration of each statement
+//---------------------------------------------------------------------------
+
+ref class ReadConnectionPool
+{
+	// Class Connection
+	//
+	// Pooled read-only connection and its prepared statement cache
+	ref class Connection
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Connection(SQLiteSafeHandle^ handle, size_t cachesize);
+
+		// Destructor
+		//
+		~Connection();
+
+		// Finalizer
+		//
+		!Connection();
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		SQLiteSafeHandle^		Handle;					// Database safe handle
+		StatementCache*			Statements = nullptr;	// Prepared statement cache
+	};
+
+public:
+
+	// Instance Constructor
+	//
+	ReadConnectionPool(char const* path, int flags, int capacity, size_t cachesize, Action<SQLiteSafeHandle^>^ initializer);
+
+	// Destructor
+	//
+	~ReadConnectionPool();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Resume
+	//
+	// Allows connections to be borrowed again after Suspend()
+	void Resume(void);
+
+	// Suspend
+	//
+	// Waits for all borrowed connections to be returned and closes them
+	void Suspend(void);
+
+	// Class Reference
+	//
+	// Borrows a connection from the pool for the lifetime of the object
+	ref class Reference
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Reference(ReadConnectionPool^ pool);
+
+		// Destructor
+		//
+		~Reference();
+
+		// sqlite3* conversion operator
+		//
+		operator sqlite3*() { return m_instance; }
+
+		//-------------------------------------------------------------------
+		// Properties
+
+		// Statements
+		//
+		// Gets the prepared statement cache for the borrowed connection
+		property StatementCache* Statements
+		{
+			StatementCache* get(void) { return m_connection->Statements; }
+		}
+
+	private:
+
+		ReadConnectionPool^			m_pool;					// Owning connection pool
+		Connection^					m_connection;			// Borrowed connection
+		SQLiteSafeHandle::Reference	m_instance;				// Borrowed connection handle
+	};
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Borrow
+	//
+	// Borrows a connection from the pool, opening a new one if necessary
+	Connection^ Borrow(void);
+
+	// Return
+	//
+	// Returns a borrowed connection to the pool
+	void Return(Connection^ connection);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed = false;		// Object disposal flag
+	array<byte>^				m_path;					// Database file path (UTF-8)
+	int							m_flags;				// Database open flags
+	int							m_capacity;				// Maximum connection count
+	size_t						m_cachesize;			// Statement cache size
+	Action<SQLiteSafeHandle^>^	m_initializer;			// Connection initializer
+	SemaphoreSlim^				m_available;			// Available connection count
+	ConcurrentBag<Connection^>^	m_connections;			// Idle connections
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __READCONNECTIONPOOL_H_
@@ -84,6 +84,16 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// Interrupt
+	//
+	// Interrupts any pending operation on the database handle; this can be
+	// called from any thread, including a CancellationToken callback
+	void Interrupt(void)
+	{
+		try { Reference instance(this); sqlite3_interrupt(instance); }
+		catch(ObjectDisposedException^) { /* The handle has already been closed */ }
+	}
+
 	// ReleaseHandle (SafeHandle)
 	//
 	// Releases the contained unmanaged handle/resource
@@ -93,7 +103,7 @@ public:
 		// Cast the handle back into an unmanaged type pointer
 		sqlite3** unmanaged = reinterpret_cast<sqlite3**>(handle.ToPointer());
 
-		sqlite3_close(*unmanaged);		// Close the database handle
+		sqlite3_close_v2(*unmanaged);	// Close the database handle
 		delete unmanaged;				// Release the unmanaged heap pointer
 
 #ifdef _DEBUG
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "StatementCache.h"
+
+#include <assert.h>
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+// The statement cache is compiled as native code, it is on the path of every
+// cached query and never needs to interact with managed objects
+#pragma managed(push, off)
+
+//---------------------------------------------------------------------------
+// StatementCache Constructor
+//
+// Arguments:
+//
+//	instance	- Database instance on which to prepare statements
+//	capacity	- Maximum number of statements to hold in the cache
+
+StatementCache::StatementCache(sqlite3* instance, size_t capacity) : m_instance(instance), m_capacity(capacity)
+{
+	assert(instance != nullptr);
+}
+
+//---------------------------------------------------------------------------
+// StatementCache Destructor
+
+StatementCache::~StatementCache()
+{
+	Clear();
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Acquire
+//
+// Acquires a prepared statement from the cache, or prepares a new one
+//
+// Arguments:
+//
+//	sql			- SQL text of the statement
+//	statement	- On success, receives the prepared statement
+
+int StatementCache::Acquire(wchar_t const* sql, sqlite3_stmt** statement)
+{
+	assert(sql != nullptr);
+	assert(statement != nullptr);
+
+	*statement = nullptr;
+
+	AcquireSRWLockExclusive(&m_lock);
+
+	// Check the statement out of the cache on a hit, it's returned by Release()
+	auto found = m_index.find(sql);
+	if(found != m_index.end()) {
+
+		*statement = found->second->second;
+		m_lru.erase(found->second);
+		m_index.erase(found);
+		m_hits++;
+	}
+
+	else m_misses++;
+
+	ReleaseSRWLockExclusive(&m_lock);
+
+	// Statements prepared with sqlite3_prepare16_v2 are automatically recompiled
+	// on a schema change, so a cached statement never has to be invalidated here
+	if(*statement != nullptr) return SQLITE_OK;
+	return sqlite3_prepare16_v2(m_instance, sql, -1, statement, nullptr);
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Clear
+//
+// Finalizes all of the cached prepared statements
+//
+// Arguments:
+//
+//	NONE
+
+void StatementCache::Clear(void)
+{
+	lru_t lru;
+
+	AcquireSRWLockExclusive(&m_lock);
+
+	m_lru.swap(lru);
+	m_index.clear();
+
+	ReleaseSRWLockExclusive(&m_lock);
+
+	for(auto& entry : lru) sqlite3_finalize(entry.second);
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Hits
+//
+// Gets the number of statements that were acquired from the cache
+//
+// Arguments:
+//
+//	NONE
+
+uint64_t StatementCache::Hits(void) const
+{
+	AcquireSRWLockShared(&m_lock);
+	uint64_t hits = m_hits;
+	ReleaseSRWLockShared(&m_lock);
+
+	return hits;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Misses
+//
+// Gets the number of statements that had to be prepared
+//
+// Arguments:
+//
+//	NONE
+
+uint64_t StatementCache::Misses(void) const
+{
+	AcquireSRWLockShared(&m_lock);
+	uint64_t misses = m_misses;
+	ReleaseSRWLockShared(&m_lock);
+
+	return misses;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Release
+//
+// Resets a prepared statement and returns it to the cache
+//
+// Arguments:
+//
+//	sql			- SQL text of the statement
+//	statement	- Prepared statement returned from Acquire()
+
+void StatementCache::Release(wchar_t const* sql, sqlite3_stmt* statement)
+{
+	sqlite3_stmt* evicted = nullptr;
+
+	assert(sql != nullptr);
+	if(statement == nullptr) return;
+
+	// sqlite3_reset() returns the error from the most recent step; don't keep a
+	// statement that failed (SQLITE_SCHEMA, interrupted, etc.), just prepare it again
+	sqlite3_clear_bindings(statement);
+	if((m_capacity == 0) || (sqlite3_reset(statement) != SQLITE_OK)) { sqlite3_finalize(statement); return; }
+
+	AcquireSRWLockExclusive(&m_lock);
+
+	// If another copy of the statement has already been returned keep that one instead
+	if(m_index.find(sql) == m_index.end()) {
+
+		m_lru.emplace_front(sql, statement);
+		m_index.emplace(m_lru.front().first, m_lru.begin());
+		statement = nullptr;
+
+		// Evict the least recently used statement if the cache has exceeded capacity
+		if(m_lru.size() > m_capacity) {
+
+			evicted = m_lru.back().second;
+			m_index.erase(m_lru.back().first);
+			m_lru.pop_back();
+		}
+	}
+
+	ReleaseSRWLockExclusive(&m_lock);
+
+	// Finalize statements outside of the lock
+	if(statement != nullptr) sqlite3_finalize(statement);
+	if(evicted != nullptr) sqlite3_finalize(evicted);
+}
+
+#pragma managed(pop)
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,124 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2016 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __STATEMENTCACHE_H_
+#define __STATEMENTCACHE_H_
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data {
+
+//---------------------------------------------------------------------------
+// Class StatementCache (internal)
+//
+// Bounded least-recently-used cache of prepared statements keyed by the SQL
+// text of the statement.  Statements are checked out of the cache while in
+// use so that a statement is never shared between threads
+//---------------------------------------------------------------------------
+
+class StatementCache
+{
+public:
+
+	// Instance Constructor
+	//
+	StatementCache(sqlite3* instance, size_t capacity);
+
+	// Destructor
+	//
+	~StatementCache();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Acquire
+	//
+	// Acquires a prepared statement from the cache, or prepares a new one
+	int Acquire(wchar_t const* sql, sqlite3_stmt** statement);
+
+	// Clear
+	//
+	// Finalizes all of the cached prepared statements
+	void Clear(void);
+
+	// Hits
+	//
+	// Gets the number of statements that were acquired from the cache
+	uint64_t Hits(void) const;
+
+	// Misses
+	//
+	// Gets the number of statements that had to be prepared
+	uint64_t Misses(void) const;
+
+	// Release
+	//
+	// Resets a prepared statement and returns it to the cache
+	void Release(wchar_t const* sql, sqlite3_stmt* statement);
+
+private:
+
+	StatementCache(StatementCache const&) = delete;
+	StatementCache& operator=(StatementCache const&) = delete;
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// entry_t
+	//
+	// Cached SQL text and prepared statement pair
+	using entry_t = std::pair<std::wstring, sqlite3_stmt*>;
+
+	// lru_t
+	//
+	// List of cached entries, most recently used first
+	using lru_t = std::list<entry_t>;
+
+	// index_t
+	//
+	// Index of the cached entries by SQL text
+	using index_t = std::unordered_map<std::wstring, lru_t::iterator>;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	sqlite3* const			m_instance;				// Database instance
+	size_t const			m_capacity;				// Maximum cached statements
+	lru_t					m_lru;					// Cached statements
+	index_t					m_index;				// Cached statement index
+	uint64_t				m_hits = 0;				// Number of cache hits
+	uint64_t				m_misses = 0;			// Number of cache misses
+	mutable SRWLOCK			m_lock = SRWLOCK_INIT;	// Synchronization object
+};
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __STATEMENTCACHE_H_
@@ -0,0 +1,106 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARRAY_H_
+#define __CARRAY_H_
+#pragma once
+
+#include <vector>
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// CARRAY_POINTER_TYPE
+//
+// Pointer type used to bind a carray_text instance with sqlite3_bind_pointer
+#define CARRAY_POINTER_TYPE "carray_text"
+
+//---------------------------------------------------------------------------
+// Struct carray_text
+//
+// Array of UTF-16 strings bound to the carray table-valued function; the
+// strings are packed into a single buffer to limit the allocations
+//---------------------------------------------------------------------------
+
+struct carray_text {
+
+	// append
+	//
+	// Appends a string to the array
+	void append(wchar_t const* value, size_t length)
+	{
+		text.insert(text.end(), value, value + length);
+		offsets.push_back(text.size());
+	}
+
+	// data
+	//
+	// Gets a pointer to the string at the specified index; not null terminated
+	wchar_t const* data(size_t index) const
+	{
+		return (length(index) == 0) ? L"" : text.data() + begin(index);
+	}
+
+	// length
+	//
+	// Gets the length of the string at the specified index
+	size_t length(size_t index) const
+	{
+		return offsets[index] - begin(index);
+	}
+
+	// reserve
+	//
+	// Reserves space for the specified number of strings and characters
+	void reserve(size_t count, size_t characters)
+	{
+		offsets.reserve(count);
+		text.reserve(characters);
+	}
+
+	// size
+	//
+	// Gets the number of strings in the array
+	size_t size(void) const
+	{
+		return offsets.size();
+	}
+
+private:
+
+	// begin
+	//
+	// Gets the offset of the string at the specified index
+	size_t begin(size_t index) const
+	{
+		return (index == 0) ? 0 : offsets[index - 1];
+	}
+
+	std::vector<wchar_t>	text;			// Packed string data
+	std::vector<size_t>		offsets;		// End offset of each string
+};
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __CARRAY_H_
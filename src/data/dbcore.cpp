@@ -0,0 +1,949 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef DBCORE_NO_WEBP
+#include "webp/decode.h"
+#include "webp/encode.h"
+#endif
+
+#include "dbcore.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data::core {
+
+//---------------------------------------------------------------------------
+// statement_ptr_t (local)
+//
+// Prepared statement that is finalized when it goes out of scope
+struct statement_deleter_t { void operator()(sqlite3_stmt* statement) const { sqlite3_finalize(statement); } };
+using statement_ptr_t = std::unique_ptr<sqlite3_stmt, statement_deleter_t>;
+
+//---------------------------------------------------------------------------
+// execute_pragma (local)
+//
+// Sets a pragma to an integer value
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	name			- Name of the pragma
+//	value			- Value to set
+
+static int execute_pragma(sqlite3* instance, char const* name, int64_t value)
+{
+	// Pragma values cannot be bound as parameters, they have to be part of the SQL text
+	return execute_non_query(instance, (std::string("pragma ") + name + " = " + std::to_string(value)).c_str(), nullptr);
+}
+
+//---------------------------------------------------------------------------
+// prepare (local)
+//
+// Prepares a statement that is finalized when it goes out of scope
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to prepare
+//	statement		- On success, receives the prepared statement
+
+static int prepare(sqlite3* instance, char const* sql, statement_ptr_t& statement)
+{
+	sqlite3_stmt* prepared = nullptr;
+
+	int result = sqlite3_prepare_v2(instance, sql, -1, &prepared, nullptr);
+	statement.reset(prepared);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// read_file (local)
+//
+// Reads the entire contents of a text file, less any UTF-8 byte order mark
+//
+// Arguments:
+//
+//	path			- Path to the file
+//	text			- On success, receives the file contents
+
+static bool read_file(std::filesystem::path const& path, std::string& text)
+{
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	if(!stream) return false;
+
+	text.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	if(stream.bad()) return false;
+
+	if((text.size() >= 3) && (text.compare(0, 3, "\xEF\xBB\xBF") == 0)) text.erase(0, 3);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// write_file (local)
+//
+// Writes a text file, replacing any existing file
+//
+// Arguments:
+//
+//	path			- Path to the file
+//	text			- Text to write into the file
+//	length			- Length of the text in bytes
+
+static bool write_file(std::filesystem::path const& path, char const* text, size_t length)
+{
+	std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if(!stream) return false;
+
+	stream.write(text, static_cast<std::streamsize>(length));
+	stream.close();
+
+	return !stream.fail();
+}
+
+//---------------------------------------------------------------------------
+// apply_connection_options
+//
+// Applies the lookaside, busy timeout, cache and memory-mapping options to a connection
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	options			- Connection options to apply
+
+int apply_connection_options(sqlite3* instance, connection_options_t const* options)
+{
+	if((instance == nullptr) || (options == nullptr)) return SQLITE_MISUSE;
+
+	// Lookaside memory can only be reconfigured while none of it is in use, this has to come first
+	int result = sqlite3_db_config(instance, SQLITE_DBCONFIG_LOOKASIDE, nullptr, options->lookasidesize, options->lookasidecount);
+
+	// Set a busy timeout handler for this connection
+	if(result == SQLITE_OK) result = sqlite3_busy_timeout(instance, options->busytimeout);
+
+	// A negative cache_size is interpreted by SQLite as KiB rather than pages
+	if(result == SQLITE_OK) result = execute_pragma(instance, "cache_size", -static_cast<int64_t>(options->cachesize));
+	if(result == SQLITE_OK) result = execute_pragma(instance, "mmap_size", options->mmapsize);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// apply_writer_options
+//
+// Applies the page size, journal and durability options to the writer connection
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	options			- Connection options to apply
+
+int apply_writer_options(sqlite3* instance, connection_options_t const* options)
+{
+	if((instance == nullptr) || (options == nullptr)) return SQLITE_MISUSE;
+
+	// The page size only applies to a new database and must be set before the switch to
+	// write-ahead logging, after which it can no longer be changed (even by VACUUM)
+	int result = execute_pragma(instance, "page_size", options->pagesize);
+
+	// Free pages are kept for incremental_vacuum() to release; this applies immediately to a
+	// new database, an existing database is converted by its next vacuum()
+	if(result == SQLITE_OK) result = execute_non_query(instance, "pragma auto_vacuum=incremental", nullptr);
+
+	// Switch the database to write-ahead logging
+	if(result == SQLITE_OK) result = execute_non_query(instance, "pragma journal_mode=wal", nullptr);
+
+	// Set the durability and WAL checkpoint options
+	if(result == SQLITE_OK) result = execute_pragma(instance, "synchronous", options->synchronous);
+	if(result == SQLITE_OK) result = execute_pragma(instance, "wal_autocheckpoint", options->walautocheckpoint);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// database_size
+//
+// Gets the size of the main database in bytes
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	size			- On success, receives the size of the database
+
+int database_size(sqlite3* instance, int64_t* size)
+{
+	statement_ptr_t pagesize, pagecount;
+
+	if(size == nullptr) return SQLITE_MISUSE;
+
+	int result = prepare(instance, "pragma page_size", pagesize);
+	if(result == SQLITE_OK) result = prepare(instance, "pragma page_count", pagecount);
+	if(result != SQLITE_OK) return result;
+
+	if((result = sqlite3_step(pagesize.get())) != SQLITE_ROW) return result;
+	if((result = sqlite3_step(pagecount.get())) != SQLITE_ROW) return result;
+
+	*size = sqlite3_column_int64(pagecount.get(), 0) * sqlite3_column_int(pagesize.get(), 0);
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// execute_non_query
+//
+// Executes a query and ignores any rows that are returned
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	changes			- Optional; receives the number of rows affected
+
+int execute_non_query(sqlite3* instance, char const* sql, int* changes)
+{
+	statement_ptr_t statement;
+
+	int result = prepare(instance, sql, statement);
+	if(result != SQLITE_OK) return result;
+
+	// Execute the query; ignore any rows that are returned
+	do result = sqlite3_step(statement.get());
+	while(result == SQLITE_ROW);
+
+	// The final result from sqlite3_step should be SQLITE_DONE
+	if(result != SQLITE_DONE) return result;
+
+	if(changes != nullptr) *changes = sqlite3_changes(instance);
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// export_database
+//
+// Exports the database into flat files for storage
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	path			- Base path for the export operation
+//	progress		- Optional progress callback
+//	context			- Context pointer to pass to the progress callback
+
+int export_database(sqlite3* instance, char const* path, progress_callback progress, void* context)
+{
+	statement_ptr_t statement;
+	std::error_code error;
+	int64_t total = 0;
+	int64_t completed = 0;
+
+	if((instance == nullptr) || (path == nullptr)) return SQLITE_MISUSE;
+
+	try {
+
+		// CARD
+		//
+		std::filesystem::path cardpath = std::filesystem::u8path(path) / "card";
+		std::filesystem::create_directories(cardpath, error);
+		if(error) return SQLITE_CANTOPEN;
+
+		// Get the number of cards to be exported for progress reporting
+		int result = prepare(instance, "select count(*) from card", statement);
+		if(result != SQLITE_OK) return result;
+
+		result = sqlite3_step(statement.get());
+		if(result != SQLITE_ROW) return result;
+		total = sqlite3_column_int64(statement.get(), 0);
+
+		auto sql = R"(
+			select card.cardid, prettyjson(json_object(
+				'cardid', card.cardid, 
+				'type', cardtypename(card.type), 
+				'color', cardcolorname(card.color), 
+				'rarity', cardrarityname(card.rarity),
+				'detail',
+				(
+					with detail(cardid, json) as
+					(
+					select detail.cardid, json_object('side', cardsidename(detail.side), 'language', cardlanguagename(detail.language), 'name', detail.name, 'cost', detail.cost, 
+					  'specifiedcost', detail.specifiedcost, 'power', detail.power, 'combopower', detail.combopower, 'traits', detail.traits, 'effect', detail.effect) 
+					from carddetail as detail where detail.cardid = card.cardid
+					order by detail.language asc, detail.side asc
+					)
+					select case when detail.json is null then null else json_group_array(json(detail.json)) end from detail	
+				),
+				'faq',
+				(
+					with faq(cardid, json) as
+					(
+					select faq.cardid, json_object('faqid', faq.faqid, 'language', cardlanguagename(faq.language), 'question', faq.question, 'answer', faq.answer, 'related', 
+					  case when related.relatedcardid is null then null else json_group_array(related.relatedcardid) end)
+					from cardfaq as faq left outer join cardfaqrelated as related on faq.cardid = related.cardid and faq.faqid = related.faqid and faq.language = related.language
+					where faq.cardid = card.cardid
+					group by faq.cardid, faq.faqid, faq.language
+					order by faq.language asc, faq.faqid asc
+					)
+					select case when faq.json is null then null else json_group_array(json(faq.json)) end from faq
+				),
+				'image',
+				(
+					with image(cardid, json) as
+					(
+					select image.cardid, json_object('side', cardsidename(image.side), 'language', cardlanguagename(image.language), 'format', image.format, 'image', base64encode(image.image))
+					from cardimage as image where image.cardid = card.cardid
+					order by image.language asc, image.side asc
+					)
+					select case when image.json is null then null else json_group_array(json(image.json)) end from image
+				)
+			)) from card
+		)";
+
+		result = prepare(instance, sql, statement);
+		if(result != SQLITE_OK) return result;
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement.get());
+		while(result == SQLITE_ROW) {
+
+			// cardid
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement.get(), 0));
+			if(cardid != nullptr) {
+
+				// The JSON is written exactly as SQLite returns it, as UTF-8 without a byte order mark
+				char const* json = reinterpret_cast<char const*>(sqlite3_column_text(statement.get(), 1));
+				size_t length = static_cast<size_t>(sqlite3_column_bytes(statement.get(), 1));
+
+				if(!write_file(cardpath / std::filesystem::u8path(std::string(cardid) + ".json"), (json == nullptr) ? "" : json, length))
+					return SQLITE_IOERR_WRITE;
+			}
+
+			// Report the progress of the export operation
+			if((progress != nullptr) && !progress(context, ++completed, total, cardid)) return SQLITE_INTERRUPT;
+
+			result = sqlite3_step(statement.get());			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		return (result == SQLITE_DONE) ? SQLITE_OK : result;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+	catch(std::exception const&) { return SQLITE_ERROR; }
+}
+
+//---------------------------------------------------------------------------
+// import_state_t (local)
+//
+// Tracks the overall progress of an import operation across all of its steps
+struct import_state_t {
+
+	progress_callback		progress;		// Caller's progress callback
+	void*					context;		// Caller's progress context
+	int64_t					completed;		// Number of completed steps
+	int64_t					total;			// Total number of steps
+};
+
+//---------------------------------------------------------------------------
+// import_step (local)
+//
+// Completes a step of the import operation and reports it to the caller
+//
+// Arguments:
+//
+//	context			- Pointer to the import_state_t
+//	completed		- Unused; the files completed by the current import_files() step
+//	total			- Unused; the total files of the current import_files() step
+//	status			- Card identifier or null
+
+static bool import_step(void* context, int64_t /*completed*/, int64_t /*total*/, char const* status)
+{
+	import_state_t* state = reinterpret_cast<import_state_t*>(context);
+
+	if(state->completed < state->total) state->completed++;
+	return (state->progress == nullptr) || state->progress(state->context, state->completed, state->total, status);
+}
+
+#ifndef DBCORE_NO_WEBP
+
+//---------------------------------------------------------------------------
+// VARIANT_BATCH_SIZE
+//
+// Number of card images read into memory for each parallel variant batch
+#define VARIANT_BATCH_SIZE 64
+
+//---------------------------------------------------------------------------
+// VARIANT_QUALITY
+//
+// WebP lossy compression quality factor used to encode image variants
+#define VARIANT_QUALITY 80.0f
+
+//---------------------------------------------------------------------------
+// webp_ptr_t (local)
+//
+// Buffer allocated by libwebp that is released when it goes out of scope
+struct webp_deleter_t { void operator()(uint8_t* data) const { WebPFree(data); } };
+using webp_ptr_t = std::unique_ptr<uint8_t, webp_deleter_t>;
+
+//---------------------------------------------------------------------------
+// encode_variant (local)
+//
+// Decodes a WebP image scaled down to the specified width and encodes it as
+// a new WebP image; the aspect ratio of the source image is preserved
+//
+// Arguments:
+//
+//	data			- Source WebP image data
+//	length			- Length of the source WebP image data
+//	width			- Width of the image variant
+//	height			- On success, receives the height of the image variant
+//	output			- On success, receives the image variant
+
+static size_t encode_variant(uint8_t const* data, size_t length, int width, int* height, webp_ptr_t& output)
+{
+	int sourcewidth = 0;				// Width of the source image
+	int sourceheight = 0;				// Height of the source image
+
+	*height = 0;
+	output.reset();
+
+	// Variants are only generated if they are smaller than the source image
+	if(!WebPGetInfo(data, length, &sourcewidth, &sourceheight)) return 0;
+	if((width <= 0) || (width >= sourcewidth)) return 0;
+
+	int scaledheight = static_cast<int>(((static_cast<int64_t>(sourceheight) * width) + (sourcewidth / 2)) / sourcewidth);
+	if(scaledheight < 1) scaledheight = 1;
+
+	WebPDecoderConfig config;
+	if(!WebPInitDecoderConfig(&config)) return 0;
+
+	// Let the decoder perform the scaling, this avoids materializing the full-size image
+	config.options.use_scaling = 1;
+	config.options.scaled_width = width;
+	config.options.scaled_height = scaledheight;
+	config.output.colorspace = MODE_RGBA;
+
+	if(WebPDecode(data, length, &config) != VP8_STATUS_OK) return 0;
+
+	// The encoder drops the alpha channel when every pixel is opaque
+	uint8_t* encoded = nullptr;
+	size_t encodedlength = WebPEncodeRGBA(config.output.u.RGBA.rgba, width, scaledheight, config.output.u.RGBA.stride, VARIANT_QUALITY, &encoded);
+	WebPFreeDecBuffer(&config.output);
+
+	output.reset(encoded);
+	if(encodedlength > 0) *height = scaledheight;
+
+	return encodedlength;
+}
+
+//---------------------------------------------------------------------------
+// import_cardimagevariant (local)
+//
+// Generates the cardimagevariant table from the imported cardimage table
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	widths			- Widths of the variants to be generated
+//	numwidths		- Number of variant widths
+
+static int import_cardimagevariant(sqlite3* instance, int const* widths, size_t numwidths)
+{
+	// source_t
+	//
+	// Card image read from the cardimage table
+	struct source_t {
+
+		std::string				cardid;			// Card identifier
+		int						side;			// Card side
+		int						language;		// Card language
+		std::vector<uint8_t>	image;			// Source image
+	};
+
+	// variant_t
+	//
+	// Image variant encoded from a source_t
+	struct variant_t {
+
+		webp_ptr_t				image;			// Encoded variant
+		size_t					length;			// Length of the encoded variant
+		int						height;			// Height of the encoded variant
+	};
+
+	statement_ptr_t select, insert;
+
+	if(numwidths == 0) return SQLITE_OK;
+
+	// cardid | side | language | image
+	int result = prepare(instance, "select cardid, side, language, image from cardimage where format = 'image/webp'", select);
+
+	// cardid | side | language | width | height | format | image
+	if(result == SQLITE_OK) result = prepare(instance, "insert into cardimagevariant values(?1, ?2, ?3, ?4, ?5, 'image/webp', ?6)", insert);
+	if(result != SQLITE_OK) return result;
+
+	std::vector<source_t> batch;
+	std::vector<variant_t> variants(VARIANT_BATCH_SIZE * numwidths);
+	size_t const threads = std::max(std::thread::hardware_concurrency(), 1U);
+
+	// The source images are read and encoded in batches to bound memory usage; the
+	// inserts happen on this thread after each batch since the connection is shared
+	do {
+
+		batch.clear();
+		while(batch.size() < VARIANT_BATCH_SIZE) {
+
+			// The encoder isn't interruptible by SQLite, an interrupt is observed here between batches
+			result = sqlite3_step(select.get());
+			if(result == SQLITE_DONE) break;
+			if(result != SQLITE_ROW) return result;
+
+			uint8_t const* image = reinterpret_cast<uint8_t const*>(sqlite3_column_blob(select.get(), 3));
+			size_t length = static_cast<size_t>(sqlite3_column_bytes(select.get(), 3));
+
+			batch.push_back({ reinterpret_cast<char const*>(sqlite3_column_text(select.get(), 0)), sqlite3_column_int(select.get(), 1),
+				sqlite3_column_int(select.get(), 2), std::vector<uint8_t>(image, image + length) });
+		}
+
+		// Encode all of the variants for the batch in parallel
+		size_t const count = batch.size() * numwidths;
+		std::atomic<size_t> next(0);
+
+		auto encode = [&]() -> void {
+
+			for(size_t index = next++; index < count; index = next++) {
+
+				source_t const& source = batch[index / numwidths];
+				variant_t& variant = variants[index];
+
+				variant.length = (source.image.empty()) ? 0 :
+					encode_variant(source.image.data(), source.image.size(), widths[index % numwidths], &variant.height, variant.image);
+			}
+		};
+
+		std::vector<std::thread> workers;
+		for(size_t worker = 1; worker < std::min(threads, count); worker++) {
+
+			// Any variants not taken by a worker thread are encoded by this thread
+			try { workers.emplace_back(encode); }
+			catch(std::system_error const&) { break; }
+		}
+
+		encode();
+		for(auto& worker : workers) worker.join();
+
+		for(size_t index = 0; index < count; index++) {
+
+			// Skip variants that were not generated (source image is not wide enough)
+			variant_t& variant = variants[index];
+			if(variant.length == 0) continue;
+
+			source_t const& source = batch[index / numwidths];
+
+			// Bind the query parameter(s)
+			result = sqlite3_bind_text(insert.get(), 1, source.cardid.data(), static_cast<int>(source.cardid.size()), SQLITE_STATIC);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(insert.get(), 2, source.side);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(insert.get(), 3, source.language);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(insert.get(), 4, widths[index % numwidths]);
+			if(result == SQLITE_OK) result = sqlite3_bind_int(insert.get(), 5, variant.height);
+			if(result == SQLITE_OK) result = sqlite3_bind_blob(insert.get(), 6, variant.image.get(), static_cast<int>(variant.length), SQLITE_STATIC);
+			if(result != SQLITE_OK) return result;
+
+			// Execute the query; no rows are expected to be returned
+			result = sqlite3_step(insert.get());
+			if(result != SQLITE_DONE) return result;
+
+			// Reset the prepared statement so that it can be executed again
+			result = sqlite3_clear_bindings(insert.get());
+			if(result == SQLITE_OK) result = sqlite3_reset(insert.get());
+			if(result != SQLITE_OK) return result;
+
+			variant.image.reset();
+			variant.length = 0;
+		}
+
+	} while(batch.size() == VARIANT_BATCH_SIZE);
+
+	return SQLITE_OK;
+}
+
+#endif	// DBCORE_NO_WEBP
+
+//---------------------------------------------------------------------------
+// import_database
+//
+// Imports the flat files created by export_database into an empty database
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	path			- Base path for the import operation
+//	widths			- Widths of the card image variants to generate
+//	numwidths		- Number of card image variant widths
+//	progress		- Optional progress callback
+//	context			- Context pointer to pass to the progress callback
+//	errmsg			- Optional; on failure receives an error message that must
+//					  be released with sqlite3_free()
+
+int import_database(sqlite3* instance, char const* path, int const* widths, size_t numwidths, progress_callback progress, void* context, char** errmsg)
+{
+	std::error_code error;
+	int result = SQLITE_OK;
+
+	if(errmsg) *errmsg = nullptr;
+	if((instance == nullptr) || (path == nullptr) || ((widths == nullptr) && (numwidths > 0))) return SQLITE_MISUSE;
+	if(std::any_of(widths, widths + numwidths, [](int width) -> bool { return width <= 0; })) return SQLITE_MISUSE;
+
+	try {
+
+		// CARD
+		//
+		std::filesystem::path cardpath = std::filesystem::u8path(path) / "card";
+		std::string cardpathu8 = cardpath.u8string();
+
+		// Each import file is processed once by each of the five file-based steps, followed by
+		// the four steps that derive data from the imported tables
+		import_state_t state = { progress, context, 0, 4 };
+		for(std::filesystem::directory_iterator it(cardpath, error), end; !error && (it != end); it.increment(error))
+			if(it->is_regular_file(error)) state.total += 5;
+
+		if(error) {
+
+			if(errmsg) *errmsg = sqlite3_mprintf("unable to access card import directory %s", cardpathu8.c_str());
+			return SQLITE_CANTOPEN;
+		}
+
+		// Begin a transaction to improve insert performance
+		result = execute_non_query(instance, "begin immediate transaction", nullptr);
+		if(result != SQLITE_OK) return result;
+
+		// cardid | type | color | rarity
+		result = import_files(instance, cardpathu8.c_str(), "with input(value) as (select ?1) "
+			"insert into card select json_extract(input.value, '$.cardid'), cardtype(json_extract(input.value, '$.type')), "
+			"cardcolor(json_extract(input.value, '$.color')), cardrarity(json_extract(input.value, '$.rarity')) from input", 
+			import_step, &state);
+
+		// cardid | side | language | name | cost | specifiedcost | power | combopower | traits | effect
+		if(result == SQLITE_OK) result = import_files(instance, cardpathu8.c_str(), "with input(value) as (select ?1) "
+			"insert into carddetail select json_extract(input.value, '$.cardid'), "
+			"cardside(json_extract(detail.value, '$.side')), cardlanguage(json_extract(detail.value, '$.language')), json_extract(detail.value, '$.name'), "
+			"json_extract(detail.value, '$.cost'), json_extract(detail.value, '$.specifiedcost'), json_extract(detail.value, '$.power'), "
+			"json_extract(detail.value, '$.combopower'), json_extract(detail.value, '$.traits'), json_extract(detail.value, '$.effect') "
+			"from input, json_each(input.value, '$.detail') as detail "
+			"where json_extract(input.value, '$.detail') is not null", 
+			import_step, &state);
+
+		// cardid | side | language | keywordid
+		//
+		// The bracketed tags in the effect text are mapped onto canonical keywords through the
+		// per-language aliases; unrecognized tags are ignored
+		if(result == SQLITE_OK) result = execute_non_query(instance, "insert or ignore into carddetailkeyword "
+			"select detail.cardid, detail.side, detail.language, alias.keywordid "
+			"from carddetail as detail, effecttags(detail.effect) as tag "
+			"inner join keywordalias as alias on alias.language = detail.language and alias.alias = tag.tag "
+			"where detail.effect is not null", nullptr);
+		if((result == SQLITE_OK) && !import_step(&state, 0, 0, nullptr)) result = SQLITE_INTERRUPT;
+
+		// cardid | side | language | ordinal | trait
+		//
+		// The traits text is split on '/' with every segment retained, including empty ones, so that
+		// the rows can reproduce the original text exactly
+		if(result == SQLITE_OK) result = execute_non_query(instance, "with recursive split(cardid, side, language, ordinal, trait, remaining) as ("
+			"select cardid, side, language, -1, null, traits || '/' from carddetail where traits is not null "
+			"union all select cardid, side, language, ordinal + 1, substr(remaining, 1, instr(remaining, '/') - 1), "
+			"substr(remaining, instr(remaining, '/') + 1) from split where remaining <> '') "
+			"insert into carddetailtrait select cardid, side, language, ordinal, trait from split where ordinal >= 0", nullptr);
+		if((result == SQLITE_OK) && !import_step(&state, 0, 0, nullptr)) result = SQLITE_INTERRUPT;
+
+		// cardid | faqid | language | question | answer
+		if(result == SQLITE_OK) result = import_files(instance, cardpathu8.c_str(), "with input(value) as (select ?1) "
+			"insert into cardfaq select json_extract(input.value, '$.cardid'), "
+			"json_extract(faq.value, '$.faqid'), cardlanguage(json_extract(faq.value, '$.language')), json_extract(faq.value, '$.question'), "
+			"json_extract(faq.value, '$.answer') "
+			"from input, json_each(input.value, '$.faq') as faq "
+			"where json_extract(input.value, '$.faq') is not null", 
+			import_step, &state);
+
+		// cardid | faqid | language | relatedcardid
+		if(result == SQLITE_OK) result = import_files(instance, cardpathu8.c_str(), "with input(value) as (select ?1) "
+			"insert into cardfaqrelated select json_extract(input.value, '$.cardid'), "
+			"json_extract(faq.value, '$.faqid'), cardlanguage(json_extract(faq.value, '$.language')), related.value "
+			"from input, json_each(input.value, '$.faq') as faq, json_each(faq.value, '$.related') as related "
+			"where json_extract(faq.value, '$.related') is not null", 
+			import_step, &state);
+
+		// cardid | side | language | format | image
+		if(result == SQLITE_OK) result = import_files(instance, cardpathu8.c_str(), "with input(value) as (select ?1) "
+			"insert into cardimage(cardid, side, language, format, image) select json_extract(input.value, '$.cardid'), "
+			"cardside(json_extract(image.value, '$.side')), cardlanguage(json_extract(image.value, '$.language')), json_extract(image.value, '$.format'), "
+			"base64decode(json_extract(image.value, '$.image')) "
+			"from input, json_each(input.value, '$.image') as image "
+			"where json_extract(input.value, '$.image') is not null", 
+			import_step, &state);
+
+		// The perceptual hashes are left null when the core is built without libwebp
+		if(result == SQLITE_OK) result = execute_non_query(instance, "update cardimage set phash = webpphash(image) where format = 'image/webp'", nullptr);
+		if((result == SQLITE_OK) && !import_step(&state, 0, 0, nullptr)) result = SQLITE_INTERRUPT;
+
+		// cardid | side | language | width | height | format | image
+#ifndef DBCORE_NO_WEBP
+		if(result == SQLITE_OK) result = import_cardimagevariant(instance, widths, numwidths);
+#endif
+		if((result == SQLITE_OK) && !import_step(&state, 0, 0, nullptr)) result = SQLITE_INTERRUPT;
+
+		// Commit the transaction
+		if(result == SQLITE_OK) result = execute_non_query(instance, "commit transaction", nullptr);
+
+		if(result != SQLITE_OK) {
+
+			// The error message has to be captured before the rollback replaces it; an
+			// interrupted statement may have already rolled back the transaction
+			if(errmsg) *errmsg = sqlite3_mprintf("%s", (result == SQLITE_INTERRUPT) ? sqlite3_errstr(result) : sqlite3_errmsg(instance));
+			if(!sqlite3_get_autocommit(instance)) execute_non_query(instance, "rollback transaction", nullptr);
+		}
+
+		return result;
+	}
+
+	catch(std::bad_alloc const&) { result = SQLITE_NOMEM; }
+	catch(std::exception const&) { result = SQLITE_ERROR; }
+
+	if(!sqlite3_get_autocommit(instance)) execute_non_query(instance, "rollback transaction", nullptr);
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// import_files
+//
+// Executes a query once for each file in a directory with the file text bound to ?1
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	path			- Path to the import files
+//	sql				- SQL query to execute for each file
+//	progress		- Optional progress callback
+//	context			- Context pointer to pass to the progress callback
+
+int import_files(sqlite3* instance, char const* path, char const* sql, progress_callback progress, void* context)
+{
+	statement_ptr_t statement;
+	std::error_code error;
+	std::vector<std::filesystem::path> importfiles;
+	std::string json;
+
+	if((instance == nullptr) || (path == nullptr) || (sql == nullptr)) return SQLITE_MISUSE;
+
+	try {
+
+		// Collect and order the import files; the directory iteration order is unspecified
+		for(std::filesystem::directory_iterator it(std::filesystem::u8path(path), error), end; !error && (it != end); it.increment(error))
+			if(it->is_regular_file(error)) importfiles.push_back(it->path());
+
+		if(error) return SQLITE_CANTOPEN;
+		std::sort(importfiles.begin(), importfiles.end());
+
+		// Prepare the query
+		int result = prepare(instance, sql, statement);
+		if(result != SQLITE_OK) return result;
+
+		int64_t completed = 0;
+		for(auto const& importfile : importfiles) {
+
+			// Read the JSON from the input file
+			if(!read_file(importfile, json)) return SQLITE_IOERR_READ;
+
+			// Bind the query parameter(s)
+			result = sqlite3_bind_text(statement.get(), 1, json.data(), static_cast<int>(json.size()), SQLITE_STATIC);
+			if(result != SQLITE_OK) return result;
+
+			// Execute the query; no rows are expected to be returned
+			result = sqlite3_step(statement.get());
+			if(result != SQLITE_DONE) return result;
+
+			// Reset the prepared statement so that it can be executed again
+			result = sqlite3_clear_bindings(statement.get());
+			if(result == SQLITE_OK) result = sqlite3_reset(statement.get());
+			if(result != SQLITE_OK) return result;
+
+			// Report the progress of the import operation
+			if((progress != nullptr) && !progress(context, ++completed, static_cast<int64_t>(importfiles.size()), 
+				importfile.stem().u8string().c_str())) return SQLITE_INTERRUPT;
+		}
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+	catch(std::exception const&) { return SQLITE_ERROR; }
+}
+
+//---------------------------------------------------------------------------
+// incremental_vacuum
+//
+// Releases up to the specified number of free pages from the database
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	pages			- Maximum number of free pages to release
+
+int incremental_vacuum(sqlite3* instance, int pages)
+{
+	// SQLite releases the entire free list for a count of zero, which is what vacuum() is for
+	if(pages <= 0) return SQLITE_MISUSE;
+
+	// Pages are only moved, not rewritten, the full-text index rowids are unaffected
+	return execute_non_query(instance, ("pragma incremental_vacuum(" + std::to_string(pages) + ")").c_str(), nullptr);
+}
+
+//---------------------------------------------------------------------------
+// initialize
+//
+// Registers the portable extension functions with all new database connections
+//
+// Arguments:
+//
+//	NONE
+
+int initialize(void)
+{
+	return sqlite3_auto_extension(reinterpret_cast<void(*)()>(dbcore_extension_init));
+}
+
+//---------------------------------------------------------------------------
+// open_database
+//
+// Opens a database connection that reports extended result codes
+//
+// Arguments:
+//
+//	path			- UTF-8 path or URI of the database file
+//	flags			- Flags to pass to sqlite3_open_v2
+//	instance		- On success, receives the database instance
+
+int open_database(char const* path, int flags, sqlite3** instance)
+{
+	if((path == nullptr) || (instance == nullptr)) return SQLITE_MISUSE;
+
+	*instance = nullptr;
+
+	// Attempt to open the database on the specified path
+	sqlite3* opened = nullptr;
+	int result = sqlite3_open_v2(path, &opened, flags, nullptr);
+	if(result != SQLITE_OK) {
+
+		if(opened != nullptr) sqlite3_close(opened);
+		return result;
+	}
+
+	// Set the instance to report extended error codes
+	sqlite3_extended_result_codes(opened, 1);
+
+	*instance = opened;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// query
+//
+// Executes a query and passes each returned row to a callback
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	callback		- Callback to receive each row
+//	context			- Context pointer to pass to the callback
+
+int query(sqlite3* instance, char const* sql, row_callback callback, void* context)
+{
+	statement_ptr_t statement;
+
+	if(callback == nullptr) return SQLITE_MISUSE;
+
+	int result = prepare(instance, sql, statement);
+	if(result != SQLITE_OK) return result;
+
+	// A callback that stops the query early is not an error
+	result = sqlite3_step(statement.get());
+	while(result == SQLITE_ROW) {
+
+		if(!callback(context, statement.get())) return SQLITE_OK;
+		result = sqlite3_step(statement.get());
+	}
+
+	return (result == SQLITE_DONE) ? SQLITE_OK : result;
+}
+
+//---------------------------------------------------------------------------
+// rebuild_search_indexes
+//
+// Rebuilds the external content full-text indexes
+//
+// Arguments:
+//
+//	instance		- Database instance
+
+int rebuild_search_indexes(sqlite3* instance)
+{
+	// VACUUM is allowed to reassign the implicit rowids of the content tables, which the
+	// external content full-text indexes are keyed on; rebuild them to stay consistent
+	int result = execute_non_query(instance, "insert into carddetailsearch(carddetailsearch) values('rebuild')", nullptr);
+	if(result == SQLITE_OK) result = execute_non_query(instance, "insert into cardfaqsearch(cardfaqsearch) values('rebuild')", nullptr);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// vacuum
+//
+// Vacuums the main database and rebuilds the full-text indexes
+//
+// Arguments:
+//
+//	instance		- Database instance
+
+int vacuum(sqlite3* instance)
+{
+	int result = execute_non_query(instance, "vacuum", nullptr);
+
+	// The rowids may have been reassigned, see rebuild_search_indexes()
+	return (result == SQLITE_OK) ? rebuild_search_indexes(instance) : result;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
@@ -0,0 +1,234 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DBCORE_H_
+#define __DBCORE_H_
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sqlite3.h>
+
+#pragma warning(push, 4)
+
+// dbcoreextension.cpp
+//
+extern "C" int dbcore_extension_init(sqlite3* db, char** errmsg, const sqlite3_api_routines* api);
+
+//---------------------------------------------------------------------------
+// Portable database core
+//
+// The database operations that do not require the CLR; this code depends only
+// on SQLite, libwebp, the C++17 standard library and the host CSPRNG so that it
+// can be compiled for any host (libwebp is optional, see DBCORE_NO_WEBP).  All strings and
+// paths are UTF-8 and all functions return a SQLite result code, the message
+// for which is available from sqlite3_errmsg()
+//---------------------------------------------------------------------------
+
+namespace zuki::dbsfw::data::core {
+
+//---------------------------------------------------------------------------
+// Constants
+
+// schema_version
+//
+// Current database schema version, see upgrade_database()
+constexpr int schema_version = 10;
+
+//---------------------------------------------------------------------------
+// Type Declarations
+
+// connection_options_t
+//
+// Performance settings applied to a database connection, exposed to managed code
+// as DatabaseOptions
+struct connection_options_t {
+
+	int					busytimeout;		// Busy timeout, in milliseconds
+	int					cachesize;			// Page cache size, in KiB
+	int					lookasidecount;		// Number of lookaside memory slots
+	int					lookasidesize;		// Size of each lookaside memory slot, in bytes
+	int64_t				mmapsize;			// Memory-mapped I/O limit, in bytes
+	int					pagesize;			// Page size used when a database is created
+	int					synchronous;		// Synchronous mode of the writer connection
+	int					walautocheckpoint;	// WAL automatic checkpoint threshold, in pages
+};
+
+// filter_opcode
+//
+// Operation performed by a filter node
+enum filter_opcode : uint32_t {
+
+	filter_and = 0,				// Matches when all of the following operands match
+	filter_or,					// Matches when any of the following operands match
+	filter_not,					// Matches when the following operand does not match
+	filter_range,				// Matches when a column holds a value within a range
+	filter_in,					// Matches when a column holds any of a set of values
+};
+
+// filter_column_t
+//
+// Column of values evaluated by filter_select(); the values are padded out to a
+// whole number of 64-row words so that the comparisons never see a partial word
+struct filter_column_t {
+
+	int32_t const*		values;			// Value of each row
+	uint64_t const*		valid;			// Rows that are not NULL, or nullptr
+	uint64_t const*		bitmaps;		// Consecutive bitmaps of the rows holding each value, or nullptr
+	size_t				numbitmaps;		// Number of value bitmaps, starting with value 0
+};
+
+// filter_node_t
+//
+// Filter expression node; the nodes are stored in prefix order with the operands
+// of each and, or and not node immediately following it
+struct filter_node_t {
+
+	filter_opcode		opcode;			// Node operation
+	uint32_t			count;			// Operand or value count
+	uint32_t			column;			// Range and in column index
+	int32_t				minimum;		// Range minimum value
+	int32_t				maximum;		// Range maximum value
+	uint32_t			values;			// In value offset
+};
+
+// progress_callback
+//
+// Reports the progress of a long-running operation; return false to cancel
+using progress_callback = bool(*)(void* context, int64_t completed, int64_t total, char const* status);
+
+// row_callback
+//
+// Receives each row returned by a query; return false to stop the query
+using row_callback = bool(*)(void* context, sqlite3_stmt* statement);
+
+//---------------------------------------------------------------------------
+// Connection Option Presets
+
+// compact_options
+//
+// Small memory footprint, suitable for metadata-only clients: 512KiB page cache, no
+// lookaside memory and a small WAL
+constexpr connection_options_t compact_options = { 5000, 512, 0, 1200, 0, 4096, 1, 250 };
+
+// default_options
+//
+// SQLite defaults other than the 5 second busy timeout and synchronous=NORMAL
+constexpr connection_options_t default_options = { 5000, 2000, 100, 1200, 0, 4096, 1, 1000 };
+
+// imagecatalog_options
+//
+// Heavy access of the card images: 16KiB pages for fewer overflow pages per image,
+// a 64MiB page cache, up to 1GiB of the file mapped and fewer checkpoints during import
+constexpr connection_options_t imagecatalog_options = { 5000, 65536, 100, 1200, 1024LL * 1024 * 1024, 16384, 1, 4000 };
+
+//---------------------------------------------------------------------------
+// Functions
+
+// apply_connection_options
+//
+// Applies the lookaside, busy timeout, cache and memory-mapping options to a connection
+int apply_connection_options(sqlite3* instance, connection_options_t const* options);
+
+// apply_writer_options
+//
+// Applies the page size, journal and durability options to the writer connection
+int apply_writer_options(sqlite3* instance, connection_options_t const* options);
+
+// database_size
+//
+// Gets the size of the main database in bytes
+int database_size(sqlite3* instance, int64_t* size);
+
+// encode_cardlanguage
+//
+// Converts the text form of a CardLanguage into its integer value
+bool encode_cardlanguage(char const* text, int length, int* language);
+
+// execute_non_query
+//
+// Executes a query and ignores any rows that are returned
+int execute_non_query(sqlite3* instance, char const* sql, int* changes);
+
+// export_database
+//
+// Exports the database into flat files for storage
+int export_database(sqlite3* instance, char const* path, progress_callback progress, void* context);
+
+// filter_select (dbcorefilter.cpp)
+//
+// Evaluates a filter against a set of columns and sets the bit of each matching row
+int filter_select(filter_node_t const* nodes, size_t numnodes, int32_t const* values, size_t numvalues, filter_column_t const* columns,
+	size_t numcolumns, size_t rows, uint64_t* mask);
+
+// import_database
+//
+// Imports the flat files created by export_database into an empty database
+int import_database(sqlite3* instance, char const* path, int const* widths, size_t numwidths, progress_callback progress, void* context, char** errmsg);
+
+// import_files
+//
+// Executes a query once for each file in a directory with the file text bound to ?1
+int import_files(sqlite3* instance, char const* path, char const* sql, progress_callback progress, void* context);
+
+// incremental_vacuum
+//
+// Releases up to the specified number of free pages from the database
+int incremental_vacuum(sqlite3* instance, int pages);
+
+// initialize
+//
+// Registers the portable extension functions with all new database connections
+int initialize(void);
+
+// open_database
+//
+// Opens a database connection that reports extended result codes
+int open_database(char const* path, int flags, sqlite3** instance);
+
+// query
+//
+// Executes a query and passes each returned row to a callback
+int query(sqlite3* instance, char const* sql, row_callback callback, void* context);
+
+// rebuild_search_indexes
+//
+// Rebuilds the external content full-text indexes
+int rebuild_search_indexes(sqlite3* instance);
+
+// upgrade_database (dbcoreschema.cpp)
+//
+// Applies the schema migration steps required to bring the database up to schema_version
+int upgrade_database(sqlite3* instance, char** errmsg);
+
+// vacuum
+//
+// Vacuums the main database and rebuilds the full-text indexes
+int vacuum(sqlite3* instance);
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
+
+#endif	// __DBCORE_H_
@@ -0,0 +1,691 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dbcore.h"
+
+using namespace zuki::dbsfw::data;
+
+//---------------------------------------------------------------------------
+// FILTER_COLUMNS
+//
+// Number of columns in the synthetic catalog filtered by bench_filter()
+#define FILTER_COLUMNS 8
+
+//---------------------------------------------------------------------------
+// filter_column (local)
+//
+// Columns of the synthetic catalog, laid out the same as CatalogSnapshot
+enum filter_column : uint32_t {
+
+	column_type = 0,
+	column_color,
+	column_rarity,
+	column_side,
+	column_language,
+	column_cost,
+	column_power,
+	column_combopower,
+};
+
+//---------------------------------------------------------------------------
+// filter_query_t (local)
+//
+// Filter expression benchmarked by bench_filter()
+struct filter_query_t {
+
+	char const*							description;	// Description of the filter
+	std::vector<core::filter_node_t>	nodes;			// Filter nodes, in prefix order
+	std::vector<int32_t>				values;			// In node values
+};
+
+//---------------------------------------------------------------------------
+// filter_table_t (local)
+//
+// Synthetic columnar catalog; each column is padded out to a whole number of
+// 64-row words and NULL values are stored as zero, same as CatalogSnapshot
+struct filter_table_t {
+
+	size_t					rows = 0;						// Number of rows
+	std::vector<int32_t>	values[FILTER_COLUMNS];			// Value of each row
+	std::vector<uint8_t>	isnull[FILTER_COLUMNS];			// NULL flag of each row
+	std::vector<uint64_t>	valid[FILTER_COLUMNS];			// Rows that are not NULL (nullable columns)
+	std::vector<uint64_t>	bitmaps[FILTER_COLUMNS];		// Value bitmaps (enumeration columns)
+	size_t					numbitmaps[FILTER_COLUMNS] = {};	// Number of value bitmaps
+};
+
+//---------------------------------------------------------------------------
+// options_result_t (local)
+//
+// Measurements taken by bench_options()
+struct options_result_t {
+
+	double					insertrate;		// Inserted cards per second
+	double					readrate;		// Images read per second
+	double					scanrate;		// Metadata scans per second
+	int64_t					pagesize;		// Database page size
+	double					overflow;		// Overflow pages per image
+	int64_t					cacheused;		// Page cache memory in use after the reads
+};
+
+//---------------------------------------------------------------------------
+// newid_result_t (local)
+//
+// Measurements taken by bench_newid()
+struct newid_result_t {
+
+	double					rate;			// Inserted rows per second
+	int64_t					leafpages;		// Leaf pages in the UUID index
+	double					fill;			// Percentage of the leaf pages in use
+	double					distance;		// Mean distance between consecutive leaf pages
+	int64_t					unordered;		// Rows whose UUID does not sort after the previous row
+};
+
+//---------------------------------------------------------------------------
+// scalar_callback (local)
+//
+// Row callback that receives the first column of the first row as a double
+//
+// Arguments:
+//
+//	context		- Pointer to the double to receive the value
+//	statement	- Statement positioned on the current row
+
+static bool scalar_callback(void* context, sqlite3_stmt* statement)
+{
+	*reinterpret_cast<double*>(context) = sqlite3_column_double(statement, 0);
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// query_scalar (local)
+//
+// Executes a query that returns a single numeric value
+//
+// Arguments:
+//
+//	instance	- Database instance
+//	sql			- SQL query to execute
+//	value		- On success, receives the value
+
+static int query_scalar(sqlite3* instance, char const* sql, double* value)
+{
+	*value = 0.0;
+	return core::query(instance, sql, scalar_callback, value);
+}
+
+//---------------------------------------------------------------------------
+// build_filter_table (local)
+//
+// Generates a synthetic catalog with a fixed seed; the enumeration columns get value
+// bitmaps and the cost, power and combo power columns are NULL for some of the rows
+//
+// Arguments:
+//
+//	rows		- Number of rows to generate
+//	table		- Table to be generated
+
+static void build_filter_table(size_t rows, filter_table_t& table)
+{
+	// Exclusive upper limit and step of the values of each column, and how often it is NULL
+	static struct { int32_t limit; int32_t step; double nulls; bool enumeration; } const spec[FILTER_COLUMNS] = {
+
+		{ 3, 1, 0.0, true },			// type
+		{ 7, 1, 0.0, true },			// color
+		{ 7, 1, 0.0, true },			// rarity
+		{ 2, 1, 0.0, true },			// side
+		{ 2, 1, 0.0, true },			// language
+		{ 11, 1, 0.05, false },			// cost
+		{ 31, 1000, 0.40, false },		// power
+		{ 5, 5000, 0.70, false },		// combopower
+	};
+
+	std::mt19937 random(20250101);
+	size_t words = (rows + 63) / 64;
+
+	table.rows = rows;
+	for(size_t column = 0; column < FILTER_COLUMNS; column++) {
+
+		table.values[column].assign(words * 64, 0);
+		table.isnull[column].assign(rows, 0);
+		table.valid[column].clear();
+		table.bitmaps[column].clear();
+		table.numbitmaps[column] = 0;
+
+		std::uniform_int_distribution<int32_t> value(0, spec[column].limit - 1);
+		std::bernoulli_distribution isnull(spec[column].nulls);
+
+		for(size_t row = 0; row < rows; row++) {
+
+			if(isnull(random)) table.isnull[column][row] = 1;
+			else table.values[column][row] = value(random) * spec[column].step;
+		}
+
+		if(spec[column].enumeration) {
+
+			table.numbitmaps[column] = static_cast<size_t>(spec[column].limit);
+			table.bitmaps[column].assign(table.numbitmaps[column] * words, 0);
+			for(size_t row = 0; row < rows; row++)
+				table.bitmaps[column][(static_cast<size_t>(table.values[column][row]) * words) + (row / 64)] |= (1ULL << (row % 64));
+		}
+
+		else {
+
+			table.valid[column].assign(words, 0);
+			for(size_t row = 0; row < rows; row++)
+				if(!table.isnull[column][row]) table.valid[column][row / 64] |= (1ULL << (row % 64));
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// reference_filter (local)
+//
+// Brute-force evaluation of a filter node for a single row of the synthetic catalog
+//
+// Arguments:
+//
+//	table		- Synthetic catalog
+//	query		- Filter expression
+//	node		- Index of the node to evaluate; advanced past the node and its operands
+//	row			- Index of the row to evaluate
+
+static bool reference_filter(filter_table_t const& table, filter_query_t const& query, size_t& node, size_t row)
+{
+	core::filter_node_t const& current = query.nodes[node++];
+	bool matched = false;
+
+	switch(current.opcode) {
+
+		case core::filter_and:
+			matched = true;
+			for(uint32_t index = 0; index < current.count; index++) matched &= reference_filter(table, query, node, row);
+			break;
+
+		case core::filter_or:
+			for(uint32_t index = 0; index < current.count; index++) matched |= reference_filter(table, query, node, row);
+			break;
+
+		case core::filter_not:
+			matched = !reference_filter(table, query, node, row);
+			break;
+
+		case core::filter_range:
+			matched = !table.isnull[current.column][row] && (table.values[current.column][row] >= current.minimum) &&
+				(table.values[current.column][row] <= current.maximum);
+			break;
+
+		case core::filter_in:
+			for(uint32_t index = 0; index < current.count; index++)
+				matched |= !table.isnull[current.column][row] && (table.values[current.column][row] == query.values[current.values + index]);
+			break;
+	}
+
+	return matched;
+}
+
+//---------------------------------------------------------------------------
+// bench_filter (local)
+//
+// Measures the time taken by filter_select() to evaluate a filter expression and
+// compares the selected rows against a brute-force evaluation of each row
+//
+// Arguments:
+//
+//	table		- Synthetic catalog
+//	query		- Filter expression
+//	microseconds	- On success, receives the mean time of each evaluation
+//	reference	- On success, receives the time of the brute-force evaluation
+//	matched		- On success, receives the number of selected rows
+
+static int bench_filter(filter_table_t const& table, filter_query_t const& query, double* microseconds, double* reference, size_t* matched)
+{
+	core::filter_column_t columns[FILTER_COLUMNS];
+	for(size_t column = 0; column < FILTER_COLUMNS; column++) {
+
+		columns[column].values = table.values[column].data();
+		columns[column].valid = (table.valid[column].empty()) ? nullptr : table.valid[column].data();
+		columns[column].bitmaps = (table.bitmaps[column].empty()) ? nullptr : table.bitmaps[column].data();
+		columns[column].numbitmaps = table.numbitmaps[column];
+	}
+
+	std::vector<uint64_t> mask((table.rows + 63) / 64);
+	std::vector<uint64_t> expected(mask.size(), 0);
+
+	// The filter is evaluated repeatedly for at least a quarter of a second
+	int iterations = 0;
+	int result = SQLITE_OK;
+	std::chrono::duration<double> elapsed(0);
+	auto start = std::chrono::steady_clock::now();
+	while((result == SQLITE_OK) && ((iterations < 10) || (elapsed.count() < 0.25))) {
+
+		result = core::filter_select(query.nodes.data(), query.nodes.size(), query.values.data(), query.values.size(), columns,
+			FILTER_COLUMNS, table.rows, mask.data());
+
+		iterations++;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	if(result != SQLITE_OK) { fprintf(stderr, "dbcorebench: %s: %s (%d)\n", query.description, sqlite3_errstr(result), result); return result; }
+	*microseconds = (elapsed.count() * 1000000.0) / iterations;
+
+	start = std::chrono::steady_clock::now();
+	for(size_t row = 0; row < table.rows; row++) {
+
+		size_t node = 0;
+		if(query.nodes.empty() || reference_filter(table, query, node, row)) expected[row / 64] |= (1ULL << (row % 64));
+	}
+	elapsed = std::chrono::steady_clock::now() - start;
+	*reference = elapsed.count() * 1000000.0;
+
+	// Every word is compared, including the padding bits at the end of the final word
+	*matched = 0;
+	for(size_t word = 0; word < mask.size(); word++) {
+
+		if(mask[word] != expected[word]) {
+
+			fprintf(stderr, "dbcorebench: %s: rows %zu through %zu do not match the reference (%016llx != %016llx)\n", query.description,
+				word * 64, (word * 64) + 63, static_cast<unsigned long long>(mask[word]), static_cast<unsigned long long>(expected[word]));
+			return SQLITE_MISMATCH;
+		}
+
+		for(uint64_t bits = mask[word]; bits != 0; bits &= bits - 1) (*matched)++;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// bench_options (local)
+//
+// Creates a database of cards with image blobs using a set of connection options
+// and measures the insert rate, the image and metadata read rates and the layout
+//
+// Arguments:
+//
+//	path		- Path of the database file to create
+//	options		- Connection options to apply
+//	cards		- Number of cards to insert
+//	measured	- On success, receives the measurements
+
+static int bench_options(char const* path, core::connection_options_t const& options, int cards, options_result_t* measured)
+{
+	sqlite3* instance = nullptr;
+	sqlite3_stmt* statement = nullptr;
+	double value = 0.0;
+	char cardid[32];
+
+	remove(path);
+
+	// The options are applied the same way the managed Database applies them to its writer connection
+	int result = core::open_database(path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, &instance);
+	if(result == SQLITE_OK) result = core::apply_connection_options(instance, &options);
+	if(result == SQLITE_OK) result = core::apply_writer_options(instance, &options);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "create table card(cardid text not null, name text not null, "
+		"cost integer, primary key(cardid))", nullptr);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "create table cardimage(cardid text not null, image blob not null, "
+		"primary key(cardid))", nullptr);
+
+	// The images are incompressible and vary in size, roughly that of the stored WebP card images
+	std::mt19937 random(20250101);
+	std::uniform_int_distribution<int> imagesize(40 * 1024, 90 * 1024);
+	std::vector<uint8_t> image(90 * 1024);
+	for(auto& byte : image) byte = static_cast<uint8_t>(random());
+
+	auto start = std::chrono::steady_clock::now();
+	for(int card = 0; (result == SQLITE_OK) && (card < cards); card++) {
+
+		snprintf(cardid, sizeof(cardid), "BENCH-%05d", card);
+
+		if((card % 100) == 0) result = core::execute_non_query(instance, "begin immediate transaction", nullptr);
+		if(result == SQLITE_OK) result = sqlite3_prepare_v2(instance, "insert into card values(?1, ?2, ?3)", -1, &statement, nullptr);
+		if(result == SQLITE_OK) result = sqlite3_bind_text(statement, 1, cardid, -1, SQLITE_TRANSIENT);
+		if(result == SQLITE_OK) result = sqlite3_bind_text(statement, 2, cardid + 6, -1, SQLITE_TRANSIENT);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 3, card % 10);
+		if(result == SQLITE_OK) result = sqlite3_step(statement);
+		sqlite3_finalize(statement);
+		statement = nullptr;
+
+		if(result == SQLITE_DONE) result = sqlite3_prepare_v2(instance, "insert into cardimage values(?1, ?2)", -1, &statement, nullptr);
+		if(result == SQLITE_OK) result = sqlite3_bind_text(statement, 1, cardid, -1, SQLITE_TRANSIENT);
+		// Each image starts at a different offset into the random bytes so that no two are the same
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, image.data() + (card % 1024), imagesize(random) - 1024, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_step(statement);
+		sqlite3_finalize(statement);
+		statement = nullptr;
+
+		if((result == SQLITE_DONE) && (((card + 1) % 100 == 0) || (card + 1 == cards))) result = core::execute_non_query(instance, "commit transaction", nullptr);
+		else if(result == SQLITE_DONE) result = SQLITE_OK;
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	measured->insertrate = cards / elapsed.count();
+
+	// Each image is read in full, in a random order, twice over
+	std::uniform_int_distribution<int> randomcard(0, cards - 1);
+	if(result == SQLITE_OK) result = sqlite3_prepare_v2(instance, "select image from cardimage where cardid = ?1", -1, &statement, nullptr);
+
+	start = std::chrono::steady_clock::now();
+	for(int read = 0; (result == SQLITE_OK) && (read < cards * 2); read++) {
+
+		snprintf(cardid, sizeof(cardid), "BENCH-%05d", randomcard(random));
+
+		result = sqlite3_bind_text(statement, 1, cardid, -1, SQLITE_TRANSIENT);
+		if(result == SQLITE_OK) result = sqlite3_step(statement);
+		if(result == SQLITE_ROW) {
+
+			// Fetching the blob reads every one of its overflow pages
+			sqlite3_column_blob(statement, 0);
+			result = sqlite3_reset(statement);
+		}
+	}
+
+	elapsed = std::chrono::steady_clock::now() - start;
+	sqlite3_finalize(statement);
+	measured->readrate = (cards * 2) / elapsed.count();
+
+	// The metadata scans only touch the card table, not the images
+	start = std::chrono::steady_clock::now();
+	for(int scan = 0; (result == SQLITE_OK) && (scan < 100); scan++)
+		result = query_scalar(instance, "select count(*) from card where cost between 2 and 4", &value);
+
+	elapsed = std::chrono::steady_clock::now() - start;
+	measured->scanrate = 100 / elapsed.count();
+
+	int current = 0, highwater = 0;
+	if(result == SQLITE_OK) result = sqlite3_db_status(instance, SQLITE_DBSTATUS_CACHE_USED, &current, &highwater, 0);
+	measured->cacheused = current;
+
+	if(result == SQLITE_OK) result = query_scalar(instance, "pragma page_size", &value);
+	measured->pagesize = static_cast<int64_t>(value);
+	if(result == SQLITE_OK) result = query_scalar(instance, "select count(*) from dbstat where name = 'cardimage' and pagetype = 'overflow'", &value);
+	measured->overflow = value / cards;
+
+	if(result != SQLITE_OK) fprintf(stderr, "dbcorebench: %s (%d)\n", (instance) ? sqlite3_errmsg(instance) : sqlite3_errstr(result), result);
+
+	sqlite3_close(instance);
+	remove(path);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// bench_newid (local)
+//
+// Inserts rows keyed by a UUID generation function into a unique index and
+// measures the insert rate and the resulting layout of the index leaf pages
+//
+// Arguments:
+//
+//	path		- Path of the database file to create
+//	function	- UUID generation function, newid or newid7
+//	rows		- Number of rows to insert
+//	measured	- On success, receives the measurements
+
+static int bench_newid(char const* path, char const* function, int rows, newid_result_t* measured)
+{
+	sqlite3* instance = nullptr;
+	sqlite3_stmt* insert = nullptr;
+	double value = 0.0;
+
+	remove(path);
+
+	int result = core::open_database(path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, &instance);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "pragma journal_mode=wal", nullptr);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "pragma synchronous=normal", nullptr);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "create table bench(id blob not null, payload blob not null)", nullptr);
+	if(result == SQLITE_OK) result = core::execute_non_query(instance, "create unique index bench_id on bench(id)", nullptr);
+
+	std::string sql = std::string("insert into bench values(") + function + "(), zeroblob(32))";
+	if(result == SQLITE_OK) result = sqlite3_prepare_v2(instance, sql.c_str(), -1, &insert, nullptr);
+
+	// The rows are inserted in transactions of 1000 to approximate an application that
+	// inserts as it goes rather than in one bulk operation
+	auto start = std::chrono::steady_clock::now();
+	for(int row = 0; (result == SQLITE_OK) && (row < rows); row++) {
+
+		if((row % 1000) == 0) result = core::execute_non_query(instance, "begin immediate transaction", nullptr);
+		if(result == SQLITE_OK) result = sqlite3_step(insert);
+		if(result == SQLITE_DONE) result = sqlite3_reset(insert);
+		if((result == SQLITE_OK) && (((row + 1) % 1000 == 0) || (row + 1 == rows))) result = core::execute_non_query(instance, "commit transaction", nullptr);
+	}
+
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	sqlite3_finalize(insert);
+
+	measured->rate = rows / elapsed.count();
+
+	// dbstat returns the pages of a b-tree in key order; the further apart consecutive leaf
+	// pages are in the file, the more the index is scattered among the table pages
+	if(result == SQLITE_OK) result = query_scalar(instance, "select count(*) from dbstat where name = 'bench_id' and pagetype = 'leaf'", &value);
+	measured->leafpages = static_cast<int64_t>(value);
+	if(result == SQLITE_OK) result = query_scalar(instance, "select sum(pgsize - unused) * 100.0 / sum(pgsize) from dbstat "
+		"where name = 'bench_id' and pagetype = 'leaf'", &measured->fill);
+	if(result == SQLITE_OK) result = query_scalar(instance, "select coalesce(avg(abs(delta)), 0) from "
+		"(select pageno - lag(pageno) over (order by path) as delta from dbstat where name = 'bench_id' and pagetype = 'leaf') "
+		"where delta is not null", &measured->distance);
+
+	// The UUIDs of newid7() have to sort in the order they were generated
+	if(result == SQLITE_OK) result = query_scalar(instance, "select count(*) from (select id <= lag(id) over (order by rowid) as unordered "
+		"from bench) where unordered", &value);
+	measured->unordered = static_cast<int64_t>(value);
+
+	if(result != SQLITE_OK) fprintf(stderr, "dbcorebench: %s (%d)\n", (instance) ? sqlite3_errmsg(instance) : sqlite3_errstr(result), result);
+
+	sqlite3_close(instance);
+	remove(path);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// filter (local)
+//
+// Measures the latency of filter_select() over a synthetic catalog; fails if any
+// filter selects different rows than the brute-force reference
+//
+// Arguments:
+//
+//	rows		- Number of rows in the synthetic catalog
+
+static int filter(int rows)
+{
+	filter_table_t table;
+	build_filter_table(static_cast<size_t>(rows), table);
+
+	std::vector<filter_query_t> const queries = {
+
+		{ "(no filter)", {}, {} },
+		{ "type = 1 and rarity = 3", {
+			{ core::filter_and, 2 }, { core::filter_range, 0, column_type, 1, 1 }, { core::filter_range, 0, column_rarity, 3, 3 } }, {} },
+		{ "color in (1, 2) and cost between 2 and 4 and power >= 15000", {
+			{ core::filter_and, 3 }, { core::filter_in, 2, column_color, 0, 0, 0 }, { core::filter_range, 0, column_cost, 2, 4 },
+			{ core::filter_range, 0, column_power, 15000, INT32_MAX } }, { 1, 2 } },
+		{ "power between 5000 and 20000 or combopower >= 10000", {
+			{ core::filter_or, 2 }, { core::filter_range, 0, column_power, 5000, 20000 }, { core::filter_range, 0, column_combopower, 10000, INT32_MAX } }, {} },
+		{ "not cost between 0 and 3 and language = 0", {
+			{ core::filter_and, 2 }, { core::filter_not, 1 }, { core::filter_range, 0, column_cost, 0, 3 }, { core::filter_range, 0, column_language, 0, 0 } }, {} },
+		{ "rarity in (5, 6, 99) or (side = 1 and not color in (2, 3))", {
+			{ core::filter_or, 2 }, { core::filter_in, 3, column_rarity, 0, 0, 0 }, { core::filter_and, 2 }, { core::filter_range, 0, column_side, 1, 1 },
+			{ core::filter_not, 1 }, { core::filter_in, 2, column_color, 0, 0, 3 } }, { 5, 6, 99, 2, 3 } },
+		{ "cost = 0 and power = 0 and combopower = 0", {
+			{ core::filter_and, 3 }, { core::filter_range, 0, column_cost, 0, 0 }, { core::filter_range, 0, column_power, 0, 0 },
+			{ core::filter_range, 0, column_combopower, 0, 0 } }, {} },
+	};
+
+	printf("%-62s %10s %10s %12s %14s\n", "filter", "rows", "matched", "us/query", "reference us");
+
+	for(auto const& query : queries) {
+
+		double microseconds = 0.0, reference = 0.0;
+		size_t matched = 0;
+
+		if(bench_filter(table, query, &microseconds, &reference, &matched) != SQLITE_OK) return 1;
+		printf("%-62s %10d %10zu %12.1f %14.1f\n", query.description, rows, matched, microseconds, reference);
+	}
+
+	// A filter that does not describe exactly one complete expression has to be rejected
+	core::filter_node_t const truncated[] = { { core::filter_and, 2 }, { core::filter_range, 0, column_type, 1, 1 } };
+	uint64_t mask[1] = {};
+	if(core::filter_select(truncated, 2, nullptr, 0, nullptr, 0, 64, mask) != SQLITE_MISUSE) {
+
+		fprintf(stderr, "dbcorebench: a truncated filter was not rejected\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+// newid (local)
+//
+// Compares the insert rate and index layout of newid() and newid7() keys; fails
+// unless newid7() keys are ordered and keep the index leaf pages together
+//
+// Arguments:
+//
+//	rows		- Number of rows to insert for each function
+
+static int newid(int rows)
+{
+	newid_result_t random = {}, ordered = {};
+
+	if(bench_newid("newid.db", "newid", rows, &random) != SQLITE_OK) return 1;
+	if(bench_newid("newid7.db", "newid7", rows, &ordered) != SQLITE_OK) return 1;
+
+	printf("%-10s %10s %12s %12s %10s %14s\n", "function", "rows", "inserts/s", "leaf pages", "leaf fill", "leaf distance");
+	printf("%-10s %10d %12.0f %12lld %9.1f%% %14.1f\n", "newid()", rows, random.rate, static_cast<long long>(random.leafpages), random.fill, random.distance);
+	printf("%-10s %10d %12.0f %12lld %9.1f%% %14.1f\n", "newid7()", rows, ordered.rate, static_cast<long long>(ordered.leafpages), ordered.fill, ordered.distance);
+
+	if(ordered.unordered != 0) { fprintf(stderr, "dbcorebench: %lld newid7() values are out of order\n", static_cast<long long>(ordered.unordered)); return 1; }
+	if((ordered.distance * 4) >= random.distance) { fprintf(stderr, "dbcorebench: newid7() did not keep the index leaf pages together\n"); return 1; }
+
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+// options (local)
+//
+// Compares the connection option presets on a database of cards with images; fails
+// unless the compact preset uses less page cache and the image catalog preset stores
+// the images in fewer overflow pages than the default options
+//
+// Arguments:
+//
+//	cards		- Number of cards to insert for each preset
+
+static int options(int cards)
+{
+	options_result_t compact = {}, standard = {}, imagecatalog = {};
+
+	if(bench_options("compact.db", core::compact_options, cards, &compact) != SQLITE_OK) return 1;
+	if(bench_options("default.db", core::default_options, cards, &standard) != SQLITE_OK) return 1;
+	if(bench_options("imagecatalog.db", core::imagecatalog_options, cards, &imagecatalog) != SQLITE_OK) return 1;
+
+	printf("%-14s %8s %10s %10s %10s %10s %14s %12s\n", "preset", "cards", "inserts/s", "reads/s", "scans/s", "page size", "overflow/image", "cache KiB");
+	for(auto const& row : { std::make_pair("compact", &compact), std::make_pair("default", &standard), std::make_pair("imagecatalog", &imagecatalog) })
+		printf("%-14s %8d %10.0f %10.0f %10.0f %10lld %14.1f %12lld\n", row.first, cards, row.second->insertrate, row.second->readrate,
+			row.second->scanrate, static_cast<long long>(row.second->pagesize), row.second->overflow, static_cast<long long>(row.second->cacheused / 1024));
+
+	if(compact.cacheused >= standard.cacheused) { fprintf(stderr, "dbcorebench: the compact preset did not use less page cache\n"); return 1; }
+	if((imagecatalog.pagesize != core::imagecatalog_options.pagesize) || (imagecatalog.overflow * 2 >= standard.overflow)) {
+
+		fprintf(stderr, "dbcorebench: the image catalog preset did not reduce the overflow pages of each image\n");
+		return 1;
+	}
+
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+// usage (local)
+//
+// Writes the command line usage to stderr
+//
+// Arguments:
+//
+//	NONE
+
+static int usage(void)
+{
+	fprintf(stderr, "usage: dbcorebench filter <rows>\n");
+	fprintf(stderr, "       dbcorebench newid <rows>\n");
+	fprintf(stderr, "       dbcorebench options <cards>\n");
+	return 2;
+}
+
+//---------------------------------------------------------------------------
+// main
+//
+// Benchmarks for the portable database core
+//
+// Arguments:
+//
+//	argc		- Number of command line arguments
+//	argv		- Command line arguments
+
+int main(int argc, char** argv)
+{
+	if(argc < 2) return usage();
+
+	char const* command = argv[1];
+	if((strcmp(command, "filter") != 0) && (strcmp(command, "newid") != 0) && (strcmp(command, "options") != 0)) return usage();
+	else if(argc != 3) return usage();
+
+	int result = core::initialize();
+	if(result != SQLITE_OK) { fprintf(stderr, "dbcorebench: unable to initialize (%d)\n", result); return 1; }
+
+	if(strcmp(command, "filter") == 0) {
+
+		int rows = atoi(argv[2]);
+		if(rows <= 0) return usage();
+
+		return filter(rows);
+	}
+
+	else if(strcmp(command, "newid") == 0) {
+
+		int rows = atoi(argv[2]);
+		if(rows <= 0) return usage();
+
+		return newid(rows);
+	}
+
+	else if(strcmp(command, "options") == 0) {
+
+		int cards = atoi(argv[2]);
+		if(cards <= 0) return usage();
+
+		return options(cards);
+	}
+
+	return usage();
+}
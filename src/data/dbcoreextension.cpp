@@ -0,0 +1,1929 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Host cryptographically secure random number generator, see uuidstate_fill()
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <bcrypt.h>
+#elif defined(__linux__)
+#include <sys/random.h>
+#endif
+
+#ifndef DBCORE_NO_WEBP
+#include <emmintrin.h>
+#include "webp/decode.h"
+#endif
+
+#include "dbcore.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data::core {
+
+//---------------------------------------------------------------------------
+// utf8_decode (local)
+//
+// Decodes the next UTF-8 code point from the input text; invalid sequences
+// are consumed a single byte at a time and decode as U+FFFD
+//
+// Arguments:
+//
+//	pos			- Current input position; advanced past the code point
+//	end			- End of the input text
+
+static uint32_t utf8_decode(char const*& pos, char const* end)
+{
+	uint8_t const lead = static_cast<uint8_t>(*pos++);
+	if(lead < 0x80) return lead;
+
+	size_t		count;					// Number of continuation bytes
+	uint32_t	cp;						// Decoded code point
+
+	if((lead & 0xE0) == 0xC0) { count = 1; cp = lead & 0x1F; }
+	else if((lead & 0xF0) == 0xE0) { count = 2; cp = lead & 0x0F; }
+	else if((lead & 0xF8) == 0xF0) { count = 3; cp = lead & 0x07; }
+	else return 0xFFFD;
+
+	if(static_cast<size_t>(end - pos) < count) return 0xFFFD;
+
+	for(size_t index = 0; index < count; index++) {
+
+		uint8_t const next = static_cast<uint8_t>(pos[index]);
+		if((next & 0xC0) != 0x80) return 0xFFFD;
+		cp = (cp << 6) | (next & 0x3F);
+	}
+
+	pos += count;
+	return cp;
+}
+
+//---------------------------------------------------------------------------
+// utf8_encode (local)
+//
+// Encodes a code point into UTF-8 and returns the number of bytes written
+//
+// Arguments:
+//
+//	cp			- Code point to be encoded
+//	buffer		- Output buffer; must be at least 4 bytes in length
+
+static int utf8_encode(uint32_t cp, char* buffer)
+{
+	if(cp < 0x80) { buffer[0] = static_cast<char>(cp); return 1; }
+
+	if(cp < 0x800) {
+
+		buffer[0] = static_cast<char>(0xC0 | (cp >> 6));
+		buffer[1] = static_cast<char>(0x80 | (cp & 0x3F));
+		return 2;
+	}
+
+	if(cp < 0x10000) {
+
+		buffer[0] = static_cast<char>(0xE0 | (cp >> 12));
+		buffer[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+		buffer[2] = static_cast<char>(0x80 | (cp & 0x3F));
+		return 3;
+	}
+
+	buffer[0] = static_cast<char>(0xF0 | (cp >> 18));
+	buffer[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+	buffer[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+	buffer[3] = static_cast<char>(0x80 | (cp & 0x3F));
+	return 4;
+}
+
+//---------------------------------------------------------------------------
+// base64_alphabet (local)
+//
+// Base-64 encoding alphabet (RFC 4648)
+static char const base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//---------------------------------------------------------------------------
+// base64_value (local)
+//
+// Gets the value of a base-64 character, or -1 if it is not in the alphabet
+//
+// Arguments:
+//
+//	ch			- Character to be converted
+
+static int base64_value(char ch)
+{
+	if((ch >= 'A') && (ch <= 'Z')) return ch - 'A';
+	if((ch >= 'a') && (ch <= 'z')) return ch - 'a' + 26;
+	if((ch >= '0') && (ch <= '9')) return ch - '0' + 52;
+	if(ch == '+') return 62;
+	if(ch == '/') return 63;
+
+	return -1;
+}
+
+//---------------------------------------------------------------------------
+// base64decode (local)
+//
+// SQLite scalar function to convert a base-64 encoded string into a blob;
+// whitespace is ignored and the trailing padding is optional
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void base64decode(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	// Grab a pointer to the input string in UTF-8
+	char const* input = reinterpret_cast<char const*>(sqlite3_value_text(argv[0]));
+	if(input == nullptr) return sqlite3_result_null(context);
+	int length = sqlite3_value_bytes(argv[0]);
+
+	// The decoded data is never longer than three quarters of the input string
+	uint8_t* data = reinterpret_cast<uint8_t*>(sqlite3_malloc64(((static_cast<sqlite3_uint64>(length) / 4) + 1) * 3));
+	if(data == nullptr) return sqlite3_result_error(context, "unable to allocate memory", -1);
+
+	uint32_t accumulator = 0;			// Accumulated 6-bit groups
+	int bits = 0;						// Number of accumulated bits
+	int padding = 0;					// Number of padding characters
+	size_t cb = 0;						// Length of the decoded data
+
+	for(int index = 0; index < length; index++) {
+
+		char ch = input[index];
+		if((ch == ' ') || (ch == '\t') || (ch == '\r') || (ch == '\n')) continue;
+
+		// Nothing other than whitespace and more padding can follow padding
+		if(ch == '=') { padding++; continue; }
+
+		int value = base64_value(ch);
+		if((value < 0) || (padding > 0)) {
+
+			sqlite3_free(data);
+			return sqlite3_result_error(context, "failed to decode binary data from base-64", -1);
+		}
+
+		accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+		bits += 6;
+
+		if(bits >= 8) {
+
+			bits -= 8;
+			data[cb++] = static_cast<uint8_t>(accumulator >> bits);
+		}
+	}
+
+	// A single trailing character can't encode a whole byte
+	if((bits >= 6) || (padding > 2)) {
+
+		sqlite3_free(data);
+		return sqlite3_result_error(context, "failed to decode binary data from base-64", -1);
+	}
+
+	return sqlite3_result_blob64(context, data, cb, sqlite3_free);
+}
+
+//---------------------------------------------------------------------------
+// base64encode (local)
+//
+// SQLite scalar function to convert a blob column into a base-64 string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void base64encode(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	// Get the length of the data to be encoded
+	uint8_t const* data = reinterpret_cast<uint8_t const*>(sqlite3_value_blob(argv[0]));
+	size_t length = static_cast<size_t>(sqlite3_value_bytes(argv[0]));
+	if((data == nullptr) || (length == 0)) return sqlite3_result_null(context);
+
+	// Allocate the memory using sqlite3_malloc64; the string is padded to a multiple of four
+	size_t cch = ((length + 2) / 3) * 4;
+	char* str = reinterpret_cast<char*>(sqlite3_malloc64(cch));
+	if(str == nullptr) return sqlite3_result_error(context, "unable to allocate memory", -1);
+
+	char* pos = str;
+	for(size_t index = 0; index < length; index += 3) {
+
+		uint32_t group = static_cast<uint32_t>(data[index]) << 16;
+		if(index + 1 < length) group |= static_cast<uint32_t>(data[index + 1]) << 8;
+		if(index + 2 < length) group |= static_cast<uint32_t>(data[index + 2]);
+
+		*pos++ = base64_alphabet[(group >> 18) & 0x3F];
+		*pos++ = base64_alphabet[(group >> 12) & 0x3F];
+		*pos++ = (index + 1 < length) ? base64_alphabet[(group >> 6) & 0x3F] : '=';
+		*pos++ = (index + 2 < length) ? base64_alphabet[group & 0x3F] : '=';
+	}
+
+	return sqlite3_result_text64(context, str, cch, sqlite3_free, SQLITE_UTF8);
+}
+
+//---------------------------------------------------------------------------
+// enumname (local)
+//
+// Associates the text form of a card enumeration value with its integer
+// value; the integer values are what the database stores and must match the
+// CardColor, CardLanguage, CardRarity, CardSide and CardType enumerations
+
+struct enumname {
+
+	int					value;			// Integer enumeration value
+	char const*			name;			// Text form of the value
+	int					length;			// Length of the text form
+};
+
+#define ENUMNAME(__value, __name) { __value, __name, static_cast<int>(sizeof(__name) - 1) }
+
+// cardcolor_names
+//
+static enumname const cardcolor_names[] = {
+
+	ENUMNAME(1, "Red"),
+	ENUMNAME(2, "Blue"),
+	ENUMNAME(3, "Green"),
+	ENUMNAME(4, "Yellow"),
+	ENUMNAME(5, "Black"),
+	ENUMNAME(6, "ALL"),
+	ENUMNAME(7, "no-color"),
+};
+
+// cardlanguage_names
+//
+static enumname const cardlanguage_names[] = {
+
+	ENUMNAME(1, "EN"),
+	ENUMNAME(2, "JP"),
+};
+
+// cardrarity_names
+//
+static enumname const cardrarity_names[] = {
+
+	ENUMNAME(1, "L"),
+	ENUMNAME(2, "C"),
+	ENUMNAME(3, "UC"),
+	ENUMNAME(4, "R"),
+	ENUMNAME(5, "SR"),
+	ENUMNAME(6, "SCR"),
+	ENUMNAME(7, "PR"),
+};
+
+// cardside_names
+//
+static enumname const cardside_names[] = {
+
+	ENUMNAME(1, "FRONT"),
+	ENUMNAME(2, "BACK"),
+};
+
+// cardtype_names
+//
+static enumname const cardtype_names[] = {
+
+	ENUMNAME(1, "LEADER"),
+	ENUMNAME(2, "BATTLE"),
+	ENUMNAME(3, "EXTRA"),
+};
+
+//---------------------------------------------------------------------------
+// decode_enum (local)
+//
+// Converts an integer card enumeration value into its text form; None and
+// unrecognized values convert into null
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+//	names		- Enumeration value names
+
+template<size_t _count>
+static void decode_enum(sqlite3_context* context, int argc, sqlite3_value** argv, enumname const(&names)[_count])
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	if(sqlite3_value_type(argv[0]) == SQLITE_NULL) return sqlite3_result_null(context);
+
+	int value = sqlite3_value_int(argv[0]);
+	for(enumname const& name : names) {
+
+		if(name.value == value) return sqlite3_result_text(context, name.name, name.length, SQLITE_STATIC);
+	}
+
+	return sqlite3_result_null(context);
+}
+
+//---------------------------------------------------------------------------
+// encode_enum (local)
+//
+// Converts the text form of a card enumeration value into its integer value;
+// null and zero-length strings convert into None (zero)
+//
+// Arguments:
+//
+//	str			- UTF-8 text to be converted
+//	length		- Length of the text in bytes
+//	names		- Enumeration value names
+//	result		- On success, receives the integer enumeration value
+
+template<size_t _count>
+static bool encode_enum(char const* str, int length, enumname const(&names)[_count], int& result)
+{
+	result = 0;
+	if((str == nullptr) || (length == 0)) return true;
+
+	// The strings are case-sensitive; compare the lengths before the text
+	for(enumname const& name : names) {
+
+		if((name.length == length) && (memcmp(name.name, str, length) == 0)) { result = name.value; return true; }
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// encode_enum (local)
+//
+// Converts the text form of a card enumeration value into its integer value;
+// null and zero-length strings convert into None (zero)
+//
+// Arguments:
+//
+//	value		- SQLite value to be converted
+//	names		- Enumeration value names
+//	result		- On success, receives the integer enumeration value
+
+template<size_t _count>
+static bool encode_enum(sqlite3_value* value, enumname const(&names)[_count], int& result)
+{
+	char const* str = reinterpret_cast<char const*>(sqlite3_value_text(value));
+	return encode_enum(str, (str == nullptr) ? 0 : sqlite3_value_bytes(value), names, result);
+}
+
+//---------------------------------------------------------------------------
+// encode_enum (local)
+//
+// SQLite scalar function helper to convert the text form of a card enumeration
+// value into its integer value; unrecognized strings convert into null so that
+// they fail the NOT NULL constraints on the encoded columns
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+//	names		- Enumeration value names
+
+template<size_t _count>
+static void encode_enum(sqlite3_context* context, int argc, sqlite3_value** argv, enumname const(&names)[_count])
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	int value = 0;
+	if(encode_enum(argv[0], names, value)) return sqlite3_result_int(context, value);
+	
+	return sqlite3_result_null(context);
+}
+
+//---------------------------------------------------------------------------
+// cardcolor (local)
+//
+// SQLite scalar function to convert a card color string into a CardColor
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardcolor(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return encode_enum(context, argc, argv, cardcolor_names);
+}
+
+//---------------------------------------------------------------------------
+// cardcolorname (local)
+//
+// SQLite scalar function to convert a CardColor into a card color string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardcolorname(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return decode_enum(context, argc, argv, cardcolor_names);
+}
+
+//---------------------------------------------------------------------------
+// cardlanguage (local)
+//
+// SQLite scalar function to convert a card language string into a CardLanguage
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardlanguage(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return encode_enum(context, argc, argv, cardlanguage_names);
+}
+
+//---------------------------------------------------------------------------
+// cardlanguagename (local)
+//
+// SQLite scalar function to convert a CardLanguage into a card language string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardlanguagename(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return decode_enum(context, argc, argv, cardlanguage_names);
+}
+
+//---------------------------------------------------------------------------
+// cardrarity (local)
+//
+// SQLite scalar function to convert a card rarity string into a CardRarity
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardrarity(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return encode_enum(context, argc, argv, cardrarity_names);
+}
+
+//---------------------------------------------------------------------------
+// cardrarityname (local)
+//
+// SQLite scalar function to convert a CardRarity into a card rarity string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardrarityname(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return decode_enum(context, argc, argv, cardrarity_names);
+}
+
+//---------------------------------------------------------------------------
+// cardside (local)
+//
+// SQLite scalar function to convert a card side string into a CardSide
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardside(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return encode_enum(context, argc, argv, cardside_names);
+}
+
+//---------------------------------------------------------------------------
+// cardsidename (local)
+//
+// SQLite scalar function to convert a CardSide into a card side string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardsidename(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return decode_enum(context, argc, argv, cardside_names);
+}
+
+//---------------------------------------------------------------------------
+// cardtype (local)
+//
+// SQLite scalar function to convert a card type string into a CardType
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardtype(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	// Null, zero-length and invalid input strings all result in CardType::None;
+	// the CHECK CONSTRAINT on card.type rejects None
+	int value = 0;
+	if(!encode_enum(argv[0], cardtype_names, value)) value = 0;
+
+	return sqlite3_result_int(context, value);
+}
+
+//---------------------------------------------------------------------------
+// cardtypename (local)
+//
+// SQLite scalar function to convert a CardType into a card type string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardtypename(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	return decode_enum(context, argc, argv, cardtype_names);
+}
+
+//---------------------------------------------------------------------------
+// cjk tokenizer
+//
+// FTS5 tokenizer for mixed English and Japanese card text. Runs of ASCII
+// alphanumerics and other letters are emitted as case-folded words. Runs of
+// kana and ideographs aren't separated by spaces and are instead indexed as
+// overlapping bigrams, with each character colocated as a unigram so that a
+// single character term can still match. Queries only generate the bigrams
+// (or a unigram for a single character run), which match as a phrase against
+// the consecutive bigrams in the document.
+//
+// Before segmentation fullwidth ASCII is folded into ASCII, halfwidth katakana
+// into fullwidth (combining a following voiced sound mark) and katakana into
+// hiragana, so that the katakana, halfwidth katakana and hiragana spellings
+// of a word are all equivalent
+//
+// create virtual table ... using fts5(..., tokenize='cjk')
+
+// cjk_class
+//
+// Character classes used to segment the input text
+enum class cjk_class {
+
+	separator,			// Whitespace, punctuation and symbols
+	word,				// Alphanumerics and letters of space-delimited scripts
+	ideograph,			// Kana and ideographs
+};
+
+// cjk_halfwidth
+//
+// Fullwidth equivalents of the Halfwidth Katakana block (U+FF61 - U+FF9F)
+static uint16_t const cjk_halfwidth[] = {
+
+	0x3002, 0x300C, 0x300D, 0x3001, 0x30FB, 0x30F2, 0x30A1, 0x30A3,
+	0x30A5, 0x30A7, 0x30A9, 0x30E3, 0x30E5, 0x30E7, 0x30C3, 0x30FC,
+	0x30A2, 0x30A4, 0x30A6, 0x30A8, 0x30AA, 0x30AB, 0x30AD, 0x30AF,
+	0x30B1, 0x30B3, 0x30B5, 0x30B7, 0x30B9, 0x30BB, 0x30BD, 0x30BF,
+	0x30C1, 0x30C4, 0x30C6, 0x30C8, 0x30CA, 0x30CB, 0x30CC, 0x30CD,
+	0x30CE, 0x30CF, 0x30D2, 0x30D5, 0x30D8, 0x30DB, 0x30DE, 0x30DF,
+	0x30E0, 0x30E1, 0x30E2, 0x30E4, 0x30E6, 0x30E8, 0x30E9, 0x30EA,
+	0x30EB, 0x30EC, 0x30ED, 0x30EF, 0x30F3, 0x3099, 0x309A,
+};
+
+// cjk_tokenizer
+//
+// State for an instance of the cjk tokenizer
+struct cjk_tokenizer {
+
+	std::string			word;			// Buffer for folded word tokens
+};
+
+//---------------------------------------------------------------------------
+// cjk_classify (local)
+//
+// Classifies a folded code point for segmentation
+//
+// Arguments:
+//
+//	cp			- Folded code point to be classified
+
+static cjk_class cjk_classify(uint32_t cp)
+{
+	if(cp < 0x80) return (((cp >= '0') && (cp <= '9')) || ((cp >= 'a') && (cp <= 'z'))) ? cjk_class::word : cjk_class::separator;
+
+	if(cp < 0xC0) return cjk_class::separator;								// Latin-1 punctuation and symbols
+	if((cp == 0xD7) || (cp == 0xF7)) return cjk_class::separator;			// Multiplication and division signs
+	if(cp < 0x2000) return cjk_class::word;									// Latin, Greek, Cyrillic, ...
+	if(cp < 0x2C00) return cjk_class::separator;							// Punctuation, arrows, shapes, dingbats
+	if((cp >= 0x2E00) && (cp < 0x2E80)) return cjk_class::separator;		// Supplemental Punctuation
+	if((cp >= 0x2E80) && (cp < 0x3000)) return cjk_class::ideograph;		// CJK and Kangxi radicals
+
+	// CJK Symbols and Punctuation; U+3005 - U+3007 are treated as ideographs
+	if((cp >= 0x3000) && (cp < 0x3040)) return ((cp >= 0x3005) && (cp <= 0x3007)) ? cjk_class::ideograph : cjk_class::separator;
+
+	// Hiragana and Katakana; sound marks, U+30A0 and U+30FB are punctuation
+	if((cp >= 0x3040) && (cp < 0x3100))
+		return (((cp >= 0x3099) && (cp <= 0x309C)) || (cp == 0x30A0) || (cp == 0x30FB)) ? cjk_class::separator : cjk_class::ideograph;
+
+	if((cp >= 0x31F0) && (cp < 0x3200)) return cjk_class::ideograph;		// Katakana Phonetic Extensions
+	if((cp >= 0x3200) && (cp < 0x3400)) return cjk_class::separator;		// Enclosed CJK letters, CJK compatibility
+	if((cp >= 0x3400) && (cp < 0xA000)) return cjk_class::ideograph;		// CJK Unified Ideographs (and Extension A)
+	if((cp >= 0xE000) && (cp < 0xF900)) return cjk_class::separator;		// Private Use Area
+	if((cp >= 0xF900) && (cp < 0xFB00)) return cjk_class::ideograph;		// CJK Compatibility Ideographs
+	if((cp >= 0xFE10) && (cp < 0xFE70)) return cjk_class::separator;		// Vertical, compatibility and small forms
+	if((cp >= 0xFF00) && (cp < 0x10000)) return cjk_class::separator;		// Remaining width forms and specials
+	if((cp >= 0x1F000) && (cp < 0x20000)) return cjk_class::separator;		// Emoji and pictographs
+	if((cp >= 0x20000) && (cp < 0x40000)) return cjk_class::ideograph;		// CJK Unified Ideographs Extension B+
+
+	return cjk_class::word;
+}
+
+//---------------------------------------------------------------------------
+// cjk_voice (local)
+//
+// Combines a katakana code point with a voiced or semi-voiced sound mark,
+// returning zero if the combination doesn't exist
+//
+// Arguments:
+//
+//	cp			- Katakana code point
+//	mark		- Voiced or semi-voiced sound mark code point
+
+static uint32_t cjk_voice(uint32_t cp, uint32_t mark)
+{
+	bool const semivoiced = ((mark == 0x309A) || (mark == 0x309C) || (mark == 0xFF9F));
+
+	// HA, HI, FU, HE and HO take either mark
+	if((cp >= 0x30CF) && (cp <= 0x30DB) && (((cp - 0x30CF) % 3) == 0)) return cp + (semivoiced ? 2 : 1);
+	if(semivoiced) return 0;
+
+	if((cp >= 0x30AB) && (cp <= 0x30C1) && ((cp & 1) == 1)) return cp + 1;		// KA - TI
+	if((cp >= 0x30C4) && (cp <= 0x30C8) && ((cp & 1) == 0)) return cp + 1;		// TU, TE, TO
+	if((cp >= 0x30EF) && (cp <= 0x30F2)) return cp + 8;							// WA, WI, WE, WO
+	if(cp == 0x30A6) return 0x30F4;												// U
+	if(cp == 0x30FD) return 0x30FE;												// Iteration mark
+
+	return 0;
+}
+
+//---------------------------------------------------------------------------
+// cjk_fold (local)
+//
+// Applies width, case and kana folding to a decoded code point
+//
+// Arguments:
+//
+//	cp			- Decoded code point
+//	pos			- Current input position; advanced past a combined sound mark
+//	end			- End of the input text
+
+static uint32_t cjk_fold(uint32_t cp, char const*& pos, char const* end)
+{
+	if((cp >= 0xFF01) && (cp <= 0xFF5E)) cp -= 0xFEE0;						// Fullwidth ASCII
+	else if(cp == 0x3000) cp = 0x20;										// Ideographic space
+	else if((cp >= 0xFF61) && (cp <= 0xFF9F)) cp = cjk_halfwidth[cp - 0xFF61];
+
+	if((cp >= 'A') && (cp <= 'Z')) return cp + 0x20;
+	if((cp >= 0xC0) && (cp <= 0xDE) && (cp != 0xD7)) return cp + 0x20;
+
+	// Hiragana are shifted into katakana so that the sound marks only have to be
+	// combined in one place; all of it is shifted back into hiragana afterwards
+	if(((cp >= 0x3041) && (cp <= 0x3096)) || (cp == 0x309D) || (cp == 0x309E)) cp += 0x60;
+
+	if((cp >= 0x30A1) && (cp <= 0x30FE)) {
+
+		if(pos < end) {
+
+			char const* next = pos;
+			uint32_t const mark = utf8_decode(next, end);
+			if(((mark >= 0x3099) && (mark <= 0x309C)) || (mark == 0xFF9E) || (mark == 0xFF9F)) {
+
+				uint32_t const voiced = cjk_voice(cp, mark);
+				if(voiced != 0) { cp = voiced; pos = next; }
+			}
+		}
+
+		if(((cp >= 0x30A1) && (cp <= 0x30F6)) || (cp == 0x30FD) || (cp == 0x30FE)) cp -= 0x60;
+	}
+
+	return cp;
+}
+
+//---------------------------------------------------------------------------
+// cjk_create (local)
+//
+// Creates a new instance of the cjk tokenizer
+//
+// Arguments:
+//
+//	context		- Context pointer provided when the tokenizer was registered
+//	argv		- Tokenizer arguments
+//	argc		- Number of tokenizer arguments
+//	tokenizer	- On success, receives the new tokenizer instance
+
+static int cjk_create(void* /*context*/, char const** /*argv*/, int argc, Fts5Tokenizer** tokenizer)
+{
+	if(argc != 0) return SQLITE_ERROR;			// No arguments are accepted
+
+	cjk_tokenizer* instance = new(std::nothrow) cjk_tokenizer();
+	if(instance == nullptr) return SQLITE_NOMEM;
+
+	*tokenizer = reinterpret_cast<Fts5Tokenizer*>(instance);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cjk_delete (local)
+//
+// Deletes an instance of the cjk tokenizer
+//
+// Arguments:
+//
+//	tokenizer	- Tokenizer instance to be deleted
+
+static void cjk_delete(Fts5Tokenizer* tokenizer)
+{
+	delete reinterpret_cast<cjk_tokenizer*>(tokenizer);
+}
+
+//---------------------------------------------------------------------------
+// cjk_isalnum (local)
+//
+// Determines if an ASCII character is alphanumeric without regard to locale
+//
+// Arguments:
+//
+//	ch			- Character to be tested
+
+static bool cjk_isalnum(char ch)
+{
+	return ((ch >= '0') && (ch <= '9')) || ((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z'));
+}
+
+//---------------------------------------------------------------------------
+// cjk_tokenizeascii (local)
+//
+// Tokenizes input text that contains only ASCII characters; word tokens that
+// don't require case folding are passed directly from the input text
+//
+// Arguments:
+//
+//	instance	- Tokenizer instance
+//	context		- Context pointer to pass to the token callback
+//	text		- Input text
+//	length		- Length of the input text, in bytes
+//	token		- Token callback function
+
+static int cjk_tokenizeascii(cjk_tokenizer* instance, void* context, char const* text, int length,
+	int(*token)(void*, int, char const*, int, int, int))
+{
+	int pos = 0;
+
+	while(pos < length) {
+
+		// Skip over any separator characters
+		while((pos < length) && !cjk_isalnum(text[pos])) pos++;
+		if(pos == length) break;
+
+		int const start = pos;
+		bool upper = false;
+
+		while((pos < length) && cjk_isalnum(text[pos])) {
+
+			if((text[pos] >= 'A') && (text[pos] <= 'Z')) upper = true;
+			pos++;
+		}
+
+		int result;
+		if(upper) {
+
+			instance->word.assign(&text[start], static_cast<size_t>(pos - start));
+			for(char& ch : instance->word) if((ch >= 'A') && (ch <= 'Z')) ch += 0x20;
+			result = token(context, 0, instance->word.data(), pos - start, start, pos);
+		}
+
+		else result = token(context, 0, &text[start], pos - start, start, pos);
+
+		if(result != SQLITE_OK) return result;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cjk_tokenize (local)
+//
+// Tokenizes input text
+//
+// Arguments:
+//
+//	tokenizer	- Tokenizer instance
+//	context		- Context pointer to pass to the token callback
+//	flags		- FTS5_TOKENIZE_XXX flags
+//	text		- Input text
+//	length		- Length of the input text, in bytes
+//	token		- Token callback function
+
+static int cjk_tokenize(Fts5Tokenizer* tokenizer, void* context, int flags, char const* text, int length,
+	int(*token)(void*, int, char const*, int, int, int))
+{
+	cjk_tokenizer* instance = reinterpret_cast<cjk_tokenizer*>(tokenizer);
+	if((text == nullptr) || (length <= 0)) return SQLITE_OK;
+
+	// Queries only generate the bigrams, documents also generate colocated unigrams
+	bool const query = ((flags & FTS5_TOKENIZE_QUERY) == FTS5_TOKENIZE_QUERY);
+
+	try {
+
+		// ASCII FAST PATH
+		//
+		uint8_t highbits = 0;
+		for(int index = 0; index < length; index++) highbits |= static_cast<uint8_t>(text[index]);
+		if((highbits & 0x80) == 0) return cjk_tokenizeascii(instance, context, text, length, token);
+
+		std::string& word = instance->word;			// Folded word token
+		int wordstart = 0;							// Start offset of the word
+		int wordend = 0;							// End offset of the word
+
+		char prev[4];								// Previous ideograph (UTF-8)
+		int prevlength = 0;							// Length of the previous ideograph
+		int prevstart = 0;							// Start offset of the previous ideograph
+		int prevend = 0;							// End offset of the previous ideograph
+		size_t runlength = 0;						// Length of the current ideograph run
+		int result = SQLITE_OK;						// Result from token callback
+
+		word.clear();
+
+		char const* const end = text + length;
+		char const* pos = text;
+
+		while(true) {
+
+			int const start = static_cast<int>(pos - text);
+			bool const eof = (pos == end);
+			cjk_class cls = cjk_class::separator;
+			uint32_t cp = 0;
+
+			// The end of the text is processed as a separator to flush any pending tokens
+			if(!eof) {
+
+				cp = utf8_decode(pos, end);
+				cp = cjk_fold(cp, pos, end);
+				cls = cjk_classify(cp);
+			}
+
+			int const finish = static_cast<int>(pos - text);
+
+			// End of a word
+			if((cls != cjk_class::word) && (!word.empty())) {
+
+				result = token(context, 0, word.data(), static_cast<int>(word.size()), wordstart, wordend);
+				if(result != SQLITE_OK) return result;
+				word.clear();
+			}
+
+			// End of an ideograph run; a single ideograph is emitted as a unigram, otherwise the
+			// last ideograph is colocated with the final bigram in a document
+			if((cls != cjk_class::ideograph) && (runlength > 0)) {
+
+				if(runlength == 1) result = token(context, 0, prev, prevlength, prevstart, prevend);
+				else if(!query) result = token(context, FTS5_TOKEN_COLOCATED, prev, prevlength, prevstart, prevend);
+				if(result != SQLITE_OK) return result;
+				runlength = 0;
+			}
+
+			if(eof) break;
+
+			if(cls == cjk_class::word) {
+
+				char buffer[4];
+				if(word.empty()) wordstart = start;
+				word.append(buffer, static_cast<size_t>(utf8_encode(cp, buffer)));
+				wordend = finish;
+			}
+
+			else if(cls == cjk_class::ideograph) {
+
+				char bigram[8];
+				int const cplength = utf8_encode(cp, &bigram[prevlength]);
+
+				if(runlength > 0) {
+
+					// Emit the bigram formed with the previous ideograph and, in a document,
+					// the previous ideograph as a unigram at the same position
+					memcpy(bigram, prev, static_cast<size_t>(prevlength));
+					result = token(context, 0, bigram, prevlength + cplength, prevstart, finish);
+					if((result == SQLITE_OK) && (!query)) result = token(context, FTS5_TOKEN_COLOCATED, prev, prevlength, prevstart, prevend);
+					if(result != SQLITE_OK) return result;
+				}
+
+				memcpy(prev, &bigram[prevlength], static_cast<size_t>(cplength));
+				prevlength = cplength;
+				prevstart = start;
+				prevend = finish;
+				runlength++;
+			}
+		}
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc&) { return SQLITE_NOMEM; }
+}
+
+// cjk_module
+//
+// Tokenizer definition for the cjk tokenizer
+static fts5_tokenizer cjk_module = {
+
+	cjk_create,			// xCreate
+	cjk_delete,			// xDelete
+	cjk_tokenize,		// xTokenize
+};
+
+//---------------------------------------------------------------------------
+// effecttags virtual table
+//
+// Eponymous table-valued function that extracts the bracketed keyword tags
+// from card effect text. Compound tags are split on the forward slash, so
+// "[Activate Main/Battle]" produces both "Activate Main" and "Battle"; each
+// tag is width-folded and trimmed but otherwise returned verbatim:
+//
+//	select tag from effecttags('[Permanent][Your Turn] ...')
+//
+// tag | ordinal | effect (hidden)
+
+// effecttags_columns
+//
+// Column ordinals for the effecttags virtual table
+enum effecttags_columns {
+
+	effecttags_tag = 0,
+	effecttags_ordinal,
+	effecttags_effect,
+};
+
+// effecttags_cursor
+//
+// Virtual table cursor instance
+struct effecttags_cursor : public sqlite3_vtab_cursor {
+
+	std::vector<std::string>	tags;			// Extracted tags (UTF-8)
+	size_t						index = 0;		// Current tag index
+};
+
+//---------------------------------------------------------------------------
+// effecttags_connect (local)
+//
+// Connects to the effecttags virtual table
+//
+// Arguments:
+//
+//	db			- SQLite database instance
+//	aux			- Client data pointer from sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments
+//	vtab		- On success receives the virtual table instance
+//	errmsg		- On failure receives the error message
+
+static int effecttags_connect(sqlite3* db, void* /*aux*/, int /*argc*/, char const* const* /*argv*/, sqlite3_vtab** vtab, char** /*errmsg*/)
+{
+	*vtab = nullptr;
+
+	int result = sqlite3_declare_vtab(db, "create table effecttags(tag text, ordinal integer, effect hidden)");
+	if(result != SQLITE_OK) return result;
+
+	*vtab = new(std::nothrow) sqlite3_vtab();
+	if(*vtab == nullptr) return SQLITE_NOMEM;
+
+	sqlite3_vtab_config(db, SQLITE_VTAB_INNOCUOUS);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_disconnect (local)
+//
+// Disconnects from the effecttags virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int effecttags_disconnect(sqlite3_vtab* vtab)
+{
+	delete vtab;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_bestindex (local)
+//
+// Determines the best query plan for the effecttags virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int effecttags_bestindex(sqlite3_vtab* /*vtab*/, sqlite3_index_info* info)
+{
+	for(int index = 0; index < info->nConstraint; index++) {
+
+		auto const& constraint = info->aConstraint[index];
+		if((constraint.iColumn != effecttags_effect) || (constraint.op != SQLITE_INDEX_CONSTRAINT_EQ)) continue;
+
+		// An unusable effect constraint means the plan can't be used at all
+		if(!constraint.usable) return SQLITE_CONSTRAINT;
+
+		info->aConstraintUsage[index].argvIndex = 1;
+		info->aConstraintUsage[index].omit = 1;
+		info->estimatedCost = 10.0;
+		info->estimatedRows = 4;
+
+		return SQLITE_OK;
+	}
+
+	// The effect text argument is required
+	return SQLITE_CONSTRAINT;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_open (local)
+//
+// Opens a cursor against the effecttags virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	cursor		- On success receives the cursor instance
+
+static int effecttags_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
+{
+	*cursor = new(std::nothrow) effecttags_cursor();
+	return (*cursor == nullptr) ? SQLITE_NOMEM : SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_close (local)
+//
+// Closes an effecttags virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int effecttags_close(sqlite3_vtab_cursor* cursor)
+{
+	delete static_cast<effecttags_cursor*>(cursor);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_next (local)
+//
+// Advances an effecttags virtual table cursor to the next tag
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int effecttags_next(sqlite3_vtab_cursor* cursor)
+{
+	static_cast<effecttags_cursor*>(cursor)->index++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_filter (local)
+//
+// Begins a search of the effecttags virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Unused
+//	idxstr		- Unused
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int effecttags_filter(sqlite3_vtab_cursor* cursor, int /*idxnum*/, char const* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	effecttags_cursor* instance = static_cast<effecttags_cursor*>(cursor);
+
+	instance->tags.clear();
+	instance->index = 0;
+
+	if(argc < 1) return SQLITE_OK;
+
+	char const* effect = reinterpret_cast<char const*>(sqlite3_value_text(argv[0]));
+	if(effect == nullptr) return SQLITE_OK;
+
+	try {
+
+		char const* const end = effect + sqlite3_value_bytes(argv[0]);
+		std::string tag;
+		bool intag = false;
+
+		for(char const* pos = effect; pos < end;) {
+
+			uint32_t cp = utf8_decode(pos, end);
+
+			// Fold fullwidth ASCII and the ideographic space into ASCII
+			if((cp >= 0xFF01) && (cp <= 0xFF5E)) cp -= 0xFEE0;
+			else if(cp == 0x3000) cp = ' ';
+
+			if(cp == '[') { intag = true; tag.clear(); continue; }
+			if(!intag) continue;
+
+			// A slash separates the parts of a compound tag, a closing bracket ends the tag
+			if((cp == '/') || (cp == ']')) {
+
+				size_t const first = tag.find_first_not_of(' ');
+				if(first != std::string::npos) instance->tags.emplace_back(tag.substr(first, tag.find_last_not_of(' ') - first + 1));
+
+				tag.clear();
+				if(cp == ']') intag = false;
+			}
+
+			else {
+
+				char buffer[4];
+				tag.append(buffer, static_cast<size_t>(utf8_encode(cp, buffer)));
+			}
+		}
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+// effecttags_eof (local)
+//
+// Determines if an effecttags virtual table cursor is at end of file
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int effecttags_eof(sqlite3_vtab_cursor* cursor)
+{
+	effecttags_cursor* instance = static_cast<effecttags_cursor*>(cursor);
+	return (instance->index >= instance->tags.size()) ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_column (local)
+//
+// Returns a column value for the current effecttags virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- SQLite context object
+//	ordinal		- Column ordinal
+
+static int effecttags_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
+{
+	effecttags_cursor* instance = static_cast<effecttags_cursor*>(cursor);
+
+	switch(ordinal) {
+
+		case effecttags_tag:
+			sqlite3_result_text(context, instance->tags[instance->index].data(),
+				static_cast<int>(instance->tags[instance->index].size()), SQLITE_TRANSIENT);
+			break;
+
+		case effecttags_ordinal:
+			sqlite3_result_int64(context, static_cast<sqlite3_int64>(instance->index));
+			break;
+
+		// The hidden effect column isn't retained by the cursor
+		case effecttags_effect:
+			sqlite3_result_null(context);
+			break;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// effecttags_rowid (local)
+//
+// Returns the rowid for the current effecttags virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	rowid		- On success receives the rowid
+
+static int effecttags_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+	*rowid = static_cast<sqlite3_int64>(static_cast<effecttags_cursor*>(cursor)->index);
+	return SQLITE_OK;
+}
+
+// effecttags_module
+//
+// Module definition for the effecttags virtual table; eponymous only
+static sqlite3_module effecttags_module = {
+
+	0,						// iVersion
+	nullptr,				// xCreate
+	effecttags_connect,		// xConnect
+	effecttags_bestindex,	// xBestIndex
+	effecttags_disconnect,	// xDisconnect
+	nullptr,				// xDestroy
+	effecttags_open,		// xOpen
+	effecttags_close,		// xClose
+	effecttags_filter,		// xFilter
+	effecttags_next,		// xNext
+	effecttags_eof,			// xEof
+	effecttags_column,		// xColumn
+	effecttags_rowid,		// xRowid
+	nullptr,				// xUpdate
+	nullptr,				// xBegin
+	nullptr,				// xSync
+	nullptr,				// xCommit
+	nullptr,				// xRollback
+	nullptr,				// xFindFunction
+	nullptr,				// xRename
+	nullptr,				// xSavepoint
+	nullptr,				// xRelease
+	nullptr,				// xRollbackTo
+};
+
+//---------------------------------------------------------------------------
+// uuidstate (local)
+//
+// Per-connection state for the UUID generation functions. The random bytes
+// are drawn from the system CSPRNG in bulk so that each generated UUID costs
+// a copy rather than a system call. SQLite only allows one thread at a time
+// to use a connection, so the state doesn't require any synchronization
+
+struct uuidstate {
+
+	uint8_t				pool[4096];				// Cryptographically random bytes
+	size_t				offset = sizeof(pool);	// Offset of the next unused byte
+	uint64_t			lastms = 0;				// Last UUIDv7 timestamp
+	uint16_t			counter = 0;			// Last UUIDv7 12-bit counter
+	long				refcount = 1;			// Registered function references
+};
+
+//---------------------------------------------------------------------------
+// uuidstate_destroy (local)
+//
+// Releases a function reference to the UUID generation state
+//
+// Arguments:
+//
+//	state		- uuidstate instance pointer
+
+static void uuidstate_destroy(void* state)
+{
+	uuidstate* instance = reinterpret_cast<uuidstate*>(state);
+	if(--instance->refcount == 0) delete instance;
+}
+
+//---------------------------------------------------------------------------
+// uuidstate_fill (local)
+//
+// Fills a buffer from the host cryptographically secure random number generator
+//
+// Arguments:
+//
+//	buffer		- Buffer to receive the random bytes
+//	length		- Number of random bytes to receive
+
+static bool uuidstate_fill(uint8_t* buffer, size_t length)
+{
+#if defined(_WIN32)
+	return BCRYPT_SUCCESS(BCryptGenRandom(nullptr, buffer, static_cast<ULONG>(length), BCRYPT_USE_SYSTEM_PREFERRED_RNG));
+#elif defined(__linux__)
+	while(length > 0) {
+
+		// getrandom() can return fewer bytes than requested if it's interrupted by a signal
+		ssize_t filled = getrandom(buffer, length, 0);
+		if(filled < 0) { if(errno == EINTR) continue; return false; }
+
+		buffer += filled;
+		length -= static_cast<size_t>(filled);
+	}
+
+	return true;
+#else
+	arc4random_buf(buffer, length);
+	return true;
+#endif
+}
+
+//---------------------------------------------------------------------------
+// uuidstate_random (local)
+//
+// Copies random bytes out of the UUID generation state pool
+//
+// Arguments:
+//
+//	state		- uuidstate instance
+//	buffer		- Buffer to receive the random bytes
+//	length		- Number of random bytes to receive; must not exceed the pool
+
+static bool uuidstate_random(uuidstate* state, uint8_t* buffer, size_t length)
+{
+	// Refill the entire pool from the system CSPRNG when exhausted
+	if(length > (sizeof(state->pool) - state->offset)) {
+
+		if(!uuidstate_fill(state->pool, sizeof(state->pool))) return false;
+		state->offset = 0;
+	}
+
+	memcpy(buffer, &state->pool[state->offset], length);
+
+	// The bytes that were handed out are cleared through a volatile pointer so that the
+	// compiler can't elide the stores
+	uint8_t volatile* consumed = &state->pool[state->offset];
+	for(size_t index = 0; index < length; index++) consumed[index] = 0;
+	state->offset += length;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// newid (local)
+//
+// SQLite scalar function to generate a random (version 4) UUID
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void newid(sqlite3_context* context, int argc, sqlite3_value** /*argv*/)
+{
+	uint8_t uuid[16] = {};
+
+	if(argc != 0) return sqlite3_result_error(context, "invalid argument", -1);
+
+	uuidstate* state = reinterpret_cast<uuidstate*>(sqlite3_user_data(context));
+	if(!uuidstate_random(state, uuid, sizeof(uuid))) return sqlite3_result_error(context, "unable to generate random data", -1);
+
+	// Apply the version (4) and variant (RFC 9562) bits in the System::Guid byte layout, where
+	// the version is the high nibble of the little-endian Data3 field, so that the blob matches
+	// what UuidCreate() would generate
+	uuid[7] = static_cast<uint8_t>((uuid[7] & 0x0F) | 0x40);
+	uuid[8] = static_cast<uint8_t>((uuid[8] & 0x3F) | 0x80);
+
+	// Return the UUID back as a 16-byte blob
+	return sqlite3_result_blob(context, uuid, sizeof(uuid), SQLITE_TRANSIENT);
+}
+
+//---------------------------------------------------------------------------
+// newid7 (local)
+//
+// SQLite scalar function to generate a time-ordered (version 7) UUID. The blob
+// is stored in the RFC 9562 byte order so that comparing blobs orders them by
+// creation time; uuidstr() and System::Guid(array<byte>^) interpret the first
+// eight bytes as little-endian fields and therefore present a newid7() value
+// with the time_low, time_mid and version fields byte-swapped.  Use hex() to
+// see the RFC 9562 form of the value
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void newid7(sqlite3_context* context, int argc, sqlite3_value** /*argv*/)
+{
+	uint8_t uuid[16] = {};
+
+	if(argc != 0) return sqlite3_result_error(context, "invalid argument", -1);
+
+	// Only the rand_a and rand_b fields (the last ten bytes) are random
+	uuidstate* state = reinterpret_cast<uuidstate*>(sqlite3_user_data(context));
+	if(!uuidstate_random(state, &uuid[6], sizeof(uuid) - 6)) return sqlite3_result_error(context, "unable to generate random data", -1);
+
+	// Get the current time as milliseconds since the Unix epoch
+	uint64_t unixms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+
+	// The 12-bit rand_a field is used as a counter to keep UUIDs generated within
+	// the same millisecond (or after the clock moves backwards) monotonic; it's
+	// seeded randomly with the high bit clear to leave room for increments
+	if(unixms > state->lastms) {
+
+		state->lastms = unixms;
+		state->counter = static_cast<uint16_t>(((uuid[6] << 8) | uuid[7]) & 0x07FF);
+	}
+
+	else if(++state->counter > 0x0FFF) {
+
+		state->lastms++;
+		state->counter = 0;
+	}
+
+	// unix_ts_ms (48 bits, big-endian) | ver (4 bits) | rand_a (12 bits) | var (2 bits) | rand_b (62 bits)
+	for(int index = 0; index < 6; index++) uuid[index] = static_cast<uint8_t>(state->lastms >> (40 - (index * 8)));
+	uuid[6] = static_cast<uint8_t>(0x70 | (state->counter >> 8));
+	uuid[7] = static_cast<uint8_t>(state->counter);
+	uuid[8] = static_cast<uint8_t>((uuid[8] & 0x3F) | 0x80);
+
+	// Return the UUID back as a 16-byte blob
+	return sqlite3_result_blob(context, uuid, sizeof(uuid), SQLITE_TRANSIENT);
+}
+
+//---------------------------------------------------------------------------
+// prettyjson_indent (local)
+//
+// Appends a line break and the indentation for a nesting depth
+//
+// Arguments:
+//
+//	output		- Output string
+//	depth		- Nesting depth
+
+static void prettyjson_indent(std::string& output, size_t depth)
+{
+	output.push_back('\n');
+	output.append(depth * 2, ' ');
+}
+
+//---------------------------------------------------------------------------
+// prettyjson (local)
+//
+// SQLite scalar function to pretty print a JSON string with a two space
+// indent; the string, number and literal tokens are copied unchanged
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void prettyjson(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	// Null or zero-length input string results in null
+	char const* json = reinterpret_cast<char const*>(sqlite3_value_text(argv[0]));
+	if((json == nullptr) || (*json == '\0')) return sqlite3_result_null(context);
+	size_t const length = static_cast<size_t>(sqlite3_value_bytes(argv[0]));
+
+	std::string output;					// Pretty printed JSON
+	std::string scopes;					// Closing characters of the open scopes
+
+	try {
+
+		output.reserve(length * 2);
+
+		for(size_t index = 0; index < length; index++) {
+
+			char ch = json[index];
+			switch(ch) {
+
+				case ' ': case '\t': case '\r': case '\n': break;
+
+				case '{': case '[': {
+
+					// Empty objects and arrays are written without a line break
+					size_t next = index + 1;
+					while((next < length) && ((json[next] == ' ') || (json[next] == '\t') || (json[next] == '\r') || (json[next] == '\n'))) next++;
+
+					char close = (ch == '{') ? '}' : ']';
+					if((next < length) && (json[next] == close)) { output.push_back(ch); output.push_back(close); index = next; break; }
+
+					output.push_back(ch);
+					scopes.push_back(close);
+					prettyjson_indent(output, scopes.size());
+					break;
+				}
+
+				case '}': case ']':
+
+					if(scopes.empty() || (scopes.back() != ch)) return sqlite3_result_error(context, "malformed JSON", -1);
+
+					scopes.pop_back();
+					prettyjson_indent(output, scopes.size());
+					output.push_back(ch);
+					break;
+
+				case ',':
+
+					if(scopes.empty()) return sqlite3_result_error(context, "malformed JSON", -1);
+
+					output.push_back(ch);
+					prettyjson_indent(output, scopes.size());
+					break;
+
+				case ':':
+
+					output.append(": ");
+					break;
+
+				case '"': {
+
+					// Copy the string through the closing quote, skipping over any escaped characters
+					size_t start = index++;
+					while((index < length) && (json[index] != '"')) index += (json[index] == '\\') ? 2 : 1;
+					if(index >= length) return sqlite3_result_error(context, "malformed JSON", -1);
+
+					output.append(&json[start], index - start + 1);
+					break;
+				}
+
+				default:
+
+					output.push_back(ch);
+			}
+		}
+
+		if(!scopes.empty()) return sqlite3_result_error(context, "malformed JSON", -1);
+	}
+
+	catch(std::bad_alloc const&) { return sqlite3_result_error_nomem(context); }
+
+	return sqlite3_result_text64(context, output.data(), output.size(), SQLITE_TRANSIENT, SQLITE_UTF8);
+}
+
+#ifndef DBCORE_NO_WEBP
+
+//---------------------------------------------------------------------------
+// webpphash_dct (local)
+//
+// The first 8 rows of the orthonormal 32-point DCT-II basis; only the lowest
+// 8x8 frequencies of the transformed image contribute to the hash
+alignas(16) static float const webpphash_dct[8][32] = {
+
+	{
+		0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f,
+		0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f,
+		0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f,
+		0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f, 0.176776695f
+	},
+	{
+		0.249698864f, 0.247294127f, 0.242507813f, 0.235386016f, 0.225997323f, 0.214432153f, 0.200801883f, 0.185237781f,
+		0.167889739f, 0.148924826f, 0.128525686f, 0.106888773f, 0.084222463f, 0.060745045f, 0.036682619f, 0.012266919f,
+		-0.012266919f, -0.036682619f, -0.060745045f, -0.084222463f, -0.106888773f, -0.128525686f, -0.148924826f, -0.167889739f,
+		-0.185237781f, -0.200801883f, -0.214432153f, -0.225997323f, -0.235386016f, -0.242507813f, -0.247294127f, -0.249698864f
+	},
+	{
+		0.248796182f, 0.239235084f, 0.220480316f, 0.193252613f, 0.158598321f, 0.117849184f, 0.072571169f, 0.024504285f,
+		-0.024504285f, -0.072571169f, -0.117849184f, -0.158598321f, -0.193252613f, -0.220480316f, -0.239235084f, -0.248796182f,
+		-0.248796182f, -0.239235084f, -0.220480316f, -0.193252613f, -0.158598321f, -0.117849184f, -0.072571169f, -0.024504285f,
+		0.024504285f, 0.072571169f, 0.117849184f, 0.158598321f, 0.193252613f, 0.220480316f, 0.239235084f, 0.248796182f
+	},
+	{
+		0.247294127f, 0.225997323f, 0.185237781f, 0.128525686f, 0.060745045f, -0.012266919f, -0.084222463f, -0.148924826f,
+		-0.200801883f, -0.235386016f, -0.249698864f, -0.242507813f, -0.214432153f, -0.167889739f, -0.106888773f, -0.036682619f,
+		0.036682619f, 0.106888773f, 0.167889739f, 0.214432153f, 0.242507813f, 0.249698864f, 0.235386016f, 0.200801883f,
+		0.148924826f, 0.084222463f, 0.012266919f, -0.060745045f, -0.128525686f, -0.185237781f, -0.225997323f, -0.247294127f
+	},
+	{
+		0.245196320f, 0.207867403f, 0.138892558f, 0.048772581f, -0.048772581f, -0.138892558f, -0.207867403f, -0.245196320f,
+		-0.245196320f, -0.207867403f, -0.138892558f, -0.048772581f, 0.048772581f, 0.138892558f, 0.207867403f, 0.245196320f,
+		0.245196320f, 0.207867403f, 0.138892558f, 0.048772581f, -0.048772581f, -0.138892558f, -0.207867403f, -0.245196320f,
+		-0.245196320f, -0.207867403f, -0.138892558f, -0.048772581f, 0.048772581f, 0.138892558f, 0.207867403f, 0.245196320f
+	},
+	{
+		0.242507813f, 0.185237781f, 0.084222463f, -0.036682619f, -0.148924826f, -0.225997323f, -0.249698864f, -0.214432153f,
+		-0.128525686f, -0.012266919f, 0.106888773f, 0.200801883f, 0.247294127f, 0.235386016f, 0.167889739f, 0.060745045f,
+		-0.060745045f, -0.167889739f, -0.235386016f, -0.247294127f, -0.200801883f, -0.106888773f, 0.012266919f, 0.128525686f,
+		0.214432153f, 0.249698864f, 0.225997323f, 0.148924826f, 0.036682619f, -0.084222463f, -0.185237781f, -0.242507813f
+	},
+	{
+		0.239235084f, 0.158598321f, 0.024504285f, -0.117849184f, -0.220480316f, -0.248796182f, -0.193252613f, -0.072571169f,
+		0.072571169f, 0.193252613f, 0.248796182f, 0.220480316f, 0.117849184f, -0.024504285f, -0.158598321f, -0.239235084f,
+		-0.239235084f, -0.158598321f, -0.024504285f, 0.117849184f, 0.220480316f, 0.248796182f, 0.193252613f, 0.072571169f,
+		-0.072571169f, -0.193252613f, -0.248796182f, -0.220480316f, -0.117849184f, 0.024504285f, 0.158598321f, 0.239235084f
+	},
+	{
+		0.235386016f, 0.128525686f, -0.036682619f, -0.185237781f, -0.249698864f, -0.200801883f, -0.060745045f, 0.106888773f,
+		0.225997323f, 0.242507813f, 0.148924826f, -0.012266919f, -0.167889739f, -0.247294127f, -0.214432153f, -0.084222463f,
+		0.084222463f, 0.214432153f, 0.247294127f, 0.167889739f, 0.012266919f, -0.148924826f, -0.242507813f, -0.225997323f,
+		-0.106888773f, 0.060745045f, 0.200801883f, 0.249698864f, 0.185237781f, 0.036682619f, -0.128525686f, -0.235386016f
+	},
+};
+
+//---------------------------------------------------------------------------
+// webpphash (local)
+//
+// SQLite scalar function to compute a 64-bit perceptual hash of a webp blob.
+// The image is decoded by libwebp directly into a 32x32 luma plane, which is
+// transformed with a two-dimensional DCT; each bit of the hash indicates if
+// one of the lowest 8x8 frequency coefficients is above their median. Bit n
+// corresponds to coefficient (n / 8, n % 8). Visually similar images have
+// hashes that differ in few bits, see imagesearch. A blob that cannot be
+// decoded results in null
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void webpphash(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	// The argument is always treated as a blob and null results in null
+	uint8_t const* blob = reinterpret_cast<uint8_t const*>(sqlite3_value_blob(argv[0]));
+	if(blob == nullptr) return sqlite3_result_null(context);
+
+	WebPDecoderConfig config;
+	if(!WebPInitDecoderConfig(&config)) return sqlite3_result_error(context, "incompatible libwebp version", -1);
+
+	// Let the decoder scale the image down and only the luma plane is used; the in-loop
+	// filtering doesn't meaningfully contribute to such a small image
+	config.options.use_scaling = 1;
+	config.options.scaled_width = 32;
+	config.options.scaled_height = 32;
+	config.options.bypass_filtering = 1;
+	config.output.colorspace = MODE_YUV;
+
+	// An image that can't be decoded has no hash rather than failing the statement, this
+	// is evaluated over every card image during import and schema migration
+	if(WebPDecode(blob, sqlite3_value_bytes(argv[0]), &config) != VP8_STATUS_OK) {
+
+		WebPFreeDecBuffer(&config.output);
+		return sqlite3_result_null(context);
+	}
+
+	alignas(16) float pixels[32][32];			// Luma plane
+	alignas(16) float rows[8][32];				// Row frequencies, column space
+	float coefficients[64];						// Low frequency coefficients
+
+	uint8_t const* luma = config.output.u.YUVA.y;
+	for(int y = 0; y < 32; y++) {
+
+		for(int x = 0; x < 32; x++) pixels[y][x] = static_cast<float>(luma[x]);
+		luma += config.output.u.YUVA.y_stride;
+	}
+
+	WebPFreeDecBuffer(&config.output);
+
+	// rows = DCT[0..7] * pixels; each basis coefficient is broadcast across a row of pixels
+	for(int u = 0; u < 8; u++) {
+
+		__m128 accumulators[8] = {};
+
+		for(int y = 0; y < 32; y++) {
+
+			__m128 const basis = _mm_set1_ps(webpphash_dct[u][y]);
+			for(int x = 0; x < 8; x++) accumulators[x] = _mm_add_ps(accumulators[x], _mm_mul_ps(basis, _mm_load_ps(&pixels[y][x * 4])));
+		}
+
+		for(int x = 0; x < 8; x++) _mm_store_ps(&rows[u][x * 4], accumulators[x]);
+	}
+
+	// coefficients = rows * transpose(DCT[0..7])
+	for(int u = 0; u < 8; u++) {
+
+		for(int v = 0; v < 8; v++) {
+
+			__m128 sum = _mm_setzero_ps();
+			for(int x = 0; x < 32; x += 4) sum = _mm_add_ps(sum, _mm_mul_ps(_mm_load_ps(&rows[u][x]), _mm_load_ps(&webpphash_dct[v][x])));
+
+			// Horizontal sum of the four lanes
+			sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+			sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+			coefficients[(u * 8) + v] = _mm_cvtss_f32(sum);
+		}
+	}
+
+	// The threshold is the median of the 64 coefficients
+	float sorted[64];
+	memcpy(sorted, coefficients, sizeof(sorted));
+	std::nth_element(&sorted[0], &sorted[31], &sorted[64]);
+	float const lower = sorted[31];
+	float const median = (lower + *std::min_element(&sorted[32], &sorted[64])) / 2.0f;
+
+	uint64_t hash = 0;
+	for(int index = 0; index < 64; index++) if(coefficients[index] > median) hash |= (1ULL << index);
+
+	return sqlite3_result_int64(context, static_cast<sqlite3_int64>(hash));
+}
+
+#else
+
+//---------------------------------------------------------------------------
+// webpphash (local)
+//
+// Stands in for webpphash when the core is built without libwebp; no image
+// can be decoded, so every blob results in null
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void webpphash(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	return sqlite3_result_null(context);
+}
+
+#endif	// DBCORE_NO_WEBP
+
+//---------------------------------------------------------------------------
+// encode_cardlanguage
+//
+// Converts the text form of a CardLanguage into its integer value; null and
+// zero-length strings convert into None (zero)
+//
+// Arguments:
+//
+//	text		- UTF-8 text to be converted
+//	length		- Length of the text in bytes
+//	language	- On success, receives the integer CardLanguage value
+
+bool encode_cardlanguage(char const* text, int length, int* language)
+{
+	if(language == nullptr) return false;
+	return encode_enum(text, length, cardlanguage_names, *language);
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+//---------------------------------------------------------------------------
+// dbcore_extension_init
+//
+// Portable SQLite Extension Library entry point
+//
+// Arguments:
+//
+//	db		- SQLite database instance
+//	errmsg	- On failure set to the error message (use sqlite3_malloc() to allocate)
+//	api		- Pointer to the SQLite API functions; unused, the core is linked with SQLite
+
+extern "C" int dbcore_extension_init(sqlite3* db, char** errmsg, const sqlite3_api_routines* /*api*/)
+{
+	using namespace zuki::dbsfw::data::core;
+
+	if(errmsg != nullptr) *errmsg = nullptr;	// Initialize [out] variable
+
+	// base64decode function
+	//
+	int result = sqlite3_create_function(db, "base64decode", 1, SQLITE_UTF8, nullptr, base64decode, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function base64decode (%d)", result); return result; }
+
+	// base64encode function
+	//
+	result = sqlite3_create_function(db, "base64encode", 1, SQLITE_UTF8, nullptr, base64encode, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function base64encode (%d)", result); return result; }
+
+	// cardcolor function
+	//
+	result = sqlite3_create_function(db, "cardcolor", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardcolor, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardcolor (%d)", result); return result; }
+
+	// cardcolorname function
+	//
+	result = sqlite3_create_function(db, "cardcolorname", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardcolorname, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardcolorname (%d)", result); return result; }
+
+	// cardlanguage function
+	//
+	result = sqlite3_create_function(db, "cardlanguage", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardlanguage, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardlanguage (%d)", result); return result; }
+
+	// cardlanguagename function
+	//
+	result = sqlite3_create_function(db, "cardlanguagename", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardlanguagename, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardlanguagename (%d)", result); return result; }
+
+	// cardrarity function
+	//
+	result = sqlite3_create_function(db, "cardrarity", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardrarity, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardrarity (%d)", result); return result; }
+
+	// cardrarityname function
+	//
+	result = sqlite3_create_function(db, "cardrarityname", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardrarityname, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardrarityname (%d)", result); return result; }
+
+	// cardside function
+	//
+	result = sqlite3_create_function(db, "cardside", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardside, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardside (%d)", result); return result; }
+
+	// cardsidename function
+	//
+	result = sqlite3_create_function(db, "cardsidename", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardsidename, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardsidename (%d)", result); return result; }
+
+	// cardtype function
+	//
+	result = sqlite3_create_function(db, "cardtype", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardtype, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardtype (%d)", result); return result; }
+
+	// cardtypename function
+	//
+	result = sqlite3_create_function(db, "cardtypename", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, cardtypename, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function cardtypename (%d)", result); return result; }
+
+	// cjk tokenizer
+	//
+	// Tokenizers are registered through the fts5_api pointer, which has to be retrieved via a query
+	fts5_api* fts5 = nullptr;
+	sqlite3_stmt* statement = nullptr;
+
+	result = sqlite3_prepare_v2(db, "select fts5(?1)", -1, &statement, nullptr);
+	if(result == SQLITE_OK) {
+
+		sqlite3_bind_pointer(statement, 1, &fts5, "fts5_api_ptr", nullptr);
+		sqlite3_step(statement);
+		result = sqlite3_finalize(statement);
+	}
+
+	if((result == SQLITE_OK) && ((fts5 == nullptr) || (fts5->iVersion < 2))) result = SQLITE_ERROR;
+	if(result == SQLITE_OK) result = fts5->xCreateTokenizer(fts5, "cjk", nullptr, &cjk_module, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register fts5 tokenizer cjk (%d)", result); return result; }
+
+	// effecttags virtual table
+	//
+	result = sqlite3_create_module_v2(db, "effecttags", &effecttags_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register virtual table module effecttags (%d)", result); return result; }
+
+	// newid and newid7 functions
+	//
+	// Both functions share a reference to the per-connection UUID generation state
+	uuidstate* state = new(std::nothrow) uuidstate();
+	if(state == nullptr) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to allocate UUID generation state"); return SQLITE_NOMEM; }
+
+	state->refcount = 2;
+	result = sqlite3_create_function_v2(db, "newid", 0, SQLITE_UTF8, state, newid, nullptr, nullptr, uuidstate_destroy);
+	if(result != SQLITE_OK) {
+
+		uuidstate_destroy(state);			// Release the unused newid7 reference
+		if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function newid (%d)", result);
+		return result;
+	}
+
+	result = sqlite3_create_function_v2(db, "newid7", 0, SQLITE_UTF8, state, newid7, nullptr, nullptr, uuidstate_destroy);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function newid7 (%d)", result); return result; }
+
+	// prettyjson function
+	//
+	result = sqlite3_create_function(db, "prettyjson", 1, SQLITE_UTF8, nullptr, prettyjson, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function prettyjson (%d)", result); return result; }
+
+	// webpphash function
+	//
+	result = sqlite3_create_function(db, "webpphash", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, webpphash, nullptr, nullptr);
+	if(result != SQLITE_OK) { if(errmsg != nullptr) *errmsg = sqlite3_mprintf("Unable to register scalar function webpphash (%d)", result); return result; }
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
@@ -0,0 +1,379 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "dbcore.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define DBCORE_FILTER_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data::core {
+
+//---------------------------------------------------------------------------
+// TARGET_AVX2
+//
+// GCC and Clang only generate AVX2 instructions for functions that ask for them;
+// MSVC generates whatever instructions the intrinsics call for
+#if defined(_MSC_VER)
+#define TARGET_AVX2
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+//---------------------------------------------------------------------------
+// range_kernel_t
+//
+// Compares 64 consecutive column values against an inclusive range and
+// returns a bit for each value that falls within it
+using range_kernel_t = uint64_t(*)(int32_t const* values, int32_t minimum, int32_t maximum);
+
+#if defined(DBCORE_FILTER_X64)
+
+//---------------------------------------------------------------------------
+// range_kernel_avx2 (local)
+//
+// AVX2 implementation of range_kernel_t, compares 8 values at a time
+//
+// Arguments:
+//
+//	values		- Pointer to 64 column values
+//	minimum		- Inclusive minimum value
+//	maximum		- Inclusive maximum value
+
+TARGET_AVX2 static uint64_t range_kernel_avx2(int32_t const* values, int32_t minimum, int32_t maximum)
+{
+	__m256i const lower = _mm256_set1_epi32(minimum);
+	__m256i const upper = _mm256_set1_epi32(maximum);
+	uint64_t mask = 0;
+
+	for(int index = 0; index < 64; index += 8) {
+
+		__m256i value = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(values + index));
+
+		// There is no signed less-than-or-equal, test for values outside of the range instead
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lower, value), _mm256_cmpgt_epi32(value, upper));
+		uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(outside))) & 0xFF;
+
+		mask |= static_cast<uint64_t>(bits) << index;
+	}
+
+	return mask;
+}
+
+//---------------------------------------------------------------------------
+// range_kernel_sse2 (local)
+//
+// SSE2 implementation of range_kernel_t, compares 4 values at a time
+//
+// Arguments:
+//
+//	values		- Pointer to 64 column values
+//	minimum		- Inclusive minimum value
+//	maximum		- Inclusive maximum value
+
+static uint64_t range_kernel_sse2(int32_t const* values, int32_t minimum, int32_t maximum)
+{
+	__m128i const lower = _mm_set1_epi32(minimum);
+	__m128i const upper = _mm_set1_epi32(maximum);
+	uint64_t mask = 0;
+
+	for(int index = 0; index < 64; index += 4) {
+
+		__m128i value = _mm_loadu_si128(reinterpret_cast<__m128i const*>(values + index));
+
+		// There is no signed less-than-or-equal, test for values outside of the range instead
+		__m128i outside = _mm_or_si128(_mm_cmplt_epi32(value, lower), _mm_cmpgt_epi32(value, upper));
+		uint32_t bits = ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(outside))) & 0xF;
+
+		mask |= static_cast<uint64_t>(bits) << index;
+	}
+
+	return mask;
+}
+
+//---------------------------------------------------------------------------
+// has_avx2 (local)
+//
+// Determines if the processor and operating system both support AVX2
+//
+// Arguments:
+//
+//	NONE
+
+static bool has_avx2(void)
+{
+#if defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 0);
+	if(info[0] < 7) return false;
+
+	// The processor has to support AVX and the operating system has to save the YMM registers
+	__cpuid(info, 1);
+	if(((info[2] & (1 << 27)) == 0) || ((info[2] & (1 << 28)) == 0)) return false;
+	if((_xgetbv(0) & 0x6) != 0x6) return false;
+
+	__cpuidex(info, 7, 0);
+	return ((info[1] & (1 << 5)) != 0);
+#else
+	// The compiler runtime only reports AVX2 when the operating system saves the YMM registers
+	__builtin_cpu_init();
+	return (__builtin_cpu_supports("avx2") != 0);
+#endif
+}
+
+#else
+
+//---------------------------------------------------------------------------
+// range_kernel_scalar (local)
+//
+// Portable implementation of range_kernel_t, used on processors other than x64
+//
+// Arguments:
+//
+//	values		- Pointer to 64 column values
+//	minimum		- Inclusive minimum value
+//	maximum		- Inclusive maximum value
+
+static uint64_t range_kernel_scalar(int32_t const* values, int32_t minimum, int32_t maximum)
+{
+	uint64_t mask = 0;
+
+	for(int index = 0; index < 64; index++)
+		mask |= static_cast<uint64_t>((values[index] >= minimum) & (values[index] <= maximum)) << index;
+
+	return mask;
+}
+
+#endif	// defined(DBCORE_FILTER_X64)
+
+//---------------------------------------------------------------------------
+// select_range_kernel (local)
+//
+// Selects the best range_kernel_t implementation for the processor
+//
+// Arguments:
+//
+//	NONE
+
+static range_kernel_t select_range_kernel(void)
+{
+#if defined(DBCORE_FILTER_X64)
+	return has_avx2() ? range_kernel_avx2 : range_kernel_sse2;
+#else
+	return range_kernel_scalar;
+#endif
+}
+
+//---------------------------------------------------------------------------
+// s_rangekernel (local)
+//
+// Range comparison kernel selected for the processor at startup
+static range_kernel_t const s_rangekernel = select_range_kernel();
+
+//---------------------------------------------------------------------------
+// filter_state_t (local)
+//
+// State shared by the nodes of a filter while it is being evaluated
+
+struct filter_state_t {
+
+	filter_node_t const*	nodes;			// Nodes, in prefix order
+	int32_t const*			values;			// In node values
+	filter_column_t const*	columns;		// Columns
+	size_t					words;			// Number of words in each bitmap
+};
+
+//---------------------------------------------------------------------------
+// check_filter (local)
+//
+// Verifies that a filter node and its operands are well formed
+//
+// Arguments:
+//
+//	nodes		- Filter nodes, in prefix order
+//	numnodes	- Number of filter nodes
+//	node		- Index of the node to check; advanced past the node and its operands
+//	numvalues	- Number of In node values
+//	numcolumns	- Number of columns
+
+static bool check_filter(filter_node_t const* nodes, size_t numnodes, size_t& node, size_t numvalues, size_t numcolumns)
+{
+	if(node >= numnodes) return false;
+
+	filter_node_t const& current = nodes[node++];
+	switch(current.opcode) {
+
+		case filter_and:
+		case filter_or:
+			for(uint32_t index = 0; index < current.count; index++)
+				if(!check_filter(nodes, numnodes, node, numvalues, numcolumns)) return false;
+			return true;
+
+		case filter_not:
+			return check_filter(nodes, numnodes, node, numvalues, numcolumns);
+
+		case filter_range:
+			return (current.column < numcolumns);
+
+		case filter_in:
+			return (current.column < numcolumns) && (current.values <= numvalues) && (current.count <= numvalues - current.values);
+	}
+
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// match_range (local)
+//
+// Matches a single word (64 rows) of a column against a range of values
+//
+// Arguments:
+//
+//	state		- Filter evaluation state
+//	column		- Column to be matched
+//	word		- Index of the word to be matched
+//	minimum		- Inclusive minimum value
+//	maximum		- Inclusive maximum value
+
+static uint64_t match_range(filter_state_t const& state, filter_column_t const& column, size_t word, int32_t minimum, int32_t maximum)
+{
+	// A single value that has a bitmap is a lookup rather than a comparison
+	if((minimum == maximum) && (column.bitmaps != nullptr) && (minimum >= 0) && (static_cast<size_t>(minimum) < column.numbitmaps))
+		return column.bitmaps[(static_cast<size_t>(minimum) * state.words) + word];
+
+	// The columns are padded out to a whole word, the kernel always compares 64 values
+	uint64_t mask = s_rangekernel(column.values + (word * 64), minimum, maximum);
+
+	return (column.valid != nullptr) ? (mask & column.valid[word]) : mask;
+}
+
+//---------------------------------------------------------------------------
+// evaluate_filter (local)
+//
+// Evaluates a filter node for a single word (64 rows) of the columns
+//
+// Arguments:
+//
+//	state		- Filter evaluation state
+//	node		- Index of the node to evaluate; advanced past the node and its operands
+//	word		- Index of the word to evaluate
+//	candidates	- Rows that still have to be evaluated
+
+static uint64_t evaluate_filter(filter_state_t const& state, size_t& node, size_t word, uint64_t candidates)
+{
+	filter_node_t const& current = state.nodes[node++];
+	uint64_t mask = 0;
+
+	switch(current.opcode) {
+
+		// Each operand only evaluates the rows that all of the previous operands matched; once there
+		// are none left the remaining operands are walked over without touching the columns
+		case filter_and:
+			mask = candidates;
+			for(uint32_t index = 0; index < current.count; index++) mask &= evaluate_filter(state, node, word, mask);
+			break;
+
+		// Each operand only evaluates the rows that none of the previous operands matched
+		case filter_or:
+			for(uint32_t index = 0; index < current.count; index++) mask |= evaluate_filter(state, node, word, candidates & ~mask);
+			break;
+
+		// NULL values never match a comparison, so they always match its negation
+		case filter_not:
+			mask = candidates & ~evaluate_filter(state, node, word, candidates);
+			break;
+
+		case filter_range:
+			if(candidates != 0) mask = candidates & match_range(state, state.columns[current.column], word, current.minimum, current.maximum);
+			break;
+
+		case filter_in:
+			if(candidates != 0) {
+
+				filter_column_t const& column = state.columns[current.column];
+				int32_t const* values = state.values + current.values;
+
+				for(uint32_t index = 0; (index < current.count) && ((mask & candidates) != candidates); index++)
+					mask |= match_range(state, column, word, values[index], values[index]);
+
+				mask &= candidates;
+			}
+			break;
+	}
+
+	return mask;
+}
+
+//---------------------------------------------------------------------------
+// filter_select
+//
+// Evaluates a filter against a set of columns and sets the bit of each matching row
+//
+// Arguments:
+//
+//	nodes		- Filter nodes, in prefix order; an empty filter matches every row
+//	numnodes	- Number of filter nodes
+//	values		- In node values
+//	numvalues	- Number of In node values
+//	columns		- Columns referenced by the filter nodes
+//	numcolumns	- Number of columns
+//	rows		- Number of rows in each column, excluding any padding
+//	mask		- On success, receives one bit per row in (rows + 63) / 64 words
+
+int filter_select(filter_node_t const* nodes, size_t numnodes, int32_t const* values, size_t numvalues, filter_column_t const* columns,
+	size_t numcolumns, size_t rows, uint64_t* mask)
+{
+	if(((nodes == nullptr) && (numnodes > 0)) || ((values == nullptr) && (numvalues > 0)) || ((columns == nullptr) && (numcolumns > 0))) return SQLITE_MISUSE;
+	if((mask == nullptr) && (rows > 0)) return SQLITE_MISUSE;
+
+	// The nodes have to describe exactly one complete expression
+	size_t node = 0;
+	if((numnodes > 0) && (!check_filter(nodes, numnodes, node, numvalues, numcolumns) || (node != numnodes))) return SQLITE_MISUSE;
+
+	filter_state_t state = { nodes, values, columns, (rows + 63) / 64 };
+
+	// The entire filter is evaluated for each word in turn, no intermediate bitmaps are
+	// created for the individual nodes and the column values are only read once
+	for(size_t word = 0; word < state.words; word++) {
+
+		// The padding at the end of the final word is never a candidate
+		uint64_t candidates = (((word + 1) * 64) <= rows) ? ~0ULL : ((1ULL << (rows % 64)) - 1);
+
+		node = 0;
+		mask[word] = (numnodes == 0) ? candidates : evaluate_filter(state, node, word, candidates);
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
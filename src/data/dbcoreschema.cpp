@@ -0,0 +1,599 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include <iterator>
+#include <new>
+#include <string>
+
+#include "dbcore.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::dbsfw::data::core {
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 0 -> VERSION 1
+//
+// Original database schema
+
+static char const* const schema_v1[] = {
+	// table: card
+	//
+	// cardid(pk) | type | color | rarity
+	"create table card(cardid text not null, type text not null, color text not null, rarity text not null, "
+		"primary key(cardid), "
+		"check(type in ('LEADER', 'BATTLE', 'EXTRA')), check(color in ('Red', 'Blue', 'Green', 'Yellow', 'Black')), "
+		"check(rarity in ('L', 'C', 'R', 'SR', 'SCR', 'PR')))",
+
+	// table: carddetail
+	//
+	// cardid(pk|fk) | side(pk) | language(pk) | name | cost | specifiedcost | power | combopower | traits | effect
+	"create table carddetail(cardid text not null, side text null, language text not null, name text not null, "
+		"cost integer null, specifiedcost text null, power integer null, combopower integer null, traits text null, effect text null, "
+		"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
+		"check(side in (null, 'FRONT', 'BACK')), check(language in('EN', 'JP')))",
+
+	// table: cardfaq
+	//
+	// cardid(pk|fk) | faqid(pk) | language(pk) | question | answer
+	"create table cardfaq(cardid text not null, faqid text not null, language text not null, question text not null, "
+		"answer text null, "
+		"primary key(cardid, faqid, language) foreign key(cardid) references card(cardid), "
+		"check(language in('EN', 'JP')))",
+
+	// table: cardfaqrelated
+	//
+	// cardid(pk|fk) | faqid(pk|fk) | language(pk|fk) | relatedcardid (pk)
+	"create table cardfaqrelated(cardid text not null, faqid text null, language text not null, relatedcardid text not null, "
+		"primary key(cardid, faqid, language, relatedcardid) foreign key(cardid, faqid, language) references cardfaq(cardid, faqid, language), "
+		"check(language in('EN', 'JP')))",
+
+	// table: cardimage
+	//
+	// cardid(pk|fk) | side(pk) | language(pk) | format | image
+	"create table cardimage(cardid text not null, side text null, language text not null, "
+		"format text not null, image blob not null, "
+		"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
+		"check(side in (null, 'FRONT', 'BACK')), check(language in ('EN', 'JP')))"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 1 -> VERSION 2
+//
+// Integer-coded type, color, rarity, side and language columns
+
+static char const* const schema_v2[] = {
+	// table: card
+	//
+	// cardid(pk) | type | color | rarity
+	"create table card_v2(cardid text not null, type integer not null, color integer not null, rarity integer not null, "
+		"primary key(cardid), "
+		"check(type between 1 and 3), check(color between 1 and 7), check(rarity between 1 and 7))",
+	"insert into card_v2 select cardid, cardtype(type), cardcolor(color), cardrarity(rarity) from card",
+
+	// table: carddetail
+	//
+	// cardid(pk|fk) | side(pk) | language(pk) | name | cost | specifiedcost | power | combopower | traits | effect
+	"create table carddetail_v2(cardid text not null, side integer not null, language integer not null, name text not null, "
+		"cost integer null, specifiedcost text null, power integer null, combopower integer null, traits text null, effect text null, "
+		"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
+		"check(side between 0 and 2), check(language between 1 and 2))",
+	"insert into carddetail_v2 select cardid, cardside(side), cardlanguage(language), name, cost, specifiedcost, "
+		"power, combopower, traits, effect from carddetail",
+
+	// table: cardfaq
+	//
+	// cardid(pk|fk) | faqid(pk) | language(pk) | question | answer
+	"create table cardfaq_v2(cardid text not null, faqid text not null, language integer not null, question text not null, "
+		"answer text null, "
+		"primary key(cardid, faqid, language) foreign key(cardid) references card(cardid), "
+		"check(language between 1 and 2))",
+	"insert into cardfaq_v2 select cardid, faqid, cardlanguage(language), question, answer from cardfaq",
+
+	// table: cardfaqrelated
+	//
+	// cardid(pk|fk) | faqid(pk|fk) | language(pk|fk) | relatedcardid (pk)
+	"create table cardfaqrelated_v2(cardid text not null, faqid text null, language integer not null, relatedcardid text not null, "
+		"primary key(cardid, faqid, language, relatedcardid) foreign key(cardid, faqid, language) references cardfaq(cardid, faqid, language), "
+		"check(language between 1 and 2))",
+	"insert into cardfaqrelated_v2 select cardid, faqid, cardlanguage(language), relatedcardid from cardfaqrelated",
+
+	// table: cardimage
+	//
+	// cardid(pk|fk) | side(pk) | language(pk) | format | image
+	"create table cardimage_v2(cardid text not null, side integer not null, language integer not null, "
+		"format text not null, image blob not null, "
+		"primary key(cardid, side, language) foreign key(cardid) references card(cardid), "
+		"check(side between 0 and 2), check(language between 1 and 2))",
+	"insert into cardimage_v2 select cardid, cardside(side), cardlanguage(language), format, image from cardimage",
+
+	// Replace the original tables with the rebuilt tables
+	"drop table cardfaqrelated",
+	"drop table cardfaq",
+	"drop table cardimage",
+	"drop table carddetail",
+	"drop table card",
+	"alter table card_v2 rename to card",
+	"alter table carddetail_v2 rename to carddetail",
+	"alter table cardfaq_v2 rename to cardfaq",
+	"alter table cardfaqrelated_v2 rename to cardfaqrelated",
+	"alter table cardimage_v2 rename to cardimage",
+
+	// view: cardtext
+	//
+	// cardid | type | color | rarity
+	"create view cardtext as select cardid, cardtypename(type) as type, cardcolorname(color) as color, "
+		"cardrarityname(rarity) as rarity from card",
+
+	// view: carddetailtext
+	//
+	// cardid | side | language | name | cost | specifiedcost | power | combopower | traits | effect
+	"create view carddetailtext as select cardid, cardsidename(side) as side, cardlanguagename(language) as language, "
+		"name, cost, specifiedcost, power, combopower, traits, effect from carddetail",
+
+	// view: cardfaqtext
+	//
+	// cardid | faqid | language | question | answer
+	"create view cardfaqtext as select cardid, faqid, cardlanguagename(language) as language, question, answer from cardfaq",
+
+	// view: cardfaqrelatedtext
+	//
+	// cardid | faqid | language | relatedcardid
+	"create view cardfaqrelatedtext as select cardid, faqid, cardlanguagename(language) as language, relatedcardid "
+		"from cardfaqrelated",
+
+	// view: cardimagetext
+	//
+	// cardid | side | language | format | image
+	"create view cardimagetext as select cardid, cardsidename(side) as side, cardlanguagename(language) as language, "
+		"format, image from cardimage"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 2 -> VERSION 3
+//
+// Full-text search indexes over card details and FAQs
+
+static char const* const schema_v3[] = {
+	// table: carddetailsearch
+	//
+	// External content FTS5 index over carddetail; name, traits and effect are indexed, the
+	// key columns are retrieved from the content table to allow filtering by side and language
+	"create virtual table carddetailsearch using fts5(cardid unindexed, side unindexed, language unindexed, "
+		"name, traits, effect, content='carddetail', content_rowid='rowid', tokenize='unicode61 remove_diacritics 2')",
+
+	// Rank matches on the card name ahead of traits and traits ahead of the effect text
+	"insert into carddetailsearch(carddetailsearch, rank) values('rank', 'bm25(0.0, 0.0, 0.0, 10.0, 5.0, 1.0)')",
+
+	"create trigger carddetailsearch_insert after insert on carddetail begin "
+		"insert into carddetailsearch(rowid, cardid, side, language, name, traits, effect) "
+		"values(new.rowid, new.cardid, new.side, new.language, new.name, new.traits, new.effect); end",
+	"create trigger carddetailsearch_delete after delete on carddetail begin "
+		"insert into carddetailsearch(carddetailsearch, rowid, cardid, side, language, name, traits, effect) "
+		"values('delete', old.rowid, old.cardid, old.side, old.language, old.name, old.traits, old.effect); end",
+	"create trigger carddetailsearch_update after update on carddetail begin "
+		"insert into carddetailsearch(carddetailsearch, rowid, cardid, side, language, name, traits, effect) "
+		"values('delete', old.rowid, old.cardid, old.side, old.language, old.name, old.traits, old.effect); "
+		"insert into carddetailsearch(rowid, cardid, side, language, name, traits, effect) "
+		"values(new.rowid, new.cardid, new.side, new.language, new.name, new.traits, new.effect); end",
+
+	// table: cardfaqsearch
+	//
+	// External content FTS5 index over cardfaq; question and answer are indexed
+	"create virtual table cardfaqsearch using fts5(cardid unindexed, faqid unindexed, language unindexed, "
+		"question, answer, content='cardfaq', content_rowid='rowid', tokenize='unicode61 remove_diacritics 2')",
+
+	// Rank matches on the question ahead of the answer
+	"insert into cardfaqsearch(cardfaqsearch, rank) values('rank', 'bm25(0.0, 0.0, 0.0, 2.0, 1.0)')",
+
+	"create trigger cardfaqsearch_insert after insert on cardfaq begin "
+		"insert into cardfaqsearch(rowid, cardid, faqid, language, question, answer) "
+		"values(new.rowid, new.cardid, new.faqid, new.language, new.question, new.answer); end",
+	"create trigger cardfaqsearch_delete after delete on cardfaq begin "
+		"insert into cardfaqsearch(cardfaqsearch, rowid, cardid, faqid, language, question, answer) "
+		"values('delete', old.rowid, old.cardid, old.faqid, old.language, old.question, old.answer); end",
+	"create trigger cardfaqsearch_update after update on cardfaq begin "
+		"insert into cardfaqsearch(cardfaqsearch, rowid, cardid, faqid, language, question, answer) "
+		"values('delete', old.rowid, old.cardid, old.faqid, old.language, old.question, old.answer); "
+		"insert into cardfaqsearch(rowid, cardid, faqid, language, question, answer) "
+		"values(new.rowid, new.cardid, new.faqid, new.language, new.question, new.answer); end",
+
+	// Index the existing content
+	"insert into carddetailsearch(carddetailsearch) values('rebuild')",
+	"insert into cardfaqsearch(cardfaqsearch) values('rebuild')"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 3 -> VERSION 4
+//
+// Full-text search indexes use the cjk tokenizer
+
+static char const* const schema_v4[] = {
+	// The tokenizer of an FTS5 table can't be altered; the tables are recreated with the same
+	// names, which leaves the synchronization triggers on the content tables intact
+	"drop table carddetailsearch",
+	"drop table cardfaqsearch",
+
+	// table: carddetailsearch
+	//
+	"create virtual table carddetailsearch using fts5(cardid unindexed, side unindexed, language unindexed, "
+		"name, traits, effect, content='carddetail', content_rowid='rowid', tokenize='cjk')",
+	"insert into carddetailsearch(carddetailsearch, rank) values('rank', 'bm25(0.0, 0.0, 0.0, 10.0, 5.0, 1.0)')",
+
+	// table: cardfaqsearch
+	//
+	"create virtual table cardfaqsearch using fts5(cardid unindexed, faqid unindexed, language unindexed, "
+		"question, answer, content='cardfaq', content_rowid='rowid', tokenize='cjk')",
+	"insert into cardfaqsearch(cardfaqsearch, rank) values('rank', 'bm25(0.0, 0.0, 0.0, 2.0, 1.0)')",
+
+	// Index the existing content
+	"insert into carddetailsearch(carddetailsearch) values('rebuild')",
+	"insert into cardfaqsearch(cardfaqsearch) values('rebuild')"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 4 -> VERSION 5
+//
+// Keyword index extracted from the bracketed tags in the effect text
+
+static char const* const schema_v5[] = {
+	// table: keyword
+	//
+	// keywordid(pk) | name
+	"create table keyword(keywordid integer not null, name text not null, "
+		"primary key(keywordid), unique(name))",
+	"insert into keyword values(1, 'On Play'), (2, 'Activate Main'), (3, 'Activate Battle'), "
+		"(4, 'When Attacking'), (5, 'When Blocking'), (6, 'When KO''d'), (7, 'Permanent'), (8, 'Auto'), (9, 'Field'), "
+		"(10, 'Once per turn'), (11, 'Your Turn'), (12, 'Opponent''s Turn'), (13, 'End of Your Turn'), (14, 'Blocker'), "
+		"(15, 'Critical'), (16, 'Double Strike'), (17, 'Barrier'), (18, 'Awaken'), (19, 'Super Combo')",
+
+	// table: keywordalias
+	//
+	// language(pk) | alias(pk) | keywordid(fk)
+	//
+	// Maps the tag text as it appears in each language onto the canonical keyword; "Battle" and its
+	// Japanese equivalent are the second half of the compound [Activate Main/Battle] tag
+	"create table keywordalias(language integer not null, alias text not null, keywordid integer not null, "
+		"primary key(language, alias) foreign key(keywordid) references keyword(keywordid), "
+		"check(language between 1 and 2))",
+	"insert into keywordalias select 1, name, keywordid from keyword",
+	u8"insert into keywordalias values(1, 'Battle', 3), (1, 'Opponent&#039;s Turn', 12), "
+		u8"(2, '\u767B\u5834\u6642', 1), "			// On Play
+		u8"(2, '\u8D77\u52D5 \u30E1\u30A4\u30F3', 2), "	// Activate Main
+		u8"(2, '\u8D77\u52D5 \u6226\u95D8\u4E2D', 3), "	// Activate Battle
+		u8"(2, '\u6226\u95D8\u4E2D', 3), "			// Activate Battle (compound tag suffix)
+		u8"(2, '\u30A2\u30BF\u30C3\u30AF\u6642', 4), "	// When Attacking
+		u8"(2, '\u30D6\u30ED\u30C3\u30AF\u6642', 5), "	// When Blocking
+		u8"(2, 'KO\u6642', 6), "						// When KO'd
+		u8"(2, '\u6C38\u7D9A', 7), "					// Permanent
+		u8"(2, '\u81EA\u52D5', 8), "					// Auto
+		u8"(2, '\u30D5\u30A3\u30FC\u30EB\u30C9', 9), "	// Field
+		u8"(2, '\u30BF\u30FC\u30F31\u56DE', 10), "	// Once per turn
+		u8"(2, '\u81EA\u5206\u306E\u30BF\u30FC\u30F3\u4E2D', 11), "	// Your Turn
+		u8"(2, '\u76F8\u624B\u306E\u30BF\u30FC\u30F3\u4E2D', 12), "	// Opponent's Turn
+		u8"(2, '\u81EA\u5206\u306E\u30BF\u30FC\u30F3\u7D42\u4E86\u6642', 13), "	// End of Your Turn
+		u8"(2, '\u30D6\u30ED\u30C3\u30AB\u30FC', 14), "	// Blocker
+		u8"(2, '\u30AF\u30EA\u30C6\u30A3\u30AB\u30EB', 15), "	// Critical
+		u8"(2, '\u30C0\u30D6\u30EB\u30B9\u30C8\u30E9\u30A4\u30AF', 16), "	// Double Strike
+		u8"(2, '\u30D0\u30EA\u30A2', 17), "			// Barrier
+		u8"(2, '\u899A\u9192', 18), "					// Awaken
+		u8"(2, '\u30B9\u30FC\u30D1\u30FC\u30B3\u30F3\u30DC', 19)",	// Super Combo
+
+	// table: carddetailkeyword
+	//
+	// cardid(pk|fk) | side(pk|fk) | language(pk|fk) | keywordid(pk|fk)
+	"create table carddetailkeyword(cardid text not null, side integer not null, language integer not null, "
+		"keywordid integer not null, "
+		"primary key(cardid, side, language, keywordid) "
+		"foreign key(cardid, side, language) references carddetail(cardid, side, language) on delete cascade "
+		"foreign key(keywordid) references keyword(keywordid))",
+	"create index carddetailkeyword_keywordid on carddetailkeyword(keywordid, cardid, side, language)",
+
+	// view: carddetailkeywordtext
+	//
+	// cardid | side | language | keyword
+	"create view carddetailkeywordtext as select detailkeyword.cardid, cardsidename(detailkeyword.side) as side, "
+		"cardlanguagename(detailkeyword.language) as language, keyword.name as keyword from carddetailkeyword as detailkeyword "
+		"inner join keyword using(keywordid)",
+
+	// Extract the keywords from the existing effect text; unrecognized tags are ignored
+	"insert or ignore into carddetailkeyword select detail.cardid, detail.side, detail.language, alias.keywordid "
+		"from carddetail as detail, effecttags(detail.effect) as tag "
+		"inner join keywordalias as alias on alias.language = detail.language and alias.alias = tag.tag "
+		"where detail.effect is not null"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 5 -> VERSION 6
+//
+// Trait index split from the slash-delimited traits text
+
+static char const* const schema_v6[] = {
+	// table: carddetailtrait
+	//
+	// cardid(pk|fk) | side(pk|fk) | language(pk|fk) | ordinal(pk) | trait
+	//
+	// carddetail.traits remains the source of the text; the ordinal preserves the position of
+	// each trait so that joining the rows with '/' reproduces it exactly
+	"create table carddetailtrait(cardid text not null, side integer not null, language integer not null, "
+		"ordinal integer not null, trait text not null, "
+		"primary key(cardid, side, language, ordinal) "
+		"foreign key(cardid, side, language) references carddetail(cardid, side, language) on delete cascade)",
+	"create index carddetailtrait_trait on carddetailtrait(trait, language, cardid, side)",
+
+	// view: carddetailtraittext
+	//
+	// cardid | side | language | ordinal | trait
+	"create view carddetailtraittext as select cardid, cardsidename(side) as side, "
+		"cardlanguagename(language) as language, ordinal, trait from carddetailtrait",
+
+	// Split the existing traits text
+	"with recursive split(cardid, side, language, ordinal, trait, remaining) as ("
+		"select cardid, side, language, -1, null, traits || '/' from carddetail where traits is not null "
+		"union all select cardid, side, language, ordinal + 1, substr(remaining, 1, instr(remaining, '/') - 1), "
+		"substr(remaining, instr(remaining, '/') + 1) from split where remaining <> '') "
+		"insert into carddetailtrait select cardid, side, language, ordinal, trait from split where ordinal >= 0"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 6 -> VERSION 7
+//
+// Perceptual hashes of the card images
+
+static char const* const schema_v7[] = {
+	// table: cardimage
+	//
+	// cardid(pk|fk) | side(pk) | language(pk) | format | image | phash
+	"alter table cardimage add column phash integer null",
+	"update cardimage set phash = webpphash(image) where format = 'image/webp'"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 7 -> VERSION 8
+//
+// Precomputed reduced-width variants of the card images
+
+static char const* const schema_v8[] = {
+	// table: cardimagevariant
+	//
+	// cardid(pk|fk) | side(pk|fk) | language(pk|fk) | width(pk) | height | format | image
+	"create table cardimagevariant(cardid text not null, side integer not null, language integer not null, "
+		"width integer not null, height integer not null, format text not null, image blob not null, "
+		"primary key(cardid, side, language, width) foreign key(cardid, side, language) references cardimage(cardid, side, language) on delete cascade, "
+		"check(width > 0), check(height > 0))"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 8 -> VERSION 9
+//
+// Covering indexes for the reverse related card and card name lookups
+
+static char const* const schema_v9[] = {
+	// index: cardfaqrelated_relatedcardid
+	//
+	// relatedcardid | language | cardid | faqid
+	"create index cardfaqrelated_relatedcardid on cardfaqrelated(relatedcardid, language, cardid, faqid)",
+
+	// index: carddetail_language_name
+	//
+	// language | name | cardid | side
+	"create index carddetail_language_name on carddetail(language, name, cardid, side)"
+};
+
+//---------------------------------------------------------------------------
+// SCHEMA VERSION 9 -> VERSION 10
+//
+// Case-insensitive keyword aliases
+
+static char const* const schema_v10[] = {
+	// table: keywordalias
+	//
+	// language(pk) | alias(pk) | keywordid(fk)
+	//
+	// The tag text is not consistently capitalized ([Once per turn] and [Once Per Turn]); the
+	// NOCASE collation only folds ASCII, which leaves the Japanese aliases unaffected
+	"create table keywordalias_v10(language integer not null, alias text not null collate nocase, keywordid integer not null, "
+		"primary key(language, alias) foreign key(keywordid) references keyword(keywordid), "
+		"check(language between 1 and 2))",
+	"insert into keywordalias_v10 select language, alias, keywordid from keywordalias",
+	"drop table keywordalias",
+	"alter table keywordalias_v10 rename to keywordalias",
+
+	// Extract any keywords from the existing effect text that were missed by the case-sensitive aliases
+	"insert or ignore into carddetailkeyword select detail.cardid, detail.side, detail.language, alias.keywordid "
+		"from carddetail as detail, effecttags(detail.effect) as tag "
+		"inner join keywordalias as alias on alias.language = detail.language and alias.alias = tag.tag "
+		"where detail.effect is not null"
+};
+
+//---------------------------------------------------------------------------
+// migration_t (local)
+//
+// A single schema migration step; the statements are executed in order within
+// one transaction that also sets the user_version to the new schema version
+struct migration_t {
+
+	int						version;		// Schema version after the step
+	char const*				description;	// Description of the step
+	bool					foreignkeys;	// Flag if foreign keys are enforced
+	char const* const*		statements;		// Statements to be executed
+	size_t					count;			// Number of statements
+};
+
+//---------------------------------------------------------------------------
+// migrations (local)
+//
+// The ordered schema migration steps; new steps are only ever appended and
+// schema_version must be updated to match the last step.  Foreign keys are not
+// enforced while a step rebuilds and replaces a referenced table, the result
+// is validated with pragma foreign_key_check before the step is committed
+static constexpr migration_t migrations[] = {
+
+	{ 1, "Original database schema", true, schema_v1, std::size(schema_v1) },
+	{ 2, "Integer-coded type, color, rarity, side and language columns", false, schema_v2, std::size(schema_v2) },
+	{ 3, "Full-text search indexes over card details and FAQs", true, schema_v3, std::size(schema_v3) },
+	{ 4, "Full-text search indexes use the cjk tokenizer", true, schema_v4, std::size(schema_v4) },
+	{ 5, "Keyword index extracted from the bracketed tags in the effect text", true, schema_v5, std::size(schema_v5) },
+	{ 6, "Trait index split from the slash-delimited traits text", true, schema_v6, std::size(schema_v6) },
+	{ 7, "Perceptual hashes of the card images", true, schema_v7, std::size(schema_v7) },
+	{ 8, "Precomputed reduced-width variants of the card images", true, schema_v8, std::size(schema_v8) },
+	{ 9, "Covering indexes for the reverse related card and card name lookups", true, schema_v9, std::size(schema_v9) },
+	{ 10, "Case-insensitive keyword aliases", true, schema_v10, std::size(schema_v10) },
+};
+
+static_assert(migrations[std::size(migrations) - 1].version == schema_version, "schema_version does not match the last migration step");
+
+//---------------------------------------------------------------------------
+// execute_scalar_int (local)
+//
+// Executes a query that returns a single integer value
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	sql				- SQL query to execute
+//	value			- On success, receives the value of the first column of the first row
+
+static int execute_scalar_int(sqlite3* instance, char const* sql, int* value)
+{
+	sqlite3_stmt* statement = nullptr;
+
+	int result = sqlite3_prepare_v2(instance, sql, -1, &statement, nullptr);
+	if(result == SQLITE_OK) {
+
+		result = sqlite3_step(statement);
+		if(result == SQLITE_ROW) { *value = sqlite3_column_int(statement, 0); result = SQLITE_OK; }
+		else if(result == SQLITE_DONE) result = SQLITE_EMPTY;
+	}
+
+	sqlite3_finalize(statement);
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// apply_migration (local)
+//
+// Applies a single schema migration step in its own transaction
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	migration		- Schema migration step to apply
+//	errmsg			- On failure, receives the error message (see upgrade_database)
+
+static int apply_migration(sqlite3* instance, migration_t const& migration, char** errmsg)
+{
+	int foreignkeys = 0;
+
+	// Foreign key enforcement can't be changed within a transaction; the original
+	// setting is restored after the step whether or not it succeeds
+	int result = execute_scalar_int(instance, "pragma foreign_keys", &foreignkeys);
+	if((result == SQLITE_OK) && foreignkeys && !migration.foreignkeys) result = execute_non_query(instance, "pragma foreign_keys=OFF", nullptr);
+	if(result != SQLITE_OK) return result;
+
+	result = execute_non_query(instance, "begin immediate transaction", nullptr);
+
+	for(size_t index = 0; (result == SQLITE_OK) && (index < migration.count); index++)
+		result = execute_non_query(instance, migration.statements[index], nullptr);
+
+	// The rebuilt tables must not have introduced any foreign key violations
+	if((result == SQLITE_OK) && !migration.foreignkeys) {
+
+		int violations = 0;
+		result = execute_scalar_int(instance, "select count(*) from pragma_foreign_key_check", &violations);
+		if((result == SQLITE_OK) && (violations != 0)) {
+
+			if(errmsg) *errmsg = sqlite3_mprintf("schema version %d migration failed foreign key validation", migration.version);
+			result = SQLITE_CONSTRAINT_FOREIGNKEY;
+		}
+	}
+
+	if(result == SQLITE_OK) result = execute_non_query(instance, ("pragma user_version = " + std::to_string(migration.version)).c_str(), nullptr);
+	if(result == SQLITE_OK) result = execute_non_query(instance, "commit transaction", nullptr);
+
+	if(result != SQLITE_OK) {
+
+		// The error message has to be captured before the rollback replaces it
+		if(errmsg && (*errmsg == nullptr)) *errmsg = sqlite3_mprintf("schema version %d migration failed: %s", migration.version, sqlite3_errmsg(instance));
+		if(!sqlite3_get_autocommit(instance)) execute_non_query(instance, "rollback transaction", nullptr);
+	}
+
+	if(foreignkeys && !migration.foreignkeys) {
+
+		int restored = execute_non_query(instance, "pragma foreign_keys=ON", nullptr);
+		if(result == SQLITE_OK) result = restored;
+	}
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// upgrade_database
+//
+// Applies the schema migration steps required to bring the database up to
+// schema_version; each step is committed separately so a failed step leaves
+// the database at the schema version of the last step that succeeded
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	errmsg			- Optional; on failure receives an error message that must
+//					  be released with sqlite3_free()
+
+int upgrade_database(sqlite3* instance, char** errmsg)
+{
+	int dbversion = 0;
+
+	if(instance == nullptr) return SQLITE_MISUSE;
+	if(errmsg) *errmsg = nullptr;
+
+	try {
+
+		int result = execute_scalar_int(instance, "pragma user_version", &dbversion);
+		if(result != SQLITE_OK) return result;
+
+		// A database created by a newer version of the library can't be opened
+		if(dbversion > schema_version) {
+
+			if(errmsg) *errmsg = sqlite3_mprintf("schema version %d is newer than the supported schema version %d", dbversion, schema_version);
+			return SQLITE_ERROR;
+		}
+
+		for(auto const& migration : migrations) {
+
+			if(migration.version <= dbversion) continue;
+
+			result = apply_migration(instance, migration, errmsg);
+			if(result != SQLITE_OK) return result;
+		}
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+
+}
+
+#pragma warning(pop)
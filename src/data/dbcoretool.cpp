@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2025 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dbcore.h"
+
+using namespace zuki::dbsfw::data;
+
+//---------------------------------------------------------------------------
+// print_progress (local)
+//
+// Progress callback that writes the status text to stderr
+//
+// Arguments:
+//
+//	context		- Unused
+//	completed	- Number of completed steps
+//	total		- Total number of steps
+//	status		- Status text
+
+static bool print_progress(void*, int64_t completed, int64_t total, char const* status)
+{
+	fprintf(stderr, "[%lld/%lld] %s\n", static_cast<long long>(completed), static_cast<long long>(total), (status) ? status : "");
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// print_row (local)
+//
+// Row callback that writes each result row to stdout separated by '|'
+//
+// Arguments:
+//
+//	context		- Unused
+//	statement	- Statement positioned on the current row
+
+static bool print_row(void*, sqlite3_stmt* statement)
+{
+	int columns = sqlite3_column_count(statement);
+	for(int index = 0; index < columns; index++) {
+
+		char const* text = reinterpret_cast<char const*>(sqlite3_column_text(statement, index));
+		printf("%s%s", (index > 0) ? "|" : "", (text) ? text : "");
+	}
+
+	printf("\n");
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// usage (local)
+//
+// Writes the command line usage to stderr
+//
+// Arguments:
+//
+//	NONE
+
+static int usage(void)
+{
+	fprintf(stderr, "usage: dbcoretool create <database>\n");
+	fprintf(stderr, "       dbcoretool execute <database> <sql>\n");
+	fprintf(stderr, "       dbcoretool export <database> <path>\n");
+	fprintf(stderr, "       dbcoretool import <database> <path>\n");
+	fprintf(stderr, "       dbcoretool query <database> <sql>\n");
+	fprintf(stderr, "       dbcoretool vacuum <database>\n");
+	return 2;
+}
+
+//---------------------------------------------------------------------------
+// main
+//
+// Command line front end for the portable database core
+//
+// Arguments:
+//
+//	argc		- Number of command line arguments
+//	argv		- Command line arguments
+
+int main(int argc, char** argv)
+{
+	if(argc < 3) return usage();
+
+	char const* command = argv[1];
+	bool readonly = (strcmp(command, "export") == 0) || (strcmp(command, "query") == 0);
+
+	if((strcmp(command, "create") == 0) && (argc != 3)) return usage();
+	else if((strcmp(command, "execute") == 0) && (argc != 4)) return usage();
+	else if((strcmp(command, "export") == 0) && (argc != 4)) return usage();
+	else if((strcmp(command, "import") == 0) && (argc != 4)) return usage();
+	else if((strcmp(command, "query") == 0) && (argc != 4)) return usage();
+	else if((strcmp(command, "vacuum") == 0) && (argc != 3)) return usage();
+	else if(!readonly && (strcmp(command, "create") != 0) && (strcmp(command, "execute") != 0) && (strcmp(command, "import") != 0) && 
+		(strcmp(command, "vacuum") != 0)) return usage();
+
+	int result = core::initialize();
+	if(result != SQLITE_OK) { fprintf(stderr, "dbcoretool: unable to initialize (%d)\n", result); return 1; }
+
+	sqlite3* instance = nullptr;
+	char* errmsg = nullptr;
+	result = core::open_database(argv[2], (readonly) ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, &instance);
+
+	if(result == SQLITE_OK) {
+
+		if(strcmp(command, "create") == 0) result = core::upgrade_database(instance, &errmsg);
+		else if(strcmp(command, "execute") == 0) result = core::execute_non_query(instance, argv[3], nullptr);
+		else if(strcmp(command, "export") == 0) result = core::export_database(instance, argv[3], print_progress, nullptr);
+		else if(strcmp(command, "import") == 0) {
+
+			// The variant widths are the same as the default widths of Database::Import()
+			static int const widths[] = { 150, 300 };
+
+			result = core::upgrade_database(instance, &errmsg);
+			if(result == SQLITE_OK) result = core::import_database(instance, argv[3], widths, sizeof(widths) / sizeof(widths[0]), print_progress, nullptr, &errmsg);
+			if(result == SQLITE_OK) result = core::vacuum(instance);
+		}
+		else if(strcmp(command, "query") == 0) result = core::query(instance, argv[3], print_row, nullptr);
+		else if(strcmp(command, "vacuum") == 0) result = core::vacuum(instance);
+	}
+
+	if(result != SQLITE_OK) fprintf(stderr, "dbcoretool: %s (%d)\n", (errmsg) ? errmsg : (instance) ? sqlite3_errmsg(instance) : sqlite3_errstr(result), result);
+	sqlite3_free(errmsg);
+
+	sqlite3_close(instance);
+	return (result == SQLITE_OK) ? 0 : 1;
+}
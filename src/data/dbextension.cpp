@@ -22,196 +22,2398 @@
 
 #include "stdafx.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <memory>
+#include <new>
 #include <rpc.h>
 #include <sqlite3ext.h>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "align.h"
-#include "CardType.h"
+#include "carray.h"
+#include "dbcore.h"
 
-// RapidJSON tries to use intrinsics that cause warnings when compiled with
-// CLR support; performance isn't necessary here so get rid of them
-#pragma push_macro("_MSC_VER")
-#undef _MSC_VER
-#include <rapidjson/document.h>
-#include <rapidjson/prettywriter.h>
-#pragma pop_macro("_MSC_VER")
+#include "webp\decode.h"
+
+extern "C" { SQLITE_EXTENSION_INIT1 };
+
+using namespace zuki::dbsfw::data;
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// cardfiles virtual table
+//
+// Read-only virtual table that exposes the flat-file card corpus created by
+// Database::Export as rows without staging it into a database first:
+//
+//	create virtual table src using cardfiles('database/card')
+//	select * from cardfiles('database/card')
+//
+// cardid | size | mtime | document | directory (hidden)
+//
+// The directory enumeration only touches file metadata; the document column
+// is read through a memory mapping only when a query actually requests it
+
+// cardfiles_columns
+//
+// Column ordinals for the cardfiles virtual table
+enum cardfiles_columns {
+
+	cardfiles_cardid = 0,
+	cardfiles_size,
+	cardfiles_mtime,
+	cardfiles_document,
+	cardfiles_directory,
+};
+
+// cardfiles_idxnum
+//
+// Bitmask of the constraints passed from xBestIndex to xFilter
+enum cardfiles_idxnum {
+
+	cardfiles_scan = 0x00,
+	cardfiles_cardid_eq = 0x01,
+	cardfiles_directory_eq = 0x02,
+};
+
+// cardfiles_vtab
+//
+// Virtual table instance
+struct cardfiles_vtab : public sqlite3_vtab {
+
+	std::wstring		directory;			// Default directory from CREATE
+};
+
+// cardfiles_cursor
+//
+// Virtual table cursor instance
+struct cardfiles_cursor : public sqlite3_vtab_cursor {
+
+	std::wstring		directory;			// Directory being enumerated
+	HANDLE				find = INVALID_HANDLE_VALUE;	// Find handle
+	WIN32_FIND_DATAW	data = {};			// Current file information
+	sqlite3_int64		rowid = 0;			// Current row identifier
+	bool				eof = true;			// End of file flag
+};
+
+// cardfiles_suffix
+//
+// The file extension applied to each card file
+static wchar_t const cardfiles_suffix[] = L".json";
+static size_t const cardfiles_suffixlen = _countof(cardfiles_suffix) - 1;
+
+//---------------------------------------------------------------------------
+// cardfiles_fullpath (local)
+//
+// Canonicalizes a directory path for the cardfiles virtual table
+//
+// Arguments:
+//
+//	path		- UTF-16 directory path; may be relative to the process
+
+static std::wstring cardfiles_fullpath(wchar_t const* path)
+{
+	if((path == nullptr) || (*path == L'\0')) return std::wstring();
+
+	DWORD cch = GetFullPathNameW(path, 0, nullptr, nullptr);
+	if(cch == 0) return std::wstring();
+
+	std::wstring fullpath(cch, L'\0');
+	cch = GetFullPathNameW(path, cch, fullpath.data(), nullptr);
+	fullpath.resize(cch);
+
+	// Trim any trailing path separator so that names can be appended directly
+	while((fullpath.length() > 3) && ((fullpath.back() == L'\\') || (fullpath.back() == L'/'))) fullpath.pop_back();
+
+	return fullpath;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_iscardfile (local)
+//
+// Determines if a WIN32_FIND_DATA describes a card file
+//
+// Arguments:
+//
+//	data		- Find data to be checked
+
+static bool cardfiles_iscardfile(WIN32_FIND_DATAW const& data)
+{
+	if((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == FILE_ATTRIBUTE_DIRECTORY) return false;
+
+	size_t length = wcslen(data.cFileName);
+	return (length > cardfiles_suffixlen) && (_wcsicmp(&data.cFileName[length - cardfiles_suffixlen], cardfiles_suffix) == 0);
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_connect (local)
+//
+// Creates or connects to a cardfiles virtual table
+//
+// Arguments:
+//
+//	db			- SQLite database instance
+//	aux			- Client data pointer from sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments; argv[3] is the optional directory
+//	vtab		- On success receives the virtual table instance
+//	errmsg		- On failure receives the error message
+
+static int cardfiles_connect(sqlite3* db, void* /*aux*/, int argc, char const* const* argv, sqlite3_vtab** vtab, char** errmsg)
+{
+	*vtab = nullptr;
+
+	if(argc > 4) { *errmsg = sqlite3_mprintf("cardfiles: too many arguments"); return SQLITE_ERROR; }
+
+	int result = sqlite3_declare_vtab(db, "create table cardfiles(cardid text, size integer, mtime integer, document text, directory hidden)");
+	if(result != SQLITE_OK) return result;
+
+	try {
+
+		std::unique_ptr<cardfiles_vtab> instance = std::make_unique<cardfiles_vtab>();
+
+		// The optional module argument is the default directory; strip any SQL quoting
+		if(argc == 4) {
+
+			std::string arg(argv[3]);
+			if((arg.length() >= 2) && ((arg.front() == '\'') || (arg.front() == '"')) && (arg.back() == arg.front()))
+				arg = arg.substr(1, arg.length() - 2);
+
+			int cch = MultiByteToWideChar(CP_UTF8, 0, arg.c_str(), -1, nullptr, 0);
+			std::wstring wide(std::max(cch, 1), L'\0');
+			MultiByteToWideChar(CP_UTF8, 0, arg.c_str(), -1, wide.data(), cch);
+
+			instance->directory = cardfiles_fullpath(wide.c_str());
+		}
+
+		sqlite3_vtab_config(db, SQLITE_VTAB_DIRECTONLY);
+
+		*vtab = instance.release();
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_disconnect (local)
+//
+// Disconnects from a cardfiles virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int cardfiles_disconnect(sqlite3_vtab* vtab)
+{
+	delete static_cast<cardfiles_vtab*>(vtab);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_bestindex (local)
+//
+// Determines the best query plan for a cardfiles virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int cardfiles_bestindex(sqlite3_vtab* vtab, sqlite3_index_info* info)
+{
+	int cardidindex = -1;					// Index of the cardid = ? constraint
+	int directoryindex = -1;				// Index of the directory = ? constraint
+
+	for(int index = 0; index < info->nConstraint; index++) {
+
+		auto const& constraint = info->aConstraint[index];
+		if(constraint.op != SQLITE_INDEX_CONSTRAINT_EQ) continue;
+
+		// An unusable directory constraint means the plan can't be used at all
+		if(constraint.iColumn == cardfiles_directory) {
+
+			if(!constraint.usable) return SQLITE_CONSTRAINT;
+			directoryindex = index;
+		}
+
+		else if((constraint.iColumn == cardfiles_cardid) && constraint.usable) cardidindex = index;
+	}
+
+	int argvindex = 1;
+	info->idxNum = cardfiles_scan;
+
+	if(directoryindex >= 0) {
+
+		info->aConstraintUsage[directoryindex].argvIndex = argvindex++;
+		info->aConstraintUsage[directoryindex].omit = 1;
+		info->idxNum |= cardfiles_directory_eq;
+	}
+
+	// A directory has to be specified by either the CREATE statement or the query
+	else if(static_cast<cardfiles_vtab*>(vtab)->directory.empty()) return SQLITE_CONSTRAINT;
+
+	if(cardidindex >= 0) {
+
+		// A cardid equality constraint is a single file probe rather than an enumeration
+		info->aConstraintUsage[cardidindex].argvIndex = argvindex++;
+		info->aConstraintUsage[cardidindex].omit = 1;
+		info->idxNum |= cardfiles_cardid_eq;
+		info->idxFlags = SQLITE_INDEX_SCAN_UNIQUE;
+		info->estimatedCost = 10.0;
+		info->estimatedRows = 1;
+	}
+
+	else {
+
+		info->estimatedCost = 100000.0;
+		info->estimatedRows = 10000;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_open (local)
+//
+// Opens a cursor against a cardfiles virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	cursor		- On success receives the cursor instance
+
+static int cardfiles_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
+{
+	*cursor = new(std::nothrow) cardfiles_cursor();
+	return (*cursor == nullptr) ? SQLITE_NOMEM : SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_close (local)
+//
+// Closes a cardfiles virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int cardfiles_close(sqlite3_vtab_cursor* cursor)
+{
+	cardfiles_cursor* instance = static_cast<cardfiles_cursor*>(cursor);
+
+	if(instance->find != INVALID_HANDLE_VALUE) FindClose(instance->find);
+	delete instance;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_next (local)
+//
+// Advances a cardfiles virtual table cursor to the next card file
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int cardfiles_next(sqlite3_vtab_cursor* cursor)
+{
+	cardfiles_cursor* instance = static_cast<cardfiles_cursor*>(cursor);
+
+	// Single file probes and exhausted enumerations are at end of file
+	if(instance->find == INVALID_HANDLE_VALUE) { instance->eof = true; return SQLITE_OK; }
+
+	do {
+
+		if(!FindNextFileW(instance->find, &instance->data)) {
+
+			FindClose(instance->find);
+			instance->find = INVALID_HANDLE_VALUE;
+			instance->eof = true;
+
+			return SQLITE_OK;
+		}
+
+	} while(!cardfiles_iscardfile(instance->data));
+
+	instance->rowid++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_filter (local)
+//
+// Begins a search of a cardfiles virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Constraint bitmask from xBestIndex
+//	idxstr		- Unused
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int cardfiles_filter(sqlite3_vtab_cursor* cursor, int idxnum, char const* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	cardfiles_cursor* instance = static_cast<cardfiles_cursor*>(cursor);
+	int argindex = 0;
+
+	// Reset the cursor state in case it's being reused
+	if(instance->find != INVALID_HANDLE_VALUE) FindClose(instance->find);
+	instance->find = INVALID_HANDLE_VALUE;
+	instance->rowid = 0;
+	instance->eof = true;
+
+	try {
+
+		// Use the directory constraint if present, otherwise the default from CREATE
+		if((idxnum & cardfiles_directory_eq) && (argindex < argc))
+			instance->directory = cardfiles_fullpath(reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[argindex++])));
+		else instance->directory = static_cast<cardfiles_vtab*>(cursor->pVtab)->directory;
+
+		if(instance->directory.empty()) return SQLITE_OK;
+
+		// cardid = ?: probe for the single file without enumerating the directory
+		if((idxnum & cardfiles_cardid_eq) && (argindex < argc)) {
+
+			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[argindex++]));
+			if((cardid == nullptr) || (*cardid == L'\0') || (wcspbrk(cardid, L"\\/:*?\"<>|") != nullptr)) return SQLITE_OK;
+
+			std::wstring filename = std::wstring(cardid) + cardfiles_suffix;
+			if(filename.length() >= _countof(instance->data.cFileName)) return SQLITE_OK;
+
+			WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+			if(!GetFileAttributesExW((instance->directory + L'\\' + filename).c_str(), GetFileExInfoStandard, &attributes)) return SQLITE_OK;
+
+			instance->data = {};
+			instance->data.dwFileAttributes = attributes.dwFileAttributes;
+			instance->data.ftLastWriteTime = attributes.ftLastWriteTime;
+			instance->data.nFileSizeHigh = attributes.nFileSizeHigh;
+			instance->data.nFileSizeLow = attributes.nFileSizeLow;
+			wcscpy_s(instance->data.cFileName, filename.c_str());
+
+			instance->eof = !cardfiles_iscardfile(instance->data);
+			return SQLITE_OK;
+		}
+
+		// Full scan: enumerate only the metadata of the card files in the directory
+		instance->find = FindFirstFileExW((instance->directory + L"\\*" + cardfiles_suffix).c_str(), FindExInfoBasic,
+			&instance->data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+		if(instance->find == INVALID_HANDLE_VALUE) return SQLITE_OK;
+
+		instance->eof = false;
+		return cardfiles_iscardfile(instance->data) ? SQLITE_OK : cardfiles_next(cursor);
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_eof (local)
+//
+// Determines if a cardfiles virtual table cursor is at end of file
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int cardfiles_eof(sqlite3_vtab_cursor* cursor)
+{
+	return static_cast<cardfiles_cursor*>(cursor)->eof ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_readdocument (local)
+//
+// Memory maps a card file and returns its contents as the document column;
+// the length is taken from the open handle rather than the enumerated size
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- SQLite context object
+
+static int cardfiles_readdocument(cardfiles_cursor* cursor, sqlite3_context* context)
+{
+	uint64_t enumsize = (static_cast<uint64_t>(cursor->data.nFileSizeHigh) << 32) | cursor->data.nFileSizeLow;
+
+	// Writers are not shared, so the size of the open file cannot change until the handle is closed
+	std::wstring filename = cursor->directory + L'\\' + cursor->data.cFileName;
+	HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(file == INVALID_HANDLE_VALUE) { sqlite3_result_null(context); return SQLITE_OK; }
+
+	LARGE_INTEGER size = {};
+	if(!GetFileSizeEx(file, &size)) { CloseHandle(file); sqlite3_result_null(context); return SQLITE_OK; }
+	uint64_t filesize = static_cast<uint64_t>(size.QuadPart);
+
+	// A file that was rewritten after the directory was enumerated would not match the size column
+	if(filesize != enumsize) {
+
+		CloseHandle(file);
+		sqlite3_result_error(context, "card file was modified during enumeration", -1);
+		return SQLITE_OK;
+	}
+
+	// Empty files cannot be mapped; SQLite text values are limited to a signed 32-bit length
+	if(filesize == 0) { CloseHandle(file); sqlite3_result_text(context, "", 0, SQLITE_STATIC); return SQLITE_OK; }
+	if(filesize > INT_MAX) { CloseHandle(file); sqlite3_result_error_toobig(context); return SQLITE_OK; }
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, size.HighPart, size.LowPart, nullptr);
+	CloseHandle(file);
+	if(mapping == nullptr) { sqlite3_result_null(context); return SQLITE_OK; }
+
+	void const* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if(view == nullptr) { sqlite3_result_null(context); return SQLITE_OK; }
+
+	// The files are UTF-8 encoded; skip a byte order mark if one is present
+	char const* text = reinterpret_cast<char const*>(view);
+	int length = static_cast<int>(filesize);
+	if((length >= 3) && (memcmp(text, "\xEF\xBB\xBF", 3) == 0)) { text += 3; length -= 3; }
+
+	sqlite3_result_text(context, text, length, SQLITE_TRANSIENT);
+	UnmapViewOfFile(view);
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_column (local)
+//
+// Returns a column value for the current cardfiles virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- SQLite context object
+//	ordinal		- Column ordinal
+
+static int cardfiles_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
+{
+	cardfiles_cursor* instance = static_cast<cardfiles_cursor*>(cursor);
+
+	try {
+
+		switch(ordinal) {
+
+			// cardid: the file name without the .json suffix
+			case cardfiles_cardid:
+				sqlite3_result_text16(context, instance->data.cFileName,
+					static_cast<int>((wcslen(instance->data.cFileName) - cardfiles_suffixlen) * sizeof(wchar_t)), SQLITE_TRANSIENT);
+				break;
+
+			// size: the length of the file in bytes
+			case cardfiles_size:
+				sqlite3_result_int64(context, static_cast<sqlite3_int64>((static_cast<uint64_t>(instance->data.nFileSizeHigh) << 32) | instance->data.nFileSizeLow));
+				break;
+
+			// mtime: the last write time of the file as a Unix timestamp
+			case cardfiles_mtime: {
+
+				ULARGE_INTEGER filetime = { { instance->data.ftLastWriteTime.dwLowDateTime, instance->data.ftLastWriteTime.dwHighDateTime } };
+				sqlite3_result_int64(context, static_cast<sqlite3_int64>((filetime.QuadPart - 116444736000000000ULL) / 10000000ULL));
+				break;
+			}
+
+			// document: the JSON contents of the file
+			case cardfiles_document:
+				return cardfiles_readdocument(instance, context);
+
+			// directory: the directory being enumerated
+			case cardfiles_directory:
+				sqlite3_result_text16(context, instance->directory.c_str(), -1, SQLITE_TRANSIENT);
+				break;
+		}
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+// cardfiles_rowid (local)
+//
+// Returns the rowid for the current cardfiles virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	rowid		- On success receives the rowid
+
+static int cardfiles_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+	*rowid = static_cast<cardfiles_cursor*>(cursor)->rowid;
+	return SQLITE_OK;
+}
+
+// cardfiles_module
+//
+// Module definition for the cardfiles virtual table
+static sqlite3_module cardfiles_module = {
+
+	0,						// iVersion
+	cardfiles_connect,		// xCreate
+	cardfiles_connect,		// xConnect
+	cardfiles_bestindex,	// xBestIndex
+	cardfiles_disconnect,	// xDisconnect
+	cardfiles_disconnect,	// xDestroy
+	cardfiles_open,			// xOpen
+	cardfiles_close,		// xClose
+	cardfiles_filter,		// xFilter
+	cardfiles_next,			// xNext
+	cardfiles_eof,			// xEof
+	cardfiles_column,		// xColumn
+	cardfiles_rowid,		// xRowid
+	nullptr,				// xUpdate
+	nullptr,				// xBegin
+	nullptr,				// xSync
+	nullptr,				// xCommit
+	nullptr,				// xRollback
+	nullptr,				// xFindFunction
+	nullptr,				// xRename
+	nullptr,				// xSavepoint
+	nullptr,				// xRelease
+	nullptr,				// xRollbackTo
+};
+
+// The carray table-valued function is compiled as native code; it's stepped
+// once for every value in the bound array
+#pragma managed(push, off)
+
+//---------------------------------------------------------------------------
+// carray virtual table
+//
+// Eponymous table-valued function that returns the strings of a carray_text
+// instance bound to a statement with sqlite3_bind_pointer(), allowing a set
+// of values to be bound as a single parameter:
+//
+//	select * from card where cardid in carray(?1)
+//
+// value | pointer (hidden)
+
+// carray_columns
+//
+// Column ordinals for the carray virtual table
+enum carray_columns {
+
+	carray_value = 0,
+	carray_pointer,
+};
+
+// carray_cursor
+//
+// Virtual table cursor instance
+struct carray_cursor : public sqlite3_vtab_cursor {
+
+	carray_text const*	values = nullptr;		// Bound array of strings
+	size_t				index = 0;				// Current string index
+};
+
+//---------------------------------------------------------------------------
+// carray_connect (local)
+//
+// Connects to the carray virtual table
+//
+// Arguments:
+//
+//	db			- SQLite database instance
+//	aux			- Client data pointer from sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments
+//	vtab		- On success receives the virtual table instance
+//	errmsg		- On failure receives the error message
+
+static int carray_connect(sqlite3* db, void* /*aux*/, int /*argc*/, char const* const* /*argv*/, sqlite3_vtab** vtab, char** /*errmsg*/)
+{
+	*vtab = nullptr;
+
+	int result = sqlite3_declare_vtab(db, "create table carray(value text, pointer hidden)");
+	if(result != SQLITE_OK) return result;
+
+	*vtab = new(std::nothrow) sqlite3_vtab();
+	if(*vtab == nullptr) return SQLITE_NOMEM;
+
+	sqlite3_vtab_config(db, SQLITE_VTAB_INNOCUOUS);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_disconnect (local)
+//
+// Disconnects from the carray virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int carray_disconnect(sqlite3_vtab* vtab)
+{
+	delete vtab;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_bestindex (local)
+//
+// Determines the best query plan for the carray virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int carray_bestindex(sqlite3_vtab* /*vtab*/, sqlite3_index_info* info)
+{
+	for(int index = 0; index < info->nConstraint; index++) {
+
+		auto const& constraint = info->aConstraint[index];
+		if((constraint.iColumn != carray_pointer) || (constraint.op != SQLITE_INDEX_CONSTRAINT_EQ)) continue;
+
+		// An unusable pointer constraint means the plan can't be used at all
+		if(!constraint.usable) return SQLITE_CONSTRAINT;
+
+		info->aConstraintUsage[index].argvIndex = 1;
+		info->aConstraintUsage[index].omit = 1;
+		info->estimatedCost = 1.0;
+		info->estimatedRows = 100;
+
+		return SQLITE_OK;
+	}
+
+	// The pointer argument is required
+	return SQLITE_CONSTRAINT;
+}
+
+//---------------------------------------------------------------------------
+// carray_open (local)
+//
+// Opens a cursor against the carray virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	cursor		- On success receives the cursor instance
+
+static int carray_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
+{
+	*cursor = new(std::nothrow) carray_cursor();
+	return (*cursor == nullptr) ? SQLITE_NOMEM : SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_close (local)
+//
+// Closes a carray virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int carray_close(sqlite3_vtab_cursor* cursor)
+{
+	delete static_cast<carray_cursor*>(cursor);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_next (local)
+//
+// Advances a carray virtual table cursor to the next string
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int carray_next(sqlite3_vtab_cursor* cursor)
+{
+	static_cast<carray_cursor*>(cursor)->index++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_filter (local)
+//
+// Begins a scan of the carray virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Unused
+//	idxstr		- Unused
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int carray_filter(sqlite3_vtab_cursor* cursor, int /*idxnum*/, char const* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	carray_cursor* instance = static_cast<carray_cursor*>(cursor);
+
+	// Anything other than a bound carray_text pointer (including NULL) produces no rows
+	instance->values = (argc < 1) ? nullptr : static_cast<carray_text const*>(sqlite3_value_pointer(argv[0], CARRAY_POINTER_TYPE));
+	instance->index = 0;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_eof (local)
+//
+// Determines if a carray virtual table cursor is at end of file
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int carray_eof(sqlite3_vtab_cursor* cursor)
+{
+	carray_cursor* instance = static_cast<carray_cursor*>(cursor);
+	return ((instance->values == nullptr) || (instance->index >= instance->values->size())) ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// carray_column (local)
+//
+// Returns a column value for the current carray virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- SQLite context object
+//	ordinal		- Column ordinal
+
+static int carray_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
+{
+	carray_cursor* instance = static_cast<carray_cursor*>(cursor);
+
+	switch(ordinal) {
+
+		// The bound array outlives every step of the statement, the text doesn't need to be copied
+		case carray_value:
+			sqlite3_result_text16(context, instance->values->data(instance->index),
+				static_cast<int>(instance->values->length(instance->index) * sizeof(wchar_t)), SQLITE_STATIC);
+			break;
+
+		// The hidden pointer column isn't retained by the cursor
+		case carray_pointer:
+			sqlite3_result_null(context);
+			break;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// carray_rowid (local)
+//
+// Returns the rowid for the current carray virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	rowid		- On success receives the rowid
+
+static int carray_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+	*rowid = static_cast<sqlite3_int64>(static_cast<carray_cursor*>(cursor)->index);
+	return SQLITE_OK;
+}
+
+// carray_module
+//
+// Module definition for the carray virtual table; eponymous only
+static sqlite3_module carray_module = {
+
+	0,						// iVersion
+	nullptr,				// xCreate
+	carray_connect,			// xConnect
+	carray_bestindex,		// xBestIndex
+	carray_disconnect,		// xDisconnect
+	nullptr,				// xDestroy
+	carray_open,			// xOpen
+	carray_close,			// xClose
+	carray_filter,			// xFilter
+	carray_next,			// xNext
+	carray_eof,				// xEof
+	carray_column,			// xColumn
+	carray_rowid,			// xRowid
+	nullptr,				// xUpdate
+	nullptr,				// xBegin
+	nullptr,				// xSync
+	nullptr,				// xCommit
+	nullptr,				// xRollback
+	nullptr,				// xFindFunction
+	nullptr,				// xRename
+	nullptr,				// xSavepoint
+	nullptr,				// xRelease
+	nullptr,				// xRollbackTo
+};
+
+#pragma managed(pop)
+
+// The image search index is compiled as native code; the tree search shouldn't
+// require any managed transitions
+#pragma managed(push, off)
+
+//---------------------------------------------------------------------------
+// imagesearch virtual table
+//
+// Eponymous table-valued function that returns the card images with the
+// perceptual hashes nearest to a hash generated by webpphash():
+//
+//	select * from imagesearch(webpphash(?1), 5)
+//
+// cardid | side | language | distance | hash (hidden) | k (hidden)
+//
+// Each connection holds an in-memory BK-tree over the stored cardimage.phash
+// values using Hamming distance as the metric, built on first use and rebuilt
+// whenever the database has changed. No images are decoded to search the tree
+
+// imagesearch_columns
+//
+// Column ordinals for the imagesearch virtual table
+enum imagesearch_columns {
+
+	imagesearch_cardid = 0,
+	imagesearch_side,
+	imagesearch_language,
+	imagesearch_distance,
+	imagesearch_hash,
+	imagesearch_k,
+};
+
+// imagesearch_idxnum
+//
+// Bitmask of the constraints passed from xBestIndex to xFilter
+enum imagesearch_idxnum {
+
+	imagesearch_hash_eq = 0x01,
+	imagesearch_k_eq = 0x02,
+};
+
+// imagesearch_defaultk / imagesearch_maxk
+//
+// Default and maximum number of results returned by a search
+static int const imagesearch_defaultk = 10;
+static int const imagesearch_maxk = 1000;
+
+// imagesearch_node
+//
+// BK-tree node; node n holds the hash of image entry n. The children of a node
+// are a linked list threaded through firstchild and nextsibling
+struct imagesearch_node {
+
+	uint64_t				hash;					// Perceptual hash
+	uint32_t				firstchild;				// First child node
+	uint32_t				nextsibling;			// Next sibling node
+	uint32_t				distance;				// Distance from the parent node
+};
+
+// imagesearch_entry
+//
+// Indexed card image
+struct imagesearch_entry {
+
+	std::string				cardid;					// Card identifier
+	int						side;					// Card side
+	int						language;				// Card language
+};
+
+// imagesearch_result
+//
+// Search result
+struct imagesearch_result {
+
+	uint32_t				entry;					// Index of the matching entry
+	uint32_t				distance;				// Hamming distance from the query
+};
+
+// imagesearch_none
+//
+// Sentinel for an empty child or sibling link
+static uint32_t const imagesearch_none = UINT32_MAX;
+
+// imagesearch_vtab
+//
+// Virtual table instance; holds the image index for the connection
+struct imagesearch_vtab : public sqlite3_vtab {
+
+	sqlite3*						db = nullptr;			// Database connection
+	bool							loaded = false;			// Index has been loaded
+	unsigned int					dataversion = 0;		// Data version when loaded
+	int								totalchanges = 0;		// Connection changes when loaded
+	std::vector<imagesearch_entry>	entries;				// Indexed images
+	std::vector<imagesearch_node>	nodes;					// BK-tree nodes; node 0 is the root
+};
+
+// imagesearch_cursor
+//
+// Virtual table cursor instance
+struct imagesearch_cursor : public sqlite3_vtab_cursor {
+
+	std::vector<imagesearch_result>	results;				// Ranked search results
+	size_t							index = 0;				// Current result index
+};
+
+//---------------------------------------------------------------------------
+// imagesearch_hamming (local)
+//
+// Computes the Hamming distance between two hashes
+//
+// Arguments:
+//
+//	lhs			- Left-hand hash
+//	rhs			- Right-hand hash
+
+static uint32_t imagesearch_hamming(uint64_t lhs, uint64_t rhs)
+{
+	uint64_t bits = lhs ^ rhs;
+
+	bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+	bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+	bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+	return static_cast<uint32_t>((bits * 0x0101010101010101ULL) >> 56);
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_insert (local)
+//
+// Inserts the most recently appended node into the BK-tree
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static void imagesearch_insert(imagesearch_vtab* vtab)
+{
+	uint32_t const inserted = static_cast<uint32_t>(vtab->nodes.size() - 1);
+	if(inserted == 0) return;						// Root node
+
+	imagesearch_node& node = vtab->nodes[inserted];
+	uint32_t current = 0;
+
+	while(true) {
+
+		uint32_t const distance = imagesearch_hamming(node.hash, vtab->nodes[current].hash);
+
+		// Descend into the child at the same distance, or link the node in as a new child
+		uint32_t child = vtab->nodes[current].firstchild;
+		while((child != imagesearch_none) && (vtab->nodes[child].distance != distance)) child = vtab->nodes[child].nextsibling;
+
+		if(child == imagesearch_none) {
+
+			node.distance = distance;
+			node.nextsibling = vtab->nodes[current].firstchild;
+			vtab->nodes[current].firstchild = inserted;
+			return;
+		}
+
+		current = child;
+	}
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_load (local)
+//
+// Loads or reloads the image index if the database has changed since it was
+// last loaded by the connection
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int imagesearch_load(imagesearch_vtab* vtab)
+{
+	// The data version changes on any commit to the database, including those made by this
+	// connection; the total change count also covers changes made in an open transaction
+	unsigned int dataversion = 0;
+	sqlite3_file_control(vtab->db, "main", SQLITE_FCNTL_DATA_VERSION, &dataversion);
+	int const totalchanges = sqlite3_total_changes(vtab->db);
+
+	if(vtab->loaded && (dataversion == vtab->dataversion) && (totalchanges == vtab->totalchanges)) return SQLITE_OK;
+
+	vtab->loaded = false;
+	vtab->entries.clear();
+	vtab->nodes.clear();
+
+	sqlite3_stmt* statement = nullptr;
+	int result = sqlite3_prepare_v2(vtab->db, "select cardid, side, language, phash from cardimage where phash is not null", -1, &statement, nullptr);
+	if(result != SQLITE_OK) {
+
+		sqlite3_free(vtab->zErrMsg);
+		vtab->zErrMsg = sqlite3_mprintf("imagesearch: %s", sqlite3_errmsg(vtab->db));
+		return result;
+	}
+
+	try {
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			imagesearch_entry entry;
+			entry.cardid.assign(reinterpret_cast<char const*>(sqlite3_column_text(statement, 0)), sqlite3_column_bytes(statement, 0));
+			entry.side = sqlite3_column_int(statement, 1);
+			entry.language = sqlite3_column_int(statement, 2);
+
+			vtab->nodes.push_back({ static_cast<uint64_t>(sqlite3_column_int64(statement, 3)), imagesearch_none, imagesearch_none, 0 });
+			vtab->entries.emplace_back(std::move(entry));
+			imagesearch_insert(vtab);
+		}
+
+		sqlite3_finalize(statement);
+		if(result != SQLITE_DONE) return result;
+
+		vtab->dataversion = dataversion;
+		vtab->totalchanges = totalchanges;
+		vtab->loaded = true;
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) {
+
+		sqlite3_finalize(statement);
+		vtab->entries.clear();
+		vtab->nodes.clear();
+
+		return SQLITE_NOMEM;
+	}
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_connect (local)
+//
+// Connects to the imagesearch virtual table
+//
+// Arguments:
+//
+//	db			- SQLite database instance
+//	aux			- Client data pointer from sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments
+//	vtab		- On success receives the virtual table instance
+//	errmsg		- On failure receives the error message
+
+static int imagesearch_connect(sqlite3* db, void* /*aux*/, int /*argc*/, char const* const* /*argv*/, sqlite3_vtab** vtab, char** /*errmsg*/)
+{
+	*vtab = nullptr;
+
+	int result = sqlite3_declare_vtab(db, "create table imagesearch(cardid text, side integer, language integer, distance integer, "
+		"hash hidden, k hidden)");
+	if(result != SQLITE_OK) return result;
+
+	imagesearch_vtab* instance = new(std::nothrow) imagesearch_vtab();
+	if(instance == nullptr) return SQLITE_NOMEM;
+
+	instance->db = db;
+
+	*vtab = instance;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_disconnect (local)
+//
+// Disconnects from the imagesearch virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int imagesearch_disconnect(sqlite3_vtab* vtab)
+{
+	delete static_cast<imagesearch_vtab*>(vtab);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_bestindex (local)
+//
+// Determines the best query plan for the imagesearch virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int imagesearch_bestindex(sqlite3_vtab* /*vtab*/, sqlite3_index_info* info)
+{
+	int indexes[2] = { -1, -1 };				// Constraint indexes for hash and k
+
+	for(int index = 0; index < info->nConstraint; index++) {
+
+		auto const& constraint = info->aConstraint[index];
+		if((constraint.iColumn < imagesearch_hash) || (constraint.op != SQLITE_INDEX_CONSTRAINT_EQ)) continue;
+
+		// An unusable argument constraint means the plan can't be used at all
+		if(!constraint.usable) return SQLITE_CONSTRAINT;
+		indexes[constraint.iColumn - imagesearch_hash] = index;
+	}
+
+	// The hash argument is required
+	if(indexes[0] < 0) return SQLITE_CONSTRAINT;
+
+	int argvindex = 1;
+	info->idxNum = 0;
+
+	for(int index = 0; index < 2; index++) {
+
+		if(indexes[index] < 0) continue;
+
+		info->aConstraintUsage[indexes[index]].argvIndex = argvindex++;
+		info->aConstraintUsage[indexes[index]].omit = 1;
+		info->idxNum |= (1 << index);
+	}
+
+	// The results are returned in order of increasing distance
+	if((info->nOrderBy == 1) && (info->aOrderBy[0].iColumn == imagesearch_distance) && !info->aOrderBy[0].desc) info->orderByConsumed = 1;
+
+	info->estimatedCost = 100.0;
+	info->estimatedRows = imagesearch_defaultk;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_open (local)
+//
+// Opens a cursor against the imagesearch virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	cursor		- On success receives the cursor instance
+
+static int imagesearch_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
+{
+	*cursor = new(std::nothrow) imagesearch_cursor();
+	return (*cursor == nullptr) ? SQLITE_NOMEM : SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_close (local)
+//
+// Closes an imagesearch virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int imagesearch_close(sqlite3_vtab_cursor* cursor)
+{
+	delete static_cast<imagesearch_cursor*>(cursor);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_next (local)
+//
+// Advances an imagesearch virtual table cursor to the next result
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int imagesearch_next(sqlite3_vtab_cursor* cursor)
+{
+	static_cast<imagesearch_cursor*>(cursor)->index++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_filter (local)
+//
+// Executes a search against the imagesearch virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Constraint bitmask from xBestIndex
+//	idxstr		- Unused
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int imagesearch_filter(sqlite3_vtab_cursor* cursor, int idxnum, char const* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	imagesearch_cursor* instance = static_cast<imagesearch_cursor*>(cursor);
+	imagesearch_vtab* vtab = static_cast<imagesearch_vtab*>(cursor->pVtab);
+
+	int argindex = 0;
+	int k = imagesearch_defaultk;
+
+	instance->results.clear();
+	instance->index = 0;
+
+	if(((idxnum & imagesearch_hash_eq) == 0) || (argindex >= argc)) return SQLITE_OK;
+
+	// A null hash (an image that couldn't be hashed) matches nothing
+	sqlite3_value* hashvalue = argv[argindex++];
+	if(sqlite3_value_type(hashvalue) != SQLITE_INTEGER) return SQLITE_OK;
+	uint64_t const hash = static_cast<uint64_t>(sqlite3_value_int64(hashvalue));
+
+	if((idxnum & imagesearch_k_eq) && (argindex < argc)) k = std::min(std::max(sqlite3_value_int(argv[argindex++]), 0), imagesearch_maxk);
+	if(k == 0) return SQLITE_OK;
+
+	int result = imagesearch_load(vtab);
+	if(result != SQLITE_OK) return result;
+	if(vtab->nodes.empty()) return SQLITE_OK;
+
+	try {
+
+		// The results are kept as a max-heap on distance; once k results have been found the
+		// worst of them bounds the search radius. The triangle inequality means only children
+		// whose distance from their parent is within that radius of the query's distance from
+		// the parent can contain a closer hash
+		auto const ranking = [](imagesearch_result const& lhs, imagesearch_result const& rhs) {
+
+			if(lhs.distance != rhs.distance) return lhs.distance < rhs.distance;
+			return lhs.entry < rhs.entry;
+		};
+
+		std::vector<imagesearch_result>& results = instance->results;
+		std::vector<uint32_t> pending = { 0 };
+
+		while(!pending.empty()) {
+
+			uint32_t const current = pending.back();
+			pending.pop_back();
+
+			imagesearch_node const& node = vtab->nodes[current];
+			uint32_t const distance = imagesearch_hamming(hash, node.hash);
+
+			if(results.size() < static_cast<size_t>(k)) {
+
+				results.push_back({ current, distance });
+				std::push_heap(results.begin(), results.end(), ranking);
+			}
+
+			else if(ranking({ current, distance }, results.front())) {
+
+				std::pop_heap(results.begin(), results.end(), ranking);
+				results.back() = { current, distance };
+				std::push_heap(results.begin(), results.end(), ranking);
+			}
+
+			uint32_t const radius = (results.size() < static_cast<size_t>(k)) ? 64 : results.front().distance;
+
+			for(uint32_t child = node.firstchild; child != imagesearch_none; child = vtab->nodes[child].nextsibling) {
+
+				uint32_t const childdistance = vtab->nodes[child].distance;
+				uint32_t const delta = (childdistance > distance) ? childdistance - distance : distance - childdistance;
+				if(delta <= radius) pending.push_back(child);
+			}
+		}
+
+		std::sort_heap(results.begin(), results.end(), ranking);
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) { instance->results.clear(); return SQLITE_NOMEM; }
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_eof (local)
+//
+// Determines if an imagesearch virtual table cursor is at end of file
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int imagesearch_eof(sqlite3_vtab_cursor* cursor)
+{
+	imagesearch_cursor* instance = static_cast<imagesearch_cursor*>(cursor);
+	return (instance->index >= instance->results.size()) ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_column (local)
+//
+// Returns a column value for the current imagesearch virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- SQLite context object
+//	ordinal		- Column ordinal
+
+static int imagesearch_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
+{
+	imagesearch_cursor* instance = static_cast<imagesearch_cursor*>(cursor);
+	imagesearch_vtab* vtab = static_cast<imagesearch_vtab*>(cursor->pVtab);
+
+	imagesearch_result const& item = instance->results[instance->index];
+	imagesearch_entry const& entry = vtab->entries[item.entry];
+
+	switch(ordinal) {
+
+		case imagesearch_cardid:
+			sqlite3_result_text(context, entry.cardid.data(), static_cast<int>(entry.cardid.length()), SQLITE_TRANSIENT);
+			break;
+
+		case imagesearch_side:
+			sqlite3_result_int(context, entry.side);
+			break;
+
+		case imagesearch_language:
+			sqlite3_result_int(context, entry.language);
+			break;
+
+		case imagesearch_distance:
+			sqlite3_result_int(context, static_cast<int>(item.distance));
+			break;
+
+		// The hidden argument columns aren't retained by the cursor
+		default:
+			sqlite3_result_null(context);
+			break;
+	}
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// imagesearch_rowid (local)
+//
+// Returns the rowid for the current imagesearch virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	rowid		- On success receives the rowid
+
+static int imagesearch_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+	*rowid = static_cast<sqlite3_int64>(static_cast<imagesearch_cursor*>(cursor)->index);
+	return SQLITE_OK;
+}
+
+// imagesearch_module
+//
+// Module definition for the imagesearch virtual table; eponymous only
+static sqlite3_module imagesearch_module = {
+
+	0,						// iVersion
+	nullptr,				// xCreate
+	imagesearch_connect,	// xConnect
+	imagesearch_bestindex,	// xBestIndex
+	imagesearch_disconnect,	// xDisconnect
+	nullptr,				// xDestroy
+	imagesearch_open,		// xOpen
+	imagesearch_close,		// xClose
+	imagesearch_filter,		// xFilter
+	imagesearch_next,		// xNext
+	imagesearch_eof,		// xEof
+	imagesearch_column,		// xColumn
+	imagesearch_rowid,		// xRowid
+	nullptr,				// xUpdate
+	nullptr,				// xBegin
+	nullptr,				// xSync
+	nullptr,				// xCommit
+	nullptr,				// xRollback
+	nullptr,				// xFindFunction
+	nullptr,				// xRename
+	nullptr,				// xSavepoint
+	nullptr,				// xRelease
+	nullptr,				// xRollbackTo
+};
+
+#pragma managed(pop)
+
+// The name search index is compiled as native code; the candidate selection and
+// edit distance loops shouldn't require any managed transitions
+#pragma managed(push, off)
+
+//---------------------------------------------------------------------------
+// namesearch virtual table
+//
+// Eponymous table-valued function for fuzzy card name lookup:
+//
+//	select * from namesearch('vegetto', 'EN', 5)
+//
+// cardid | side | language | name | distance | similarity | query (hidden) | lang (hidden) | k (hidden)
+//
+// Each connection holds an in-memory trigram posting index over the folded
+// carddetail names, built on first use and rebuilt whenever the database has
+// changed. Names that share the most trigrams with the query are re-ranked by
+// their Levenshtein distance, computed with the bit-parallel algorithm of Myers
+// (Hyyro's formulation) that processes up to 64 pattern characters per step.
+// Names are folded with the same rules as the cjk tokenizer, so the lookup
+// ignores case, character width and katakana versus hiragana
+
+// namesearch_columns
+//
+// Column ordinals for the namesearch virtual table
+enum namesearch_columns {
+
+	namesearch_cardid = 0,
+	namesearch_side,
+	namesearch_language,
+	namesearch_name,
+	namesearch_distance,
+	namesearch_similarity,
+	namesearch_query,
+	namesearch_lang,
+	namesearch_k,
+};
+
+// namesearch_idxnum
+//
+// Bitmask of the constraints passed from xBestIndex to xFilter
+enum namesearch_idxnum {
+
+	namesearch_query_eq = 0x01,
+	namesearch_lang_eq = 0x02,
+	namesearch_k_eq = 0x04,
+};
+
+// namesearch_defaultk / namesearch_maxk
+//
+// Default and maximum number of results returned by a search
+static int const namesearch_defaultk = 10;
+static int const namesearch_maxk = 1000;
+
+// namesearch_entry
+//
+// Indexed card name
+struct namesearch_entry {
+
+	std::string				cardid;			// Card identifier
+	int						side;			// Card side
+	int						language;		// Card language
+	std::string				name;			// Card name
+	std::vector<uint32_t>	folded;			// Folded name code points
+};
+
+// namesearch_result
+//
+// Search result
+struct namesearch_result {
+
+	uint32_t				entry;			// Index of the matching entry
+	uint32_t				shared;			// Number of trigrams shared with the query
+	uint32_t				distance;		// Levenshtein distance from the query
+};
+
+// namesearch_peq
+//
+// Pattern match bitmasks for the Myers edit distance algorithm; one bit per
+// pattern position that holds the indexed code point
+struct namesearch_peq {
+
+	uint64_t										ascii[128];		// ASCII code points
+	std::vector<std::pair<uint32_t, uint64_t>>		other;			// All other code points
+};
+
+// namesearch_vtab
+//
+// Virtual table instance; holds the name index for the connection
+struct namesearch_vtab : public sqlite3_vtab {
+
+	sqlite3*											db = nullptr;			// Database connection
+	bool												loaded = false;			// Index has been loaded
+	unsigned int										dataversion = 0;		// Data version when loaded
+	int													totalchanges = 0;		// Connection changes when loaded
+	std::vector<namesearch_entry>						entries;				// Indexed names
+	std::unordered_map<uint64_t, std::vector<uint32_t>>	postings;				// Trigram posting lists
+	std::vector<uint32_t>								counts;					// Shared trigram counts (scratch)
+};
+
+// namesearch_cursor
+//
+// Virtual table cursor instance
+struct namesearch_cursor : public sqlite3_vtab_cursor {
+
+	std::vector<namesearch_result>	results;			// Ranked search results
+	size_t							index = 0;			// Current result index
+	size_t							querylength = 0;	// Length of the folded query
+};
+
+//---------------------------------------------------------------------------
+// namesearch_normalize (local)
+//
+// Folds UTF-8 text into the code points used for trigram indexing; runs of
+// separator characters are collapsed into a single space
+//
+// Arguments:
+//
+//	text		- UTF-8 input text
+//	length		- Length of the input text, in bytes
+//	folded		- Receives the folded code points
+
+static void namesearch_normalize(char const* text, int length, std::vector<uint32_t>& folded)
+{
+	folded.clear();
+	if((text == nullptr) || (length <= 0)) return;
+
+	char const* const end = text + length;
+	char const* pos = text;
+	bool separator = false;
+
+	while(pos < end) {
+
+		uint32_t const cp = cjk_fold(cjk_decode(pos, end), pos, end);
+
+		if(cjk_classify(cp) == cjk_class::separator) { separator = !folded.empty(); continue; }
+
+		if(separator) folded.push_back(' ');
+		folded.push_back(cp);
+		separator = false;
+	}
+}
+
+//---------------------------------------------------------------------------
+// namesearch_trigrams (local)
+//
+// Generates the distinct trigram keys of a folded name; the name is padded
+// with boundary markers so that names shorter than three characters and the
+// first and last characters still generate trigrams
+//
+// Arguments:
+//
+//	folded		- Folded name code points
+//	trigrams	- Receives the sorted trigram keys
+
+static void namesearch_trigrams(std::vector<uint32_t> const& folded, std::vector<uint64_t>& trigrams)
+{
+	trigrams.clear();
+
+	size_t const length = folded.size();
+	if(length == 0) return;
+
+	// Code points fit in 21 bits, so each trigram packs into a single 64-bit key
+	auto padded = [&](size_t index) -> uint64_t { return (index == 0) ? 0x02 : (index > length) ? 0x03 : folded[index - 1]; };
+	for(size_t index = 0; index < length; index++) trigrams.push_back((padded(index) << 42) | (padded(index + 1) << 21) | padded(index + 2));
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+//---------------------------------------------------------------------------
+// namesearch_buildpeq (local)
+//
+// Builds the pattern match bitmasks for a folded query of up to 64 characters
+//
+// Arguments:
+//
+//	pattern		- Folded pattern code points
+//	peq			- Receives the pattern match bitmasks
+
+static void namesearch_buildpeq(std::vector<uint32_t> const& pattern, namesearch_peq& peq)
+{
+	assert(pattern.size() <= 64);
+
+	memset(peq.ascii, 0, sizeof(peq.ascii));
+	peq.other.clear();
+
+	for(size_t index = 0; index < pattern.size(); index++) {
+
+		uint32_t const cp = pattern[index];
+		uint64_t const bit = 1ULL << index;
+
+		if(cp < 128) { peq.ascii[cp] |= bit; continue; }
+
+		auto found = std::find_if(peq.other.begin(), peq.other.end(), [&](auto const& item) { return item.first == cp; });
+		if(found != peq.other.end()) found->second |= bit;
+		else peq.other.emplace_back(cp, bit);
+	}
+}
+
+//---------------------------------------------------------------------------
+// namesearch_myers (local)
+//
+// Computes the Levenshtein distance between a pattern of 1 to 64 characters
+// and a text using the bit-parallel algorithm of Myers
+//
+// Arguments:
+//
+//	peq			- Pattern match bitmasks
+//	patternlen	- Length of the pattern
+//	text		- Folded text code points
+
+static uint32_t namesearch_myers(namesearch_peq const& peq, size_t patternlen, std::vector<uint32_t> const& text)
+{
+	assert((patternlen > 0) && (patternlen <= 64));
+
+	uint64_t const last = 1ULL << (patternlen - 1);		// Bit of the final pattern position
+	uint64_t pv = ~0ULL;								// Positive vertical deltas
+	uint64_t mv = 0;									// Negative vertical deltas
+	uint32_t score = static_cast<uint32_t>(patternlen);
+
+	for(uint32_t const cp : text) {
+
+		uint64_t eq = 0;
+		if(cp < 128) eq = peq.ascii[cp];
+		else for(auto const& item : peq.other) if(item.first == cp) { eq = item.second; break; }
+
+		uint64_t const xv = eq | mv;
+		uint64_t const xh = (((eq & pv) + pv) ^ pv) | eq;
+		uint64_t ph = mv | ~(xh | pv);
+		uint64_t mh = pv & xh;
+
+		if(ph & last) score++;
+		else if(mh & last) score--;
+
+		// Shifting in a one models the unbounded leading row of a global alignment
+		ph = (ph << 1) | 1;
+		mh <<= 1;
+
+		pv = mh | ~(xv | ph);
+		mv = ph & xv;
+	}
+
+	return score;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_levenshtein (local)
+//
+// Computes the Levenshtein distance between two sequences with the classic
+// dynamic programming algorithm; used for patterns longer than 64 characters
+//
+// Arguments:
+//
+//	lhs			- Left-hand sequence
+//	rhs			- Right-hand sequence
+
+static uint32_t namesearch_levenshtein(std::vector<uint32_t> const& lhs, std::vector<uint32_t> const& rhs)
+{
+	std::vector<uint32_t> row(rhs.size() + 1);
+	for(size_t index = 0; index < row.size(); index++) row[index] = static_cast<uint32_t>(index);
+
+	for(size_t outer = 0; outer < lhs.size(); outer++) {
+
+		uint32_t diagonal = row[0];
+		row[0] = static_cast<uint32_t>(outer + 1);
+
+		for(size_t inner = 0; inner < rhs.size(); inner++) {
+
+			uint32_t const above = row[inner + 1];
+			row[inner + 1] = std::min({ above + 1, row[inner] + 1, diagonal + ((lhs[outer] == rhs[inner]) ? 0U : 1U) });
+			diagonal = above;
+		}
+	}
 
-#include "webp\decode.h"
+	return row.back();
+}
 
-extern "C" { SQLITE_EXTENSION_INIT1 };
+//---------------------------------------------------------------------------
+// namesearch_load (local)
+//
+// Loads or reloads the name index if the database has changed since it was
+// last loaded by the connection
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
 
-using namespace zuki::dbsfw::data;
+static int namesearch_load(namesearch_vtab* vtab)
+{
+	// The data version changes on any commit to the database, including those made by this
+	// connection; the total change count also covers changes made in an open transaction
+	unsigned int dataversion = 0;
+	sqlite3_file_control(vtab->db, "main", SQLITE_FCNTL_DATA_VERSION, &dataversion);
+	int const totalchanges = sqlite3_total_changes(vtab->db);
 
-#pragma warning(push, 4)
+	if(vtab->loaded && (dataversion == vtab->dataversion) && (totalchanges == vtab->totalchanges)) return SQLITE_OK;
+
+	vtab->loaded = false;
+	vtab->entries.clear();
+	vtab->postings.clear();
+
+	sqlite3_stmt* statement = nullptr;
+	int result = sqlite3_prepare_v2(vtab->db, "select cardid, side, language, name from carddetail", -1, &statement, nullptr);
+	if(result != SQLITE_OK) {
+
+		sqlite3_free(vtab->zErrMsg);
+		vtab->zErrMsg = sqlite3_mprintf("namesearch: %s", sqlite3_errmsg(vtab->db));
+		return result;
+	}
+
+	try {
+
+		std::vector<uint64_t> trigrams;
+
+		while((result = sqlite3_step(statement)) == SQLITE_ROW) {
+
+			namesearch_entry entry;
+			entry.cardid.assign(reinterpret_cast<char const*>(sqlite3_column_text(statement, 0)), sqlite3_column_bytes(statement, 0));
+			entry.side = sqlite3_column_int(statement, 1);
+			entry.language = sqlite3_column_int(statement, 2);
+			entry.name.assign(reinterpret_cast<char const*>(sqlite3_column_text(statement, 3)), sqlite3_column_bytes(statement, 3));
+			namesearch_normalize(entry.name.data(), static_cast<int>(entry.name.length()), entry.folded);
+
+			// Entries are appended in order, so every posting list remains sorted
+			uint32_t const index = static_cast<uint32_t>(vtab->entries.size());
+			namesearch_trigrams(entry.folded, trigrams);
+			for(uint64_t const trigram : trigrams) vtab->postings[trigram].push_back(index);
+
+			vtab->entries.emplace_back(std::move(entry));
+		}
+
+		sqlite3_finalize(statement);
+		if(result != SQLITE_DONE) return result;
+
+		vtab->counts.assign(vtab->entries.size(), 0);
+		vtab->dataversion = dataversion;
+		vtab->totalchanges = totalchanges;
+		vtab->loaded = true;
+
+		return SQLITE_OK;
+	}
+
+	catch(std::bad_alloc const&) {
+
+		sqlite3_finalize(statement);
+		vtab->entries.clear();
+		vtab->postings.clear();
+
+		return SQLITE_NOMEM;
+	}
+}
 
 //---------------------------------------------------------------------------
-// base64decode (local)
+// namesearch_connect (local)
 //
-// SQLite scalar function to convert a base-64 encoded string into a blob
+// Connects to the namesearch virtual table
 //
 // Arguments:
 //
-//	context		- SQLite context object
-//	argc		- Number of supplied arguments
-//	argv		- Argument values
+//	db			- SQLite database instance
+//	aux			- Client data pointer from sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments
+//	vtab		- On success receives the virtual table instance
+//	errmsg		- On failure receives the error message
+
+static int namesearch_connect(sqlite3* db, void* /*aux*/, int /*argc*/, char const* const* /*argv*/, sqlite3_vtab** vtab, char** /*errmsg*/)
+{
+	*vtab = nullptr;
+
+	int result = sqlite3_declare_vtab(db, "create table namesearch(cardid text, side integer, language integer, name text, "
+		"distance integer, similarity real, query hidden, lang hidden, k hidden)");
+	if(result != SQLITE_OK) return result;
+
+	namesearch_vtab* instance = new(std::nothrow) namesearch_vtab();
+	if(instance == nullptr) return SQLITE_NOMEM;
+
+	instance->db = db;
+
+	*vtab = instance;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_disconnect (local)
+//
+// Disconnects from the namesearch virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
 
-static void base64decode(sqlite3_context* context, int argc, sqlite3_value** argv)
+static int namesearch_disconnect(sqlite3_vtab* vtab)
 {
-	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	delete static_cast<namesearch_vtab*>(vtab);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_bestindex (local)
+//
+// Determines the best query plan for the namesearch virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int namesearch_bestindex(sqlite3_vtab* /*vtab*/, sqlite3_index_info* info)
+{
+	int indexes[3] = { -1, -1, -1 };			// Constraint indexes for query, lang and k
+
+	for(int index = 0; index < info->nConstraint; index++) {
 
-	DWORD cb = 0;			// Length of the decoded binary data
+		auto const& constraint = info->aConstraint[index];
+		if((constraint.iColumn < namesearch_query) || (constraint.op != SQLITE_INDEX_CONSTRAINT_EQ)) continue;
 
-	// Grab a pointer to the input string in UTF-16
-	wchar_t const* input = reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[0]));
-	if(input == nullptr) return sqlite3_result_null(context);
+		// An unusable argument constraint means the plan can't be used at all
+		if(!constraint.usable) return SQLITE_CONSTRAINT;
+		indexes[constraint.iColumn - namesearch_query] = index;
+	}
+
+	// The query argument is required
+	if(indexes[0] < 0) return SQLITE_CONSTRAINT;
 
-	// Determine the length of the binary data that would result from conversion
-	CryptStringToBinaryW(input, 0, CRYPT_STRING_BASE64_ANY, nullptr, &cb, nullptr, nullptr);
+	int argvindex = 1;
+	info->idxNum = 0;
 
-	// Allocate the memory using sqlite3_malloc64
-	LPBYTE data = reinterpret_cast<LPBYTE>(sqlite3_malloc64(cb));
-	if(data == nullptr) return sqlite3_result_error(context, "unable to allocate memory", -1);
+	for(int index = 0; index < 3; index++) {
 
-	// Convert the base-64 encoded string back into binary data
-	if(!CryptStringToBinaryW(input, 0, CRYPT_STRING_BASE64_ANY, data, &cb, nullptr, nullptr)) {
+		if(indexes[index] < 0) continue;
 
-		sqlite3_free(data);
-		return sqlite3_result_error(context, "failed to decode binary data from base-64", -1);
+		info->aConstraintUsage[indexes[index]].argvIndex = argvindex++;
+		info->aConstraintUsage[indexes[index]].omit = 1;
+		info->idxNum |= (1 << index);
 	}
 
-	return sqlite3_result_blob(context, data, static_cast<int>(cb), sqlite3_free);
+	// The results are returned in order of increasing distance
+	if((info->nOrderBy == 1) && (info->aOrderBy[0].iColumn == namesearch_distance) && !info->aOrderBy[0].desc) info->orderByConsumed = 1;
+
+	info->estimatedCost = 100.0;
+	info->estimatedRows = namesearch_defaultk;
+
+	return SQLITE_OK;
 }
 
 //---------------------------------------------------------------------------
-// base64encode (local)
+// namesearch_open (local)
 //
-// SQLite scalar function to convert a blob column into a base-64 string
+// Opens a cursor against the namesearch virtual table
 //
 // Arguments:
 //
-//	context		- SQLite context object
-//	argc		- Number of supplied arguments
-//	argv		- Argument values
+//	vtab		- Virtual table instance
+//	cursor		- On success receives the cursor instance
 
-static void base64encode(sqlite3_context* context, int argc, sqlite3_value** argv)
+static int namesearch_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
 {
-	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	*cursor = new(std::nothrow) namesearch_cursor();
+	return (*cursor == nullptr) ? SQLITE_NOMEM : SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_close (local)
+//
+// Closes a namesearch virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
 
-	DWORD cb = 0;			// Length, in bytes, of the base-64 encoded string
+static int namesearch_close(sqlite3_vtab_cursor* cursor)
+{
+	delete static_cast<namesearch_cursor*>(cursor);
+	return SQLITE_OK;
+}
 
-	// Get the length of the data to be encoded
-	int length = sqlite3_value_bytes(argv[0]);
-	if(length == 0) return sqlite3_result_null(context);
+//---------------------------------------------------------------------------
+// namesearch_next (local)
+//
+// Advances a namesearch virtual table cursor to the next result
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int namesearch_next(sqlite3_vtab_cursor* cursor)
+{
+	static_cast<namesearch_cursor*>(cursor)->index++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_filter (local)
+//
+// Executes a search against the namesearch virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Constraint bitmask from xBestIndex
+//	idxstr		- Unused
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int namesearch_filter(sqlite3_vtab_cursor* cursor, int idxnum, char const* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	namesearch_cursor* instance = static_cast<namesearch_cursor*>(cursor);
+	namesearch_vtab* vtab = static_cast<namesearch_vtab*>(cursor->pVtab);
+
+	int argindex = 0;
+	int language = 0;
+	int k = namesearch_defaultk;
+
+	instance->results.clear();
+	instance->index = 0;
+	instance->querylength = 0;
+
+	if(((idxnum & namesearch_query_eq) == 0) || (argindex >= argc)) return SQLITE_OK;
+	sqlite3_value* query = argv[argindex++];
+
+	// The optional language may be specified as text ('EN') or as the integer value
+	if((idxnum & namesearch_lang_eq) && (argindex < argc)) {
+
+		sqlite3_value* lang = argv[argindex++];
+		if(sqlite3_value_type(lang) == SQLITE_INTEGER) language = sqlite3_value_int(lang);
+		else if(!core::encode_cardlanguage(reinterpret_cast<char const*>(sqlite3_value_text(lang)), sqlite3_value_bytes(lang), &language)) return SQLITE_OK;
+	}
+
+	if((idxnum & namesearch_k_eq) && (argindex < argc)) k = std::min(std::max(sqlite3_value_int(argv[argindex++]), 0), namesearch_maxk);
+	if(k == 0) return SQLITE_OK;
+
+	int result = namesearch_load(vtab);
+	if(result != SQLITE_OK) return result;
+
+	try {
+
+		std::vector<uint32_t> folded;
+		std::vector<uint64_t> trigrams;
+		std::vector<uint32_t> touched;
+
+		namesearch_normalize(reinterpret_cast<char const*>(sqlite3_value_text(query)), sqlite3_value_bytes(query), folded);
+		if(folded.empty()) return SQLITE_OK;
+
+		instance->querylength = folded.size();
+
+		// Count the trigrams each indexed name shares with the query
+		namesearch_trigrams(folded, trigrams);
+		for(uint64_t const trigram : trigrams) {
+
+			auto const found = vtab->postings.find(trigram);
+			if(found == vtab->postings.end()) continue;
+
+			for(uint32_t const entry : found->second) if(vtab->counts[entry]++ == 0) touched.push_back(entry);
+		}
+
+		for(uint32_t const entry : touched) {
+
+			if((language == 0) || (vtab->entries[entry].language == language))
+				instance->results.push_back({ entry, vtab->counts[entry], 0 });
+
+			vtab->counts[entry] = 0;			// Reset the scratch counts for the next search
+		}
+
+		// Only the candidates that share the most trigrams are re-ranked by edit distance
+		size_t const candidates = std::max<size_t>(static_cast<size_t>(k) * 8, 64);
+		if(instance->results.size() > candidates) {
+
+			std::nth_element(instance->results.begin(), instance->results.begin() + candidates, instance->results.end(),
+				[](namesearch_result const& lhs, namesearch_result const& rhs) { return lhs.shared > rhs.shared; });
+			instance->results.resize(candidates);
+		}
 
-	// Determine the length of the resultant base-64 encoded string
-	LPCBYTE data = reinterpret_cast<LPCBYTE>(sqlite3_value_blob(argv[0]));
-	CryptBinaryToStringW(data, length, CRYPT_STRING_BASE64 | CRYPT_STRING_NOCRLF, nullptr, &cb);
+		if(folded.size() <= 64) {
+
+			namesearch_peq peq;
+			namesearch_buildpeq(folded, peq);
+			for(auto& item : instance->results) item.distance = namesearch_myers(peq, folded.size(), vtab->entries[item.entry].folded);
+		}
+
+		else for(auto& item : instance->results) item.distance = namesearch_levenshtein(folded, vtab->entries[item.entry].folded);
+
+		// Order by distance, then by shared trigrams, then by index order for stability
+		auto const ranking = [](namesearch_result const& lhs, namesearch_result const& rhs) {
+
+			if(lhs.distance != rhs.distance) return lhs.distance < rhs.distance;
+			if(lhs.shared != rhs.shared) return lhs.shared > rhs.shared;
+			return lhs.entry < rhs.entry;
+		};
+
+		size_t const count = std::min(instance->results.size(), static_cast<size_t>(k));
+		std::partial_sort(instance->results.begin(), instance->results.begin() + count, instance->results.end(), ranking);
+		instance->results.resize(count);
+
+		return SQLITE_OK;
+	}
 
-	// Allocate the memory using sqlite3_malloc64
-	LPWSTR pwsz = reinterpret_cast<LPWSTR>(sqlite3_malloc64(cb * sizeof(wchar_t)));
-	if(pwsz == nullptr) return sqlite3_result_error(context, "unable to allocate memory", -1);
+	catch(std::bad_alloc const&) {
 
-	// Convert the binary data into the base-64 encoded string value
-	if(!CryptBinaryToStringW(data, length, CRYPT_STRING_BASE64 | CRYPT_STRING_NOCRLF, pwsz, &cb)) {
+		// The scratch counts may have been left partially populated
+		std::fill(vtab->counts.begin(), vtab->counts.end(), 0);
+		instance->results.clear();
 
-		sqlite3_free(pwsz);
-		return sqlite3_result_error(context, "failed to encode binary data into base-64", -1);
+		return SQLITE_NOMEM;
 	}
-	
-	return sqlite3_result_text16(context, pwsz, -1, sqlite3_free);
 }
 
 //---------------------------------------------------------------------------
-// cardtype (local)
+// namesearch_eof (local)
 //
-// SQLite scalar function to convert a card type string into a CardType
+// Determines if a namesearch virtual table cursor is at end of file
 //
 // Arguments:
 //
+//	cursor		- Cursor instance
+
+static int namesearch_eof(sqlite3_vtab_cursor* cursor)
+{
+	namesearch_cursor* instance = static_cast<namesearch_cursor*>(cursor);
+	return (instance->index >= instance->results.size()) ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// namesearch_column (local)
+//
+// Returns a column value for the current namesearch virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
 //	context		- SQLite context object
-//	argc		- Number of supplied arguments
-//	argv		- Argument values
+//	ordinal		- Column ordinal
 
-static void cardtype(sqlite3_context* context, int argc, sqlite3_value** argv)
+static int namesearch_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
 {
-	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	namesearch_cursor* instance = static_cast<namesearch_cursor*>(cursor);
+	namesearch_vtab* vtab = static_cast<namesearch_vtab*>(cursor->pVtab);
+
+	namesearch_result const& item = instance->results[instance->index];
+	namesearch_entry const& entry = vtab->entries[item.entry];
+
+	switch(ordinal) {
+
+		case namesearch_cardid:
+			sqlite3_result_text(context, entry.cardid.data(), static_cast<int>(entry.cardid.length()), SQLITE_TRANSIENT);
+			break;
+
+		case namesearch_side:
+			sqlite3_result_int(context, entry.side);
+			break;
 
-	// Null or zero-length input string results in CardType::None
-	wchar_t const* str = reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[0]));
-	if((str == nullptr) || (*str == L'\0')) return sqlite3_result_int(context, static_cast<int>(CardType::None));
+		case namesearch_language:
+			sqlite3_result_int(context, entry.language);
+			break;
 
-	// The strings are case-sensitive and enforced by a CHECK CONSTRAINT
-	if(wcscmp(str, L"LEADER") == 0) return sqlite3_result_int(context, static_cast<int>(CardType::Leader));
-	else if(wcscmp(str, L"BATTLE") == 0) return sqlite3_result_int(context, static_cast<int>(CardType::Battle));
-	else if(wcscmp(str, L"EXTRA") == 0) return sqlite3_result_int(context, static_cast<int>(CardType::Extra));
+		case namesearch_name:
+			sqlite3_result_text(context, entry.name.data(), static_cast<int>(entry.name.length()), SQLITE_TRANSIENT);
+			break;
 
-	// Input string was not a valid card type
-	return sqlite3_result_int(context, static_cast<int>(CardType::None));
+		case namesearch_distance:
+			sqlite3_result_int(context, static_cast<int>(item.distance));
+			break;
+
+		// similarity: 1.0 for an exact match down to 0.0 when every character differs
+		case namesearch_similarity: {
+
+			size_t const longest = std::max(instance->querylength, entry.folded.size());
+			sqlite3_result_double(context, (longest == 0) ? 1.0 : 1.0 - (static_cast<double>(item.distance) / static_cast<double>(longest)));
+			break;
+		}
+
+		// The hidden argument columns aren't retained by the cursor
+		default:
+			sqlite3_result_null(context);
+			break;
+	}
+
+	return SQLITE_OK;
 }
 
 //---------------------------------------------------------------------------
-// newid (local)
+// namesearch_rowid (local)
 //
-// SQLite scalar function to generate a UUID
+// Returns the rowid for the current namesearch virtual table cursor row
 //
 // Arguments:
 //
-//	context		- SQLite context object
-//	argc		- Number of supplied arguments
-//	argv		- Argument values
+//	cursor		- Cursor instance
+//	rowid		- On success receives the rowid
+
+static int namesearch_rowid(sqlite3_vtab_cursor* cursor, sqlite3_int64* rowid)
+{
+	*rowid = static_cast<sqlite3_int64>(static_cast<namesearch_cursor*>(cursor)->index);
+	return SQLITE_OK;
+}
+
+// namesearch_module
+//
+// Module definition for the namesearch virtual table; eponymous only
+static sqlite3_module namesearch_module = {
+
+	0,						// iVersion
+	nullptr,				// xCreate
+	namesearch_connect,		// xConnect
+	namesearch_bestindex,	// xBestIndex
+	namesearch_disconnect,	// xDisconnect
+	nullptr,				// xDestroy
+	namesearch_open,		// xOpen
+	namesearch_close,		// xClose
+	namesearch_filter,		// xFilter
+	namesearch_next,		// xNext
+	namesearch_eof,			// xEof
+	namesearch_column,		// xColumn
+	namesearch_rowid,		// xRowid
+	nullptr,				// xUpdate
+	nullptr,				// xBegin
+	nullptr,				// xSync
+	nullptr,				// xCommit
+	nullptr,				// xRollback
+	nullptr,				// xFindFunction
+	nullptr,				// xRename
+	nullptr,				// xSavepoint
+	nullptr,				// xRelease
+	nullptr,				// xRollbackTo
+};
+
+#pragma managed(pop)
+
+// The UUID parser and the uuid() function are compiled as native code; the
+// function is called for every row and shouldn't require a managed transition
+#pragma managed(push, off)
 
-static void newid(sqlite3_context* context, int argc, sqlite3_value** /*argv*/)
+//---------------------------------------------------------------------------
+// uuid_hexvalues (local)
+//
+// Lookup table of hexadecimal digit values for 7-bit ASCII characters; any
+// other character maps to 0x80 so that errors can be accumulated with OR.
+// uuid_parse() only passes characters from its normalized ASCII buffer
+
+static uint8_t const uuid_hexvalues[128] = {
+
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+	0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+//---------------------------------------------------------------------------
+// uuid_isspace (local)
+//
+// Determines if a code point is whitespace as defined by Char::IsWhiteSpace
+//
+// Arguments:
+//
+//	cp		- Code point to be tested
+
+static bool uuid_isspace(uint32_t cp)
+{
+	if(cp < 0x80) return (cp == 0x20) || ((cp >= 0x09) && (cp <= 0x0D));
+
+	return (cp == 0x85) || (cp == 0xA0) || (cp == 0x1680) || ((cp >= 0x2000) && (cp <= 0x200A)) || (cp == 0x2028) ||
+		(cp == 0x2029) || (cp == 0x202F) || (cp == 0x205F) || (cp == 0x3000);
+}
+
+//---------------------------------------------------------------------------
+// uuid_next (local)
+//
+// Decodes the code point at the specified position and advances past it
+//
+// Arguments:
+//
+//	pos		- Current position; advanced past the decoded code point
+//	end		- End of the input string
+
+static uint32_t uuid_next(wchar_t const*& pos, wchar_t const* /*end*/)
+{
+	// None of the characters of interest are outside of the BMP; surrogates
+	// are returned as-is and will fail validation
+	return static_cast<uint32_t>(*pos++);
+}
+
+static uint32_t uuid_next(char const*& pos, char const* end)
 {
-	UUID uuid = {};
+	uint8_t lead = static_cast<uint8_t>(*pos++);
+	if(lead < 0x80) return lead;
 
-	if(argc != 0) return sqlite3_result_error(context, "invalid argument", -1);
+	// Decode a multi-byte UTF-8 sequence; malformed sequences return a code point
+	// that is neither whitespace nor ASCII so they will fail validation
+	int trail = (lead >= 0xF0) ? 3 : (lead >= 0xE0) ? 2 : (lead >= 0xC0) ? 1 : 0;
+	uint32_t cp = lead & (0x3F >> trail);
 
-	// Create a new UUID using Windows RPC
-	RPC_STATUS status = UuidCreate(&uuid);
-	if(status != RPC_S_OK) { /* Suppress C6031 */ }
+	while((trail-- > 0) && (pos < end) && ((static_cast<uint8_t>(*pos) & 0xC0) == 0x80))
+		cp = (cp << 6) | (static_cast<uint8_t>(*pos++) & 0x3F);
 
-	// Return the UUID back as a 16-byte blob
-	return sqlite3_result_blob(context, &uuid, sizeof(UUID), SQLITE_TRANSIENT);
+	return (cp < 0x80) ? 0xFFFD : cp;
 }
 
 //---------------------------------------------------------------------------
-// prettyjson (local)
+// uuid_prev (local)
 //
-// SQLite scalar function to pretty print a JSON string
+// Decodes the code point that precedes the specified position and moves the
+// position back to the start of it
 //
 // Arguments:
 //
-//	context		- SQLite context object
-//	argc		- Number of supplied arguments
-//	argv		- Argument values
+//	begin	- Start of the input string
+//	pos		- Current position; moved back to the start of the code point
 
-static void prettyjson(sqlite3_context* context, int argc, sqlite3_value** argv)
+static uint32_t uuid_prev(wchar_t const* /*begin*/, wchar_t const*& pos)
 {
-	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+	return static_cast<uint32_t>(*--pos);
+}
+
+static uint32_t uuid_prev(char const* begin, char const*& pos)
+{
+	char const* end = pos;
+
+	// Back up over any UTF-8 continuation bytes to the lead byte
+	do --pos; while((pos > begin) && ((static_cast<uint8_t>(*pos) & 0xC0) == 0x80) && ((end - pos) < 4));
+
+	char const* next = pos;
+	return uuid_next(next, end);
+}
 
-	// Null or zero-length input string results in null
-	wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[0]));
-	if((json == nullptr) || (*json == L'\0')) return sqlite3_result_null(context);
+//---------------------------------------------------------------------------
+// uuid_hex (local)
+//
+// Parses a fixed-length run of hexadecimal digits; errors are accumulated
+// into the specified error mask rather than branched on
+//
+// Arguments:
+//
+//	str		- ASCII string to be parsed
+//	count	- Number of hexadecimal digits to parse
+//	error	- Error mask; bit 7 is set if any character was not a digit
+
+static uint32_t uuid_hex(char const* str, size_t count, uint8_t& error)
+{
+	uint32_t value = 0;
+
+	for(size_t index = 0; index < count; index++) {
+
+		uint8_t digit = uuid_hexvalues[static_cast<uint8_t>(str[index])];
+		error |= digit;
+		value = (value << 4) | (digit & 0x0F);
+	}
+
+	return value;
+}
+
+//---------------------------------------------------------------------------
+// uuid_hexprefixed (local)
+//
+// Parses a variable length 0x-prefixed hexadecimal number for the X format
+//
+// Arguments:
+//
+//	pos		- Current position; advanced past the parsed number
+//	end		- End of the input string
+//	maxlen	- Maximum number of digits allowed
+//	value	- On success, receives the parsed value
+
+static bool uuid_hexprefixed(char const*& pos, char const* end, size_t maxlen, uint32_t& value)
+{
+	if(((end - pos) < 2) || (pos[0] != '0') || ((pos[1] | 0x20) != 'x')) return false;
+	pos += 2;
+
+	size_t length = 0;
+	while((pos + length < end) && (length <= maxlen) && ((uuid_hexvalues[static_cast<uint8_t>(pos[length])] & 0x80) == 0)) length++;
+
+	if((length == 0) || (length > maxlen)) return false;
+
+	uint8_t error = 0;
+	value = uuid_hex(pos, length, error);
+	pos += length;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// uuid_parse (local)
+//
+// Parses a UUID string in any format accepted by System::Guid::TryParse; the
+// D, N, B, P and X formats with surrounding whitespace
+//
+// Arguments:
+//
+//	str		- UTF-8 or UTF-16 input string
+//	length	- Length of the input string in code units
+//	uuid	- On success, receives the parsed UUID
+
+template<typename _char>
+static bool uuid_parse(_char const* str, size_t length, UUID& uuid)
+{
+	char buffer[128] = {};			// Normalized ASCII copy of the input
+	size_t buflen = 0;				// Length of the normalized input
+	bool hasdash = false;			// Flag if the input contains a dash
+	bool hasbrace = false;			// Flag if the input contains an opening brace
+	uint8_t error = 0;				// Accumulated hexadecimal digit errors
+
+	_char const* begin = str;
+	_char const* end = str + length;
+
+	// Trim leading and trailing whitespace like String::Trim
+	for(_char const* next = begin; (begin < end) && uuid_isspace(uuid_next(next, end)); begin = next);
+	for(_char const* prev = end; (end > begin) && uuid_isspace(uuid_prev(begin, prev)); end = prev);
+
+	// Copy the input into an ASCII buffer; the X format ignores all embedded whitespace
+	for(_char const* pos = begin; pos < end;) {
+
+		uint32_t cp = uuid_next(pos, end);
+		if(uuid_isspace(cp)) buffer[buflen++] = ' ';
+		else if(cp < 0x80) buffer[buflen++] = static_cast<char>(cp);
+		else return false;
+
+		hasdash |= (cp == '-');
+		hasbrace |= (cp == '{');
+
+		if(buflen == sizeof(buffer)) return false;
+	}
+
+	char const* pos = buffer;
+
+	// D, B and P formats: 00000000-0000-0000-0000-000000000000 with optional {} or ()
+	if(hasdash) {
+
+		if((buflen == 38) && (((buffer[0] == '{') && (buffer[37] == '}')) || ((buffer[0] == '(') && (buffer[37] == ')')))) pos++;
+		else if(buflen != 36) return false;
+
+		if((pos[8] != '-') || (pos[13] != '-') || (pos[18] != '-') || (pos[23] != '-')) return false;
+
+		uuid.Data1 = uuid_hex(&pos[0], 8, error);
+		uuid.Data2 = static_cast<unsigned short>(uuid_hex(&pos[9], 4, error));
+		uuid.Data3 = static_cast<unsigned short>(uuid_hex(&pos[14], 4, error));
+		uuid.Data4[0] = static_cast<unsigned char>(uuid_hex(&pos[19], 2, error));
+		uuid.Data4[1] = static_cast<unsigned char>(uuid_hex(&pos[21], 2, error));
+		for(int index = 0; index < 6; index++) uuid.Data4[2 + index] = static_cast<unsigned char>(uuid_hex(&pos[24 + (index * 2)], 2, error));
+
+		return (error & 0x80) == 0;
+	}
+
+	// X format: {0x00000000,0x0000,0x0000,{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}}
+	if(hasbrace) {
 
-	// Pretty print the JSON using rapidjson
-	rapidjson::GenericDocument<rapidjson::UTF16<>> document;
-	document.Parse(json);
-	rapidjson::GenericStringBuffer<rapidjson::UTF16<>> sb;
-	rapidjson::PrettyWriter<rapidjson::GenericStringBuffer<rapidjson::UTF16<>>, rapidjson::UTF16<>, rapidjson::UTF16<>> writer(sb);
-	writer.SetIndent(L' ', 2);
-	document.Accept(writer);
+		// Remove all of the whitespace that was copied into the buffer
+		buflen = static_cast<size_t>(std::remove(buffer, buffer + buflen, ' ') - buffer);
+		char const* bufend = buffer + buflen;
 
-	return sqlite3_result_text16(context, sb.GetString(), -1, SQLITE_TRANSIENT);
+		uint32_t value = 0;
+		if((buflen == 0) || (*pos++ != '{')) return false;
+
+		if(!uuid_hexprefixed(pos, bufend, 8, value) || (pos >= bufend) || (*pos++ != ',')) return false;
+		uuid.Data1 = value;
+		if(!uuid_hexprefixed(pos, bufend, 4, value) || (pos >= bufend) || (*pos++ != ',')) return false;
+		uuid.Data2 = static_cast<unsigned short>(value);
+		if(!uuid_hexprefixed(pos, bufend, 4, value) || (pos >= bufend) || (*pos++ != ',')) return false;
+		uuid.Data3 = static_cast<unsigned short>(value);
+		if((pos >= bufend) || (*pos++ != '{')) return false;
+
+		for(int index = 0; index < 8; index++) {
+
+			if(!uuid_hexprefixed(pos, bufend, 2, value) || (pos >= bufend) || (*pos++ != ((index < 7) ? ',' : '}'))) return false;
+			uuid.Data4[index] = static_cast<unsigned char>(value);
+		}
+
+		return ((bufend - pos) == 1) && (*pos == '}');
+	}
+
+	// N format: 00000000000000000000000000000000
+	if(buflen != 32) return false;
+
+	uuid.Data1 = uuid_hex(&pos[0], 8, error);
+	uuid.Data2 = static_cast<unsigned short>(uuid_hex(&pos[8], 4, error));
+	uuid.Data3 = static_cast<unsigned short>(uuid_hex(&pos[12], 4, error));
+	for(int index = 0; index < 8; index++) uuid.Data4[index] = static_cast<unsigned char>(uuid_hex(&pos[16 + (index * 2)], 2, error));
+
+	return (error & 0x80) == 0;
 }
 
 //---------------------------------------------------------------------------
 // uuid (local)
 //
-// SQLite scalar function to convert a string into a UUID
+// SQLite scalar function to convert a string into a UUID; registered for both
+// UTF-8 and UTF-16 so that SQLite never has to convert the input text
 //
 // Arguments:
 //
@@ -219,27 +2421,36 @@ static void prettyjson(sqlite3_context* context, int argc, sqlite3_value** argv)
 //	argc		- Number of supplied arguments
 //	argv		- Argument values
 
+template<typename _char>
 static void uuid(sqlite3_context* context, int argc, sqlite3_value** argv)
 {
+	_char const* input = nullptr;			// Input string pointer
+	size_t length = 0;						// Input string length
+	UUID value = {};						// Parsed UUID
+
 	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
 
-	// Use managed code to parse the string to access Guid::TryParse(), which allows all the formats
-	wchar_t const* inputptr = reinterpret_cast<wchar_t const*>(sqlite3_value_text16(argv[0]));
-	if(inputptr != nullptr) {
+	// Access the input in the encoding that matches the registered function
+	if constexpr(sizeof(_char) == sizeof(char)) {
 
-		Guid uuid = Guid::Empty;
-		if(Guid::TryParse(gcnew String(inputptr), uuid)) {
+		input = reinterpret_cast<_char const*>(sqlite3_value_text(argv[0]));
+		length = static_cast<size_t>(sqlite3_value_bytes(argv[0]));
+	}
 
-			// If the Guid parsed, return it as a 16-byte blob
-			array<Byte>^ bytes = uuid.ToByteArray();
-			pin_ptr<Byte> pinbytes = &bytes[0];
-			return sqlite3_result_blob(context, &pinbytes[0], sizeof(UUID), SQLITE_TRANSIENT);
-		}
+	else {
+
+		input = reinterpret_cast<_char const*>(sqlite3_value_text16(argv[0]));
+		length = static_cast<size_t>(sqlite3_value_bytes16(argv[0])) / sizeof(_char);
 	}
 
+	// The memory layout of the UUID structure is the same as System::Guid::ToByteArray()
+	if((input != nullptr) && uuid_parse(input, length, value)) return sqlite3_result_blob(context, &value, sizeof(UUID), SQLITE_TRANSIENT);
+
 	return sqlite3_result_null(context);
 }
 
+#pragma managed(pop)
+
 //---------------------------------------------------------------------------
 // uuidstr (local)
 //
@@ -370,34 +2581,34 @@ extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_
 
 	*errmsg = nullptr;							// Initialize [out] variable
 
-	// base64decode function
+	// cardfiles virtual table
 	//
-	int result = sqlite3_create_function16(db, L"base64decode", 1, SQLITE_UTF16, nullptr, base64decode, nullptr, nullptr);
-	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function base64decode (%d)", result); return result; }
+	int result = sqlite3_create_module_v2(db, "cardfiles", &cardfiles_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register virtual table module cardfiles (%d)", result); return result; }
 
-	// base64encode function
+	// carray virtual table
 	//
-	result = sqlite3_create_function16(db, L"base64encode", 1, SQLITE_UTF16, nullptr, base64encode, nullptr, nullptr);
-	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function base64encode (%d)", result); return result; }
+	result = sqlite3_create_module_v2(db, "carray", &carray_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register virtual table module carray (%d)", result); return result; }
 
-	// cardtype function
+	// imagesearch virtual table
 	//
-	result = sqlite3_create_function16(db, L"cardtype", 1, SQLITE_UTF16, nullptr, cardtype, nullptr, nullptr);
-	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function cardtype (%d)", result); return result; }
+	result = sqlite3_create_module_v2(db, "imagesearch", &imagesearch_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register virtual table module imagesearch (%d)", result); return result; }
 
-	// newid function
+	// namesearch virtual table
 	//
-	result = sqlite3_create_function16(db, L"newid", 0, SQLITE_UTF16, nullptr, newid, nullptr, nullptr);
-	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function newid (%d)", result); return result; }
+	result = sqlite3_create_module_v2(db, "namesearch", &namesearch_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register virtual table module namesearch (%d)", result); return result; }
 
-	// prettyjson function
+	// uuid function (UTF-8)
 	//
-	result = sqlite3_create_function16(db, L"prettyjson", 1, SQLITE_UTF16, nullptr, prettyjson, nullptr, nullptr);
-	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function prettyjson (%d)", result); return result; }
+	result = sqlite3_create_function16(db, L"uuid", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC, nullptr, uuid<char>, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function uuid (%d)", result); return result; }
 
-	// uuid function
+	// uuid function (UTF-16)
 	//
-	result = sqlite3_create_function16(db, L"uuid", 1, SQLITE_UTF16, nullptr, uuid, nullptr, nullptr);
+	result = sqlite3_create_function16(db, L"uuid", 1, SQLITE_UTF16 | SQLITE_DETERMINISTIC, nullptr, uuid<wchar_t>, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function uuid (%d)", result); return result; }
 
 	// uuidstr function
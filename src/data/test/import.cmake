@@ -0,0 +1,50 @@
+#---------------------------------------------------------------------------
+# dbcore-import
+#
+# Imports the cards in test/card with dbcoretool, deletes the details of the
+# first card, vacuums and verifies that the full-text indexes still resolve
+# the remaining cards; VACUUM may reassign the rowids the indexes are keyed on
+#
+# -DDBCORETOOL=<path>	dbcoretool executable
+# -DIMPORTPATH=<path>	import path, containing the card directory
+# -DDATABASE=<path>		database file to create
+#---------------------------------------------------------------------------
+
+# dbcoretool(<expected> <arguments>...)
+#
+# Runs dbcoretool and fails the test unless the output matches <expected>
+function(dbcoretool expected)
+
+	execute_process(COMMAND ${DBCORETOOL} ${ARGN} RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE error)
+	string(STRIP "${output}" output)
+
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "dbcoretool ${ARGN} failed (${result}):\n${error}")
+	elseif(NOT output MATCHES "${expected}")
+		message(FATAL_ERROR "dbcoretool ${ARGN} returned \"${output}\", expected \"${expected}\"")
+	endif()
+
+endfunction()
+
+file(REMOVE ${DATABASE})
+
+dbcoretool("^$" import ${DATABASE} ${IMPORTPATH})
+dbcoretool("^10$" query ${DATABASE} "pragma user_version")
+dbcoretool("^3\\|8\\|4\\|2$" query ${DATABASE} "select (select count(*) from card), (select count(*) from carddetail), (select count(*) from cardfaq), (select count(*) from cardimage)")
+
+# Keywords and traits are derived from the imported card details
+dbcoretool("^FB01-001\\|FRONT\\|JP\\|Awaken$" query ${DATABASE}
+	"select * from carddetailkeywordtext where cardid = 'FB01-001' and side = 'FRONT' and language = 'JP' and keyword = 'Awaken'")
+dbcoretool("^Supreme Kai/Potara$" query ${DATABASE}
+	"select group_concat(trait, '/') from (select trait from carddetailtrait where cardid = 'FB02-069' and language = 1 order by ordinal)")
+
+dbcoretool("^$" execute ${DATABASE} "delete from carddetail where cardid = 'FB01-001'")
+dbcoretool("^$" vacuum ${DATABASE})
+
+dbcoretool("^$" execute ${DATABASE} "insert into carddetailsearch(carddetailsearch, rank) values('integrity-check', 1)")
+dbcoretool("^$" execute ${DATABASE} "insert into cardfaqsearch(cardfaqsearch, rank) values('integrity-check', 1)")
+
+dbcoretool("^FB01-005\\|Master Roshi$" query ${DATABASE} "select cardid, name from carddetailsearch where carddetailsearch match 'roshi'")
+dbcoretool("^FB02-069\\|時の指輪$" query ${DATABASE} "select cardid, name from carddetailsearch where carddetailsearch match '指輪'")
+dbcoretool("^FB01-005\\|Q122$" query ${DATABASE} "select cardid, faqid from cardfaqsearch where cardfaqsearch match 'tournament'")
+dbcoretool("^$" query ${DATABASE} "select cardid from carddetailsearch where carddetailsearch match 'goku'")